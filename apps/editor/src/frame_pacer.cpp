@@ -0,0 +1,81 @@
+#include "frame_pacer.hpp"
+
+#include "clk/gui/init.hpp"
+
+#include <GLFW/glfw3.h>
+
+namespace clk::editor
+{
+
+frame_pacer::frame_pacer(GLFWwindow* window)
+{
+    glfwSetWindowUserPointer(window, this);
+    glfwSetWindowFocusCallback(window, [](GLFWwindow* w, int /*focused*/) {
+        on_input(w);
+    });
+    glfwSetCursorEnterCallback(window, [](GLFWwindow* w, int /*entered*/) {
+        on_input(w);
+    });
+    glfwSetCursorPosCallback(window, [](GLFWwindow* w, double /*x*/, double /*y*/) {
+        on_input(w);
+    });
+    glfwSetMouseButtonCallback(window, [](GLFWwindow* w, int /*button*/, int /*action*/, int /*mods*/) {
+        on_input(w);
+    });
+    glfwSetScrollCallback(window, [](GLFWwindow* w, double /*x_offset*/, double /*y_offset*/) {
+        on_input(w);
+    });
+    glfwSetKeyCallback(window, [](GLFWwindow* w, int /*key*/, int /*scancode*/, int /*action*/, int /*mods*/) {
+        on_input(w);
+    });
+    glfwSetCharCallback(window, [](GLFWwindow* w, unsigned int /*codepoint*/) {
+        on_input(w);
+    });
+    glfwSetFramebufferSizeCallback(window, [](GLFWwindow* w, int /*width*/, int /*height*/) {
+        on_input(w);
+    });
+    glfwSetWindowRefreshCallback(window, [](GLFWwindow* w) {
+        on_input(w);
+    });
+    // redraws requested from other threads, e.g. by finished evaluations, end the wait for events
+    clk::gui::set_redraw_wakeup(&glfwPostEmptyEvent);
+}
+
+frame_pacer::~frame_pacer()
+{
+    clk::gui::set_redraw_wakeup(nullptr);
+}
+
+void frame_pacer::wait_for_events()
+{
+    if(is_idle())
+        glfwWaitEventsTimeout(std::chrono::duration<double>(_idle_timeout).count());
+    else
+        glfwPollEvents();
+}
+
+void frame_pacer::end_frame(bool redraw_requested)
+{
+    if(_input_received || redraw_requested)
+        _remaining_active_frames = frames_after_input;
+    else if(_remaining_active_frames > 0)
+        _remaining_active_frames--;
+    _input_received = false;
+}
+
+auto frame_pacer::is_idle() const -> bool
+{
+    return _remaining_active_frames == 0;
+}
+
+void frame_pacer::set_idle_timeout(std::chrono::milliseconds timeout)
+{
+    _idle_timeout = timeout;
+}
+
+void frame_pacer::on_input(GLFWwindow* window)
+{
+    static_cast<frame_pacer*>(glfwGetWindowUserPointer(window))->_input_received = true;
+}
+
+} // namespace clk::editor
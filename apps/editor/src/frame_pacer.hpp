@@ -0,0 +1,41 @@
+#pragma once
+
+#include <chrono>
+
+struct GLFWwindow;
+
+namespace clk::editor
+{
+// Keeps drawing frames while there is input or a widget requested a redraw, otherwise waits for the next event. While
+// idle a frame is still drawn every idle timeout, so the texts that show elapsed time do not freeze.
+class frame_pacer final
+{
+public:
+    frame_pacer() = delete;
+    // installs input callbacks on the window, has to happen before the ImGui backend installs its own so that they are
+    // chained
+    explicit frame_pacer(GLFWwindow* window);
+    frame_pacer(frame_pacer const&) = delete;
+    frame_pacer(frame_pacer&&) = delete;
+    auto operator=(frame_pacer const&) -> frame_pacer& = delete;
+    auto operator=(frame_pacer&&) -> frame_pacer& = delete;
+    ~frame_pacer();
+
+    // polls the events while frames are needed, otherwise blocks until an event arrives or the idle timeout elapsed
+    void wait_for_events();
+    void end_frame(bool redraw_requested);
+    auto is_idle() const -> bool;
+    void set_idle_timeout(std::chrono::milliseconds timeout);
+
+private:
+    // ImGui needs a few frames after the last input to settle hover states and windows that changed their size
+    static constexpr int frames_after_input = 3;
+
+    bool _input_received = true;
+    int _remaining_active_frames = frames_after_input;
+    std::chrono::milliseconds _idle_timeout = std::chrono::milliseconds(500);
+
+    static void on_input(GLFWwindow* window);
+};
+
+} // namespace clk::editor
@@ -1,3 +1,5 @@
+#include "frame_pacer.hpp"
+
 #include "clk/algorithms/boolean.hpp"
 #include "clk/algorithms/color.hpp"
 #include "clk/algorithms/init.hpp"
@@ -81,6 +83,7 @@ auto main(int /*argc*/, char** /*argv*/) -> int
 #endif
 
         glfwSwapInterval(1);
+        clk::editor::frame_pacer frame_pacer(window);
 
         IMGUI_CHECKVERSION();
         ImGui::CreateContext();
@@ -244,7 +247,7 @@ auto main(int /*argc*/, char** /*argv*/) -> int
             profiler_empty.record_sample_start();
             profiler_empty.record_sample_end();
 
-            glfwPollEvents();
+            frame_pacer.wait_for_events();
             ImGui_ImplOpenGL3_NewFrame();
             ImGui_ImplGlfw_NewFrame();
             ImGui::NewFrame();
@@ -274,8 +277,13 @@ auto main(int /*argc*/, char** /*argv*/) -> int
             profiler_swap.record_sample_start();
             glfwSwapBuffers(window);
             profiler_swap.record_sample_end();
+
+            frame_pacer.end_frame(clk::gui::take_redraw_request());
         }
 
+        // the graph editors release their graphs, so they go before the graphs and the contexts
+        clk::gui::panel::delete_orphans();
+
         ImPlot::DestroyContext();
 
         ImNodes::DestroyContext();
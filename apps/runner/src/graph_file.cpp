@@ -0,0 +1,321 @@
+#include "graph_file.hpp"
+
+#include "clk/base/algorithm.hpp"
+#include "clk/base/algorithm_node.hpp"
+#include "clk/base/constant_node.hpp"
+#include "clk/base/input.hpp"
+#include "clk/base/node.hpp"
+#include "clk/base/output.hpp"
+#include "clk/util/color_rgb.hpp"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <typeindex>
+
+namespace clk::runner
+{
+namespace
+{
+struct data_type
+{
+    std::string_view keyword;
+    std::size_t hash;
+    auto (*create_output)() -> std::unique_ptr<clk::output>;
+    void (*read)(std::string const& text, void* data);
+    void (*write)(std::ostream& stream, void const* data);
+};
+
+template <typename T>
+void read_value(std::string const& text, void* data)
+{
+    auto& value = *static_cast<T*>(data);
+    std::istringstream stream(text);
+    if constexpr(std::is_same_v<T, std::string>)
+    {
+        value = text;
+        return;
+    }
+    else if constexpr(std::is_same_v<T, bool>)
+    {
+        stream >> std::boolalpha >> value;
+    }
+    else if constexpr(std::is_same_v<T, clk::color_rgb>)
+    {
+        float r = 0.0f;
+        float g = 0.0f;
+        float b = 0.0f;
+        stream >> r >> g >> b;
+        value = clk::color_rgb(r, g, b);
+    }
+    else
+    {
+        stream >> value;
+    }
+
+    if(stream.fail() || !(stream >> std::ws).eof())
+        throw std::runtime_error("Invalid value \"" + text + "\"");
+}
+
+template <typename T>
+void write_value(std::ostream& stream, void const* data)
+{
+    auto const& value = *static_cast<T const*>(data);
+    if constexpr(std::is_same_v<T, bool>)
+        stream << std::boolalpha << value;
+    else if constexpr(std::is_same_v<T, clk::color_rgb>)
+        stream << value.r() << ' ' << value.g() << ' ' << value.b();
+    else
+        stream << value;
+}
+
+template <typename T>
+auto make_data_type(std::string_view keyword) -> data_type
+{
+    return {keyword, std::type_index(typeid(T)).hash_code(),
+        []() -> std::unique_ptr<clk::output> {
+            return std::make_unique<clk::output_of<T>>("Value");
+        },
+        read_value<T>, write_value<T>};
+}
+
+auto data_types() -> std::array<data_type, 5> const&
+{
+    static std::array<data_type, 5> const types = {make_data_type<int>("int"), make_data_type<float>("float"),
+        make_data_type<bool>("bool"), make_data_type<std::string>("string"), make_data_type<clk::color_rgb>("color")};
+    return types;
+}
+
+auto find_data_type(std::size_t hash) -> data_type const*
+{
+    for(auto const& type : data_types())
+        if(type.hash == hash)
+            return &type;
+    return nullptr;
+}
+
+auto find_data_type(std::string_view keyword) -> data_type const&
+{
+    for(auto const& type : data_types())
+        if(type.keyword == keyword)
+            return type;
+    throw std::runtime_error("Unknown data type \"" + std::string(keyword) + "\"");
+}
+
+template <typename Port>
+auto find_port(std::vector<Port*> const& ports, std::string_view name) -> Port*
+{
+    for(auto* port : ports)
+        if(port->name() == name)
+            return port;
+    return nullptr;
+}
+
+auto tokenize(std::string_view line) -> std::vector<std::string>
+{
+    std::vector<std::string> tokens;
+    std::size_t i = 0;
+    while(i < line.size())
+    {
+        if(line[i] == ' ' || line[i] == '\t' || line[i] == '\r')
+        {
+            i++;
+        }
+        else if(line[i] == '#')
+        {
+            break;
+        }
+        else if(line[i] == '"')
+        {
+            std::size_t const end = line.find('"', i + 1);
+            if(end == std::string_view::npos)
+                throw std::runtime_error("Unterminated quotes");
+            tokens.emplace_back(line.substr(i + 1, end - i - 1));
+            i = end + 1;
+        }
+        else
+        {
+            std::size_t const end = std::min(line.find_first_of(" \t\r#\"", i), line.size());
+            tokens.emplace_back(line.substr(i, end - i));
+            i = end;
+        }
+    }
+    return tokens;
+}
+
+void expect_token_count(std::vector<std::string> const& tokens, std::size_t count)
+{
+    if(tokens.size() != count)
+        throw std::runtime_error("\"" + tokens.front() + "\" expects " + std::to_string(count - 1) + " arguments");
+}
+
+} // namespace
+
+graph_file::graph_file(std::filesystem::path const& path)
+{
+    std::ifstream stream(path);
+    if(!stream)
+        throw std::runtime_error("Could not open \"" + path.string() + "\"");
+    load(stream);
+}
+
+graph_file::graph_file(std::istream& stream)
+{
+    load(stream);
+}
+
+graph_file::~graph_file()
+{
+    disconnect_all();
+}
+
+auto graph_file::graph() -> clk::graph&
+{
+    return _graph;
+}
+
+auto graph_file::printed_outputs() const -> std::vector<std::pair<std::string, clk::output*>> const&
+{
+    return _printed_outputs;
+}
+
+auto graph_file::node_ids() const -> std::map<std::string, clk::node*, std::less<>> const&
+{
+    return _nodes;
+}
+
+void graph_file::mark_sources_as_outdated()
+{
+    for(auto const& node : _graph.nodes())
+    {
+        if(!node->has_inputs())
+        {
+            for(auto* output : node->outputs())
+                output->update_timestamp();
+        }
+        for(auto* input : node->inputs())
+        {
+            if(input->connected_output() == nullptr)
+                input->default_port().update_timestamp();
+        }
+    }
+}
+
+void graph_file::load(std::istream& stream)
+{
+    std::string line;
+    for(std::size_t line_number = 1; std::getline(stream, line); line_number++)
+    {
+        try
+        {
+            if(auto tokens = tokenize(line); !tokens.empty())
+                parse_statement(tokens);
+        }
+        catch(std::exception const& e)
+        {
+            // the destructor does not run when the constructor throws
+            disconnect_all();
+            throw std::runtime_error("Line " + std::to_string(line_number) + ": " + e.what());
+        }
+    }
+}
+
+void graph_file::parse_statement(std::vector<std::string> const& tokens)
+{
+    std::string const& statement = tokens.front();
+    if(statement == "node" || statement == "constant")
+    {
+        std::unique_ptr<clk::node> node;
+        if(statement == "node")
+        {
+            expect_token_count(tokens, 3);
+            if(clk::algorithm::factories().count(tokens[2]) == 0)
+                throw std::runtime_error("Unknown algorithm \"" + tokens[2] + "\"");
+            node = std::make_unique<clk::algorithm_node>(clk::algorithm::create(tokens[2]));
+        }
+        else
+        {
+            expect_token_count(tokens, 4);
+            auto const& type = find_data_type(tokens[2]);
+            auto output = type.create_output();
+            type.read(tokens[3], output->data_pointer());
+            auto constant = std::make_unique<clk::constant_node>();
+            constant->add_output(std::move(output));
+            node = std::move(constant);
+        }
+
+        if(!_nodes.emplace(tokens[1], node.get()).second)
+            throw std::runtime_error("Node \"" + tokens[1] + "\" is already defined");
+        _graph.add_node(std::move(node));
+    }
+    else if(statement == "set")
+    {
+        expect_token_count(tokens, 4);
+        auto* input = find_port(find_node(tokens[1])->inputs(), tokens[2]);
+        if(input == nullptr)
+            throw std::runtime_error("Node \"" + tokens[1] + "\" has no input \"" + tokens[2] + "\"");
+        auto const* type = find_data_type(input->data_type_hash());
+        if(type == nullptr)
+            throw std::runtime_error("The value of input \"" + tokens[2] + "\" cannot be set");
+        type->read(tokens[3], input->default_port().data_pointer());
+        input->default_port().update_timestamp();
+    }
+    else if(statement == "connect")
+    {
+        expect_token_count(tokens, 5);
+        auto* output = find_port(find_node(tokens[1])->outputs(), tokens[2]);
+        if(output == nullptr)
+            throw std::runtime_error("Node \"" + tokens[1] + "\" has no output \"" + tokens[2] + "\"");
+        auto* input = find_port(find_node(tokens[3])->inputs(), tokens[4]);
+        if(input == nullptr)
+            throw std::runtime_error("Node \"" + tokens[3] + "\" has no input \"" + tokens[4] + "\"");
+        if(!input->can_connect_to(*output))
+            throw std::runtime_error("Output \"" + tokens[2] + "\" cannot be connected to input \"" + tokens[4] + "\"");
+        input->connect_to(*output, false);
+    }
+    else if(statement == "print")
+    {
+        expect_token_count(tokens, 3);
+        auto* output = find_port(find_node(tokens[1])->outputs(), tokens[2]);
+        if(output == nullptr)
+            throw std::runtime_error("Node \"" + tokens[1] + "\" has no output \"" + tokens[2] + "\"");
+        _printed_outputs.emplace_back(tokens[1] + "." + tokens[2], output);
+        _graph.observe(*output);
+    }
+    else
+    {
+        throw std::runtime_error("Unknown statement \"" + statement + "\"");
+    }
+}
+
+void graph_file::disconnect_all()
+{
+    // disconnecting without notifications first, otherwise every destroyed output pushes through the rest of the graph
+    for(auto const& node : _graph.nodes())
+        for(auto* input : node->inputs())
+            input->disconnect(false);
+}
+
+auto graph_file::find_node(std::string_view id) const -> clk::node*
+{
+    auto it = _nodes.find(id);
+    if(it == _nodes.end())
+        throw std::runtime_error("Unknown node \"" + std::string(id) + "\"");
+    return it->second;
+}
+
+auto to_string(clk::output const& output) -> std::string
+{
+    auto const* type = find_data_type(output.data_type_hash());
+    if(type == nullptr)
+        return "<unprintable>";
+    std::ostringstream stream;
+    type->write(stream, output.data_pointer());
+    return stream.str();
+}
+
+} // namespace clk::runner
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "clk/base/graph.hpp"
+
+#include <filesystem>
+#include <istream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace clk
+{
+class node;
+class output;
+} // namespace clk
+
+namespace clk::runner
+{
+// A graph loaded from a line based description, every line holds one statement and '#' starts a comment:
+//
+//     node <id> <algorithm>                            creates a node running the registered algorithm
+//     constant <id> <type> <value>                     creates a constant node with a single "Value" output
+//     set <id> <input> <value>                         sets the value of an input that is not connected
+//     connect <id> <output> <id> <input>               connects an output of a node to an input of another
+//     print <id> <output>                              prints the value of the output after evaluation
+//
+// tokens containing spaces are written between double quotes, values of the types "int", "float", "bool", "string"
+// and "color" (three floats) can be read and printed
+class graph_file final
+{
+public:
+    explicit graph_file(std::filesystem::path const& path);
+    explicit graph_file(std::istream& stream);
+    graph_file(graph_file const&) = delete;
+    graph_file(graph_file&&) = delete;
+    auto operator=(graph_file const&) -> graph_file& = delete;
+    auto operator=(graph_file&&) -> graph_file& = delete;
+    ~graph_file();
+
+    auto graph() -> clk::graph&;
+    auto printed_outputs() const -> std::vector<std::pair<std::string, clk::output*>> const&;
+    auto node_ids() const -> std::map<std::string, clk::node*, std::less<>> const&;
+    // makes every node that depends on a constant or an unconnected input outdated
+    void mark_sources_as_outdated();
+
+private:
+    clk::graph _graph;
+    std::map<std::string, clk::node*, std::less<>> _nodes;
+    std::vector<std::pair<std::string, clk::output*>> _printed_outputs;
+
+    void load(std::istream& stream);
+    void parse_statement(std::vector<std::string> const& tokens);
+    void disconnect_all();
+    auto find_node(std::string_view id) const -> clk::node*;
+};
+
+auto to_string(clk::output const& output) -> std::string;
+
+} // namespace clk::runner
@@ -0,0 +1,282 @@
+#include "graph_file.hpp"
+
+#include "clk/algorithms/fusion.hpp"
+#include "clk/algorithms/init.hpp"
+#include "clk/base/execution_plan.hpp"
+#include "clk/base/executor.hpp"
+#include "clk/base/graph.hpp"
+#include "clk/base/node.hpp"
+#include "clk/base/output.hpp"
+#include "clk/layout/layered_layout.hpp"
+#include "clk/util/profiler.hpp"
+#include "clk/util/tracer.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <glm/glm.hpp>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+struct options
+{
+    std::string graph_path;
+    std::size_t iterations = 1;
+    std::size_t threads = 1;
+    bool profile = false;
+    bool demand_driven = false;
+    bool fuse = false;
+    std::string trace_path;
+    std::string layout_path;
+};
+
+// every thread runs a worker of the executor, more than this only adds contention
+constexpr std::size_t max_threads = 256;
+
+auto parse_count(std::string_view option, char const* value, std::size_t maximum) -> std::size_t
+{
+    if(value == nullptr)
+        throw std::runtime_error(std::string(option) + " expects a value");
+    auto const expects_positive_number = std::runtime_error(std::string(option) + " expects a positive number");
+    // stoull skips whitespace and wraps negative numbers around, only plain digits are accepted
+    if(std::isdigit(static_cast<unsigned char>(value[0])) == 0)
+        throw expects_positive_number;
+
+    std::size_t parsed_characters = 0;
+    unsigned long long count = 0;
+    try
+    {
+        count = std::stoull(value, &parsed_characters);
+    }
+    catch(std::invalid_argument const&)
+    {
+        throw expects_positive_number;
+    }
+    catch(std::out_of_range const&)
+    {
+        throw expects_positive_number;
+    }
+    if(parsed_characters != std::string_view(value).size() || count == 0)
+        throw expects_positive_number;
+    if(count > maximum)
+        throw std::runtime_error(std::string(option) + " expects at most " + std::to_string(maximum));
+    return static_cast<std::size_t>(count);
+}
+
+auto parse_options(int argc, char** argv) -> std::optional<options>
+{
+    options result;
+    for(int i = 1; i < argc; i++)
+    {
+        std::string_view const argument = argv[i];
+        char const* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if(argument == "--iterations" || argument == "-n")
+        {
+            result.iterations = parse_count(argument, value, std::numeric_limits<std::size_t>::max());
+            i++;
+        }
+        else if(argument == "--threads" || argument == "-j")
+        {
+            result.threads = parse_count(argument, value, max_threads);
+            i++;
+        }
+        else if(argument == "--trace" || argument == "-t")
+        {
+            if(value == nullptr)
+                throw std::runtime_error(std::string(argument) + " expects a value");
+            result.trace_path = value;
+            i++;
+        }
+        else if(argument == "--layout" || argument == "-l")
+        {
+            if(value == nullptr)
+                throw std::runtime_error(std::string(argument) + " expects a value");
+            result.layout_path = value;
+            i++;
+        }
+        else if(argument == "--profile" || argument == "-p")
+        {
+            result.profile = true;
+        }
+        else if(argument == "--on-demand" || argument == "-d")
+        {
+            result.demand_driven = true;
+        }
+        else if(argument == "--fuse" || argument == "-f")
+        {
+            result.fuse = true;
+        }
+        else if(argument == "--help" || argument == "-h")
+        {
+            return std::nullopt;
+        }
+        else if(result.graph_path.empty())
+        {
+            result.graph_path = argument;
+        }
+        else
+        {
+            throw std::runtime_error("Unexpected argument \"" + std::string(argument) + "\"");
+        }
+    }
+    if(result.graph_path.empty())
+        return std::nullopt;
+    return result;
+}
+
+void print_usage(std::ostream& stream)
+{
+    stream << "usage: runner <graph file> [--iterations <count>] [--threads <count>] [--profile] [--trace <file>] "
+              "[--layout <file>] [--on-demand] [--fuse]\n"
+           << "  -n, --iterations  evaluates the whole graph the given number of times (default 1)\n"
+           << "  -j, --threads     evaluates independent nodes in parallel on the given number of threads (default 1)\n"
+           << "  -p, --profile     prints how often and how long every node was updated\n"
+           << "  -t, --trace       writes the pulls, pushes and updates of every node to a Chrome trace file\n"
+           << "  -l, --layout      writes a layered layout of the graph to a file, one \"<id> <x> <y>\" line per node\n"
+           << "  -d, --on-demand   only evaluates the nodes that the printed outputs depend on\n"
+           << "  -f, --fuse        replaces trees of float math nodes with single nodes before evaluating\n";
+}
+
+auto format_duration(std::chrono::nanoseconds duration) -> std::string
+{
+    using namespace std::chrono_literals;
+    if(duration < 10us)
+        return std::to_string(duration.count()) + "ns";
+    if(duration < 10ms)
+        return std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(duration).count()) + "us";
+    if(duration < 10s)
+        return std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count()) + "ms";
+    return std::to_string(std::chrono::duration_cast<std::chrono::seconds>(duration).count()) + "s";
+}
+
+// the nodes are not drawn, so their sizes are estimated from the number of ports they have
+void write_layout(clk::runner::graph_file& file, std::string const& path)
+{
+    auto const& nodes = file.graph().nodes();
+    std::vector<glm::vec2> node_sizes;
+    node_sizes.reserve(nodes.size());
+    for(auto const& node : nodes)
+    {
+        auto const port_rows = std::max(node->inputs().size(), node->outputs().size());
+        node_sizes.emplace_back(160.0f, 40.0f + 20.0f * static_cast<float>(port_rows));
+    }
+
+    clk::layout::layered_layout const layout(file.graph(), node_sizes);
+
+    std::unordered_map<clk::node const*, std::size_t> node_indices;
+    for(std::size_t i = 0; i < nodes.size(); i++)
+        node_indices[nodes[i].get()] = i;
+
+    std::ofstream layout_file(path);
+    if(!layout_file)
+        throw std::runtime_error("Could not open \"" + path + "\"");
+    for(auto const& [id, node] : file.node_ids())
+    {
+        auto const& position = layout.positions()[node_indices[node]];
+        layout_file << id << ' ' << position.x << ' ' << position.y << '\n';
+    }
+}
+
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+    try
+    {
+        auto options = parse_options(argc, argv);
+        if(!options.has_value())
+        {
+            print_usage(std::cerr);
+            return 1;
+        }
+
+        clk::algorithms::init();
+        clk::runner::graph_file file(options->graph_path);
+        if(!options->layout_path.empty())
+            write_layout(file, options->layout_path);
+        // fusing removes nodes, so it comes after everything that refers to them by their ids
+        if(options->fuse)
+            std::cout << "fused " << clk::algorithms::fuse_elementwise_math(file.graph()) << " trees of math nodes\n";
+        file.graph().set_profiling(options->profile);
+        file.graph().set_demand_driven(options->demand_driven);
+        auto const& plan = file.graph().compile();
+
+        std::unique_ptr<clk::executor> executor;
+        if(options->threads > 1)
+            executor = std::make_unique<clk::executor>(options->threads);
+
+        clk::tracer::set_active(!options->trace_path.empty());
+
+        clk::profiler profiler;
+        profiler.set_sample_count(options->iterations);
+        for(std::size_t i = 0; i < options->iterations; i++)
+        {
+            // every iteration evaluates the whole graph again, not just what changed since the previous one
+            if(i != 0)
+                file.mark_sources_as_outdated();
+
+            profiler.record_sample_start();
+            if(executor != nullptr)
+                executor->run(plan);
+            else
+                plan.run();
+            profiler.record_sample_end();
+        }
+
+        if(clk::tracer::is_active())
+        {
+            clk::tracer::set_active(false);
+            std::ofstream trace_file(options->trace_path);
+            if(!trace_file)
+                throw std::runtime_error("Could not open \"" + options->trace_path + "\"");
+            clk::tracer::write_chrome_trace(trace_file);
+        }
+
+        for(auto const& [label, output] : file.printed_outputs())
+            std::cout << label << " = " << clk::runner::to_string(*output) << '\n';
+
+        bool faulty = false;
+        for(auto const& node : file.graph().nodes())
+        {
+            if(!node->error().empty())
+            {
+                std::cerr << "error: " << node->name() << ": " << node->error() << '\n';
+                faulty = true;
+            }
+        }
+
+        std::cout << "evaluated " << plan.nodes().size() << " nodes " << options->iterations << " times on "
+                  << options->threads << (options->threads == 1 ? " thread" : " threads") << '\n'
+                  << "average: " << format_duration(profiler.average_sample())
+                  << ", shortest: " << format_duration(profiler.shortest_sample())
+                  << ", longest: " << format_duration(profiler.longest_sample()) << '\n';
+
+        if(options->profile)
+        {
+            for(auto const& statistics : file.graph().statistics())
+                std::cout << statistics.node->name() << ": " << statistics.update_count << " updates, "
+                          << statistics.skipped_update_count << " skipped, average "
+                          << format_duration(statistics.average_update) << ", longest "
+                          << format_duration(statistics.longest_update) << '\n';
+        }
+
+        return faulty ? 2 : 0;
+    }
+    catch(std::exception const& e)
+    {
+        std::cerr << "error: " << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,56 @@
+#include "topologies.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+
+TEST_CASE("Connecting and disconnecting ports", "[!benchmark], [base]")
+{
+    for(std::size_t size : {1'000, 10'000, 100'000})
+    {
+        {
+            auto topology = clk::benchmarks::make_chain(size);
+            auto& input = topology->sink()->in(0);
+            auto& output = topology->nodes[size - 2]->out;
+            BENCHMARK(clk::benchmarks::size_name("Chain", size) + ", reconnecting the last node")
+            {
+                input.disconnect(false);
+                input.connect_to(output, false);
+            };
+        }
+
+        {
+            auto topology = clk::benchmarks::make_random_dag(size);
+            BENCHMARK_ADVANCED(clk::benchmarks::size_name("Random DAG", size) + ", rewiring every input")
+            (Catch::Benchmark::Chronometer meter)
+            {
+                meter.measure([&]() {
+                    for(std::size_t i = 1; i < size; i++)
+                    {
+                        auto* node = topology->nodes[i];
+                        auto& first = node->in(0);
+                        auto& second = node->in(1);
+                        auto* first_output = first.connected_output();
+                        auto* second_output = second.connected_output();
+                        first.connect_to(*second_output, false);
+                        second.connect_to(*first_output, false);
+                    }
+                });
+            };
+        }
+
+        // every connection refreshes the cached connections of its output, which makes building the fan-out itself
+        // quadratic, so it is not measured past 10k nodes
+        if(size <= 10'000)
+        {
+            auto topology = clk::benchmarks::make_fan_out(size);
+            auto& input = topology->sink()->in(0);
+            auto& output = topology->source()->out;
+            BENCHMARK(clk::benchmarks::size_name("Fan-out", size) + ", reconnecting a single consumer")
+            {
+                input.disconnect(false);
+                input.connect_to(output, false);
+            };
+        }
+    }
+}
@@ -0,0 +1,138 @@
+#include "topologies.hpp"
+
+#include "clk/base/execution_plan.hpp"
+#include "clk/base/executor.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using topology_builder = std::function<std::unique_ptr<clk::benchmarks::topology>(std::size_t)>;
+
+auto all_topologies() -> std::vector<std::pair<std::string_view, topology_builder>>
+{
+    return {
+        {"Chain", clk::benchmarks::make_chain},
+        {"Fan-out", clk::benchmarks::make_fan_out},
+        {"Diamonds", clk::benchmarks::make_diamonds},
+        {"Random DAG", [](std::size_t size) {
+             return clk::benchmarks::make_random_dag(size);
+         }},
+    };
+}
+
+auto max_size(std::string_view topology_name) -> std::size_t
+{
+    // pushing and pulling recurse once per node along the longest path, deeper graphs overflow the stack
+    if(topology_name == "Chain" || topology_name == "Diamonds")
+        return 10'000;
+    // every connection refreshes the cached connections of its output, so wider fan-outs take minutes to build
+    if(topology_name == "Fan-out")
+        return 10'000;
+    return 100'000;
+}
+
+} // namespace
+
+TEST_CASE("Pulling through a graph", "[!benchmark], [base]")
+{
+    for(auto const& [topology_name, builder] : all_topologies())
+    {
+        for(std::size_t size : {1'000, 10'000, 100'000})
+        {
+            if(size > max_size(topology_name))
+                continue;
+
+            auto topology = builder(size);
+            auto* source = topology->source();
+            auto* sink = topology->sink();
+            BENCHMARK(clk::benchmarks::size_name(topology_name, size) + ", everything outdated")
+            {
+                *source->out = 0;
+                sink->pull();
+                return *sink->out;
+            };
+            BENCHMARK(clk::benchmarks::size_name(topology_name, size) + ", everything up to date")
+            {
+                sink->pull();
+                return *sink->out;
+            };
+        }
+    }
+}
+
+TEST_CASE("Pushing through a graph", "[!benchmark], [base]")
+{
+    for(auto const& [topology_name, builder] : all_topologies())
+    {
+        for(std::size_t size : {1'000, 10'000, 100'000})
+        {
+            if(size > max_size(topology_name))
+                continue;
+
+            auto topology = builder(size);
+            auto* source = topology->source();
+            auto* sink = topology->sink();
+            BENCHMARK(clk::benchmarks::size_name(topology_name, size))
+            {
+                source->push();
+                return *sink->out;
+            };
+        }
+    }
+}
+
+TEST_CASE("Running an execution plan", "[!benchmark], [base]")
+{
+    clk::executor executor;
+    for(auto const& [topology_name, builder] : all_topologies())
+    {
+        for(std::size_t size : {1'000, 10'000, 100'000})
+        {
+            if(size > max_size(topology_name))
+                continue;
+
+            auto topology = builder(size);
+            auto* source = topology->source();
+            auto* sink = topology->sink();
+            BENCHMARK(clk::benchmarks::size_name(topology_name, size) + ", compiling")
+            {
+                return clk::execution_plan(topology->graph).nodes().size();
+            };
+            auto const& plan = topology->graph.compile();
+            // the plan only visits what changed, so the source is modified through its input like an edit would
+            auto modify_source = [source, value = 0]() mutable {
+                *source->in(0).default_port() = ++value;
+            };
+
+            std::size_t sink_update_count = sink->update_count();
+            modify_source();
+            plan.run();
+            REQUIRE(sink->update_count() == sink_update_count + 1);
+            BENCHMARK(clk::benchmarks::size_name(topology_name, size) + ", sequential")
+            {
+                modify_source();
+                plan.run();
+                return *sink->out;
+            };
+
+            sink_update_count = sink->update_count();
+            modify_source();
+            executor.run(plan);
+            REQUIRE(sink->update_count() == sink_update_count + 1);
+            BENCHMARK(clk::benchmarks::size_name(topology_name, size) + ", parallel")
+            {
+                modify_source();
+                executor.run(plan);
+                return *sink->out;
+            };
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#include "topologies.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+TEST_CASE("Building graphs", "[!benchmark], [base]")
+{
+    for(std::size_t size : {1'000, 10'000, 100'000})
+    {
+        BENCHMARK_ADVANCED(clk::benchmarks::size_name("Chain", size))(Catch::Benchmark::Chronometer meter)
+        {
+            // the graphs are destroyed outside of the measurement
+            std::vector<std::unique_ptr<clk::benchmarks::topology>> topologies(meter.runs());
+            meter.measure([&](int run) {
+                topologies[run] = clk::benchmarks::make_chain(size);
+            });
+        };
+        BENCHMARK_ADVANCED(clk::benchmarks::size_name("Random DAG", size))(Catch::Benchmark::Chronometer meter)
+        {
+            std::vector<std::unique_ptr<clk::benchmarks::topology>> topologies(meter.runs());
+            meter.measure([&](int run) {
+                topologies[run] = clk::benchmarks::make_random_dag(size);
+            });
+        };
+    }
+}
+
+TEST_CASE("Adding and removing nodes", "[!benchmark], [base]")
+{
+    for(std::size_t size : {1'000, 10'000, 100'000})
+    {
+        auto topology = clk::benchmarks::make_random_dag(size);
+        auto& graph = topology->graph;
+
+        BENCHMARK(clk::benchmarks::size_name("Random DAG", size) + ", adding and removing a node")
+        {
+            auto node = std::make_unique<clk::benchmarks::sum_node>(1);
+            auto* node_pointer = node.get();
+            graph.add_node(std::move(node));
+            graph.remove_node(node_pointer);
+        };
+
+        BENCHMARK(clk::benchmarks::size_name("Random DAG", size) + ", adding and removing a connected node")
+        {
+            auto node = std::make_unique<clk::benchmarks::sum_node>(1);
+            auto* node_pointer = node.get();
+            node_pointer->in(0).connect_to(topology->sink()->out, false);
+            graph.add_node(std::move(node));
+            node_pointer->in(0).disconnect(false);
+            graph.remove_node(node_pointer);
+        };
+    }
+}
@@ -0,0 +1,35 @@
+#include "clk/layout/layered_layout.hpp"
+#include "topologies.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <vector>
+
+TEST_CASE("Layered layouts", "[!benchmark], [layout]")
+{
+    for(std::size_t size : {1'000, 5'000, 10'000})
+    {
+        std::vector<glm::vec2> const node_sizes(size, glm::vec2{150.0f, 80.0f});
+
+        auto chain = clk::benchmarks::make_chain(size);
+        BENCHMARK(clk::benchmarks::size_name("Chain", size))
+        {
+            return clk::layout::layered_layout(chain->graph, node_sizes);
+        };
+
+        auto diamonds = clk::benchmarks::make_diamonds(size);
+        std::vector<glm::vec2> const diamond_sizes(diamonds->nodes.size(), glm::vec2{150.0f, 80.0f});
+        BENCHMARK(clk::benchmarks::size_name("Diamonds", size))
+        {
+            return clk::layout::layered_layout(diamonds->graph, diamond_sizes);
+        };
+
+        auto random_dag = clk::benchmarks::make_random_dag(size);
+        BENCHMARK(clk::benchmarks::size_name("Random DAG", size))
+        {
+            return clk::layout::layered_layout(random_dag->graph, node_sizes);
+        };
+    }
+}
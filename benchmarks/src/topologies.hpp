@@ -0,0 +1,161 @@
+#pragma once
+
+#include "clk/base/graph.hpp"
+#include "clk/base/input.hpp"
+#include "clk/base/node.hpp"
+#include "clk/base/output.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clk::benchmarks
+{
+class sum_node final : public clk::node
+{
+public:
+    clk::output_of<int> out{"Out"};
+
+    explicit sum_node(std::size_t input_count)
+    {
+        for(std::size_t i = 0; i < input_count; i++)
+        {
+            _inputs.push_back(std::make_unique<clk::input_of<int>>("In"));
+            register_port(_inputs.back().get());
+        }
+        register_port(&out);
+    }
+
+    auto name() const -> std::string_view final
+    {
+        return "Sum";
+    }
+
+    auto in(std::size_t index) -> clk::input_of<int>&
+    {
+        return *_inputs[index];
+    }
+
+    auto input_count() const -> std::size_t
+    {
+        return _inputs.size();
+    }
+
+private:
+    std::vector<std::unique_ptr<clk::input_of<int>>> _inputs;
+
+    void update() final
+    {
+        int sum = 1;
+        for(auto const& input : _inputs)
+            sum += **input;
+        *out = sum;
+    }
+};
+
+// A graph of sum nodes, the first node is the single source of the graph and the last node one of its sinks.
+class topology final
+{
+public:
+    topology() = default;
+    topology(topology const&) = delete;
+    topology(topology&&) = delete;
+    auto operator=(topology const&) -> topology& = delete;
+    auto operator=(topology&&) -> topology& = delete;
+
+    ~topology()
+    {
+        // disconnecting without notifications first, otherwise every destroyed output pushes through the rest
+        for(auto* node : nodes)
+            for(std::size_t i = 0; i < node->input_count(); i++)
+                node->in(i).disconnect(false);
+    }
+
+    clk::graph graph;
+    std::vector<sum_node*> nodes;
+
+    auto add_node(std::size_t input_count) -> sum_node*
+    {
+        auto node = std::make_unique<sum_node>(input_count);
+        auto* node_pointer = node.get();
+        graph.add_node(std::move(node));
+        nodes.push_back(node_pointer);
+        return node_pointer;
+    }
+
+    auto source() const -> sum_node*
+    {
+        return nodes.front();
+    }
+
+    auto sink() const -> sum_node*
+    {
+        return nodes.back();
+    }
+};
+
+// every node depends on the previous one
+inline auto make_chain(std::size_t size) -> std::unique_ptr<topology>
+{
+    auto result = std::make_unique<topology>();
+    result->add_node(1);
+    for(std::size_t i = 1; i < size; i++)
+        result->add_node(1)->in(0).connect_to(result->nodes[i - 1]->out, false);
+    return result;
+}
+
+// every node depends on the source
+inline auto make_fan_out(std::size_t size) -> std::unique_ptr<topology>
+{
+    auto result = std::make_unique<topology>();
+    result->add_node(1);
+    for(std::size_t i = 1; i < size; i++)
+        result->add_node(1)->in(0).connect_to(result->source()->out, false);
+    return result;
+}
+
+// a chain of diamonds, the top of every diamond feeds two nodes which are joined at its bottom
+inline auto make_diamonds(std::size_t size) -> std::unique_ptr<topology>
+{
+    auto result = std::make_unique<topology>();
+    auto* top = result->add_node(1);
+    while(result->nodes.size() + 3 <= size)
+    {
+        auto* left = result->add_node(1);
+        auto* right = result->add_node(1);
+        auto* bottom = result->add_node(2);
+        left->in(0).connect_to(top->out, false);
+        right->in(0).connect_to(top->out, false);
+        bottom->in(0).connect_to(left->out, false);
+        bottom->in(1).connect_to(right->out, false);
+        top = bottom;
+    }
+    return result;
+}
+
+// every node depends on up to two random earlier nodes, the same seed always produces the same graph
+inline auto make_random_dag(std::size_t size, std::uint32_t seed = 42) -> std::unique_ptr<topology>
+{
+    auto result = std::make_unique<topology>();
+    std::mt19937 generator(seed);
+    result->add_node(1);
+    for(std::size_t i = 1; i < size; i++)
+    {
+        auto* node = result->add_node(2);
+        std::uniform_int_distribution<std::size_t> distribution(0, i - 1);
+        node->in(0).connect_to(result->nodes[distribution(generator)]->out, false);
+        node->in(1).connect_to(result->nodes[distribution(generator)]->out, false);
+    }
+    return result;
+}
+
+inline auto size_name(std::string_view topology_name, std::size_t size) -> std::string
+{
+    return std::string(topology_name) + " of " + std::to_string(size) + " nodes";
+}
+
+} // namespace clk::benchmarks
@@ -28,6 +28,7 @@ private:
     clk::output_of<clk::color_rgb> _result{"Result"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 class subtract_colors final : public clk::algorithm_builder<subtract_colors>
@@ -43,6 +44,7 @@ private:
     clk::output_of<clk::color_rgb> _result{"Result"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 class multiply_colors final : public clk::algorithm_builder<multiply_colors>
@@ -58,6 +60,7 @@ private:
     clk::output_of<clk::color_rgb> _result{"Result"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 class divide_colors final : public clk::algorithm_builder<divide_colors>
@@ -119,6 +122,7 @@ private:
     clk::output_of<clk::color_rgb> _output_color{"Color"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 class mix_colors final : public clk::algorithm_builder<mix_colors>
 {
@@ -134,6 +138,7 @@ private:
     clk::output_of<clk::color_rgb> _mixed_color{"Mixed Color"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 class random_color final : public clk::algorithm_builder<random_color>
@@ -163,6 +168,7 @@ private:
     clk::output_of<clk::color_rgb> _color{"Color"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 class apply_gamma final : public clk::algorithm_builder<apply_gamma>
@@ -177,6 +183,7 @@ private:
     clk::output_of<clk::color_rgb> _gamma_corrected{"Gamma Corrected"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 class remove_gamma final : public clk::algorithm_builder<remove_gamma>
@@ -191,12 +198,14 @@ private:
     clk::output_of<clk::color_rgb> _linear{"Linear"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 class tonemap_reinhard final : public clk::algorithm_builder<tonemap_reinhard>
 {
 public:
     static constexpr std::string_view name = "Tonemap Reinhard";
+    static constexpr bool pure = true;
 
     tonemap_reinhard();
 
@@ -205,12 +214,14 @@ private:
     clk::output_of<clk::color_rgb> _tonemapped_color{"Tonemapped Color"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 class tonemap_filmic_aces final : public clk::algorithm_builder<tonemap_filmic_aces>
 {
 public:
     static constexpr std::string_view name = "Tonemap Filmic ACES";
+    static constexpr bool pure = true;
 
     tonemap_filmic_aces();
 
@@ -219,6 +230,7 @@ private:
     clk::output_of<clk::color_rgb> _tonemapped_color{"Tonemapped Color"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 } // namespace clk::algorithms
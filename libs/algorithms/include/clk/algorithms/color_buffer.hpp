@@ -0,0 +1,129 @@
+#pragma once
+
+#include "clk/base/algorithm.hpp"
+#include "clk/base/input.hpp"
+#include "clk/base/output.hpp"
+#include "clk/util/color_buffer.hpp"
+#include "clk/util/color_rgb.hpp"
+
+#include <string_view>
+
+namespace clk::algorithms
+{
+class fill_color_buffer final : public clk::algorithm_builder<fill_color_buffer>
+{
+public:
+    static constexpr std::string_view name = "Fill Color Buffer";
+
+    fill_color_buffer();
+
+private:
+    clk::input_of<int> _size{"Size"};
+    clk::input_of<clk::color_rgb> _color{"Color"};
+    clk::output_of<clk::color_buffer> _buffer{"Buffer"};
+
+    void update() override;
+};
+
+class sample_color_buffer final : public clk::algorithm_builder<sample_color_buffer>
+{
+public:
+    static constexpr std::string_view name = "Sample Color Buffer";
+
+    sample_color_buffer();
+
+private:
+    clk::input_of<clk::color_buffer> _buffer{"Buffer"};
+    clk::input_of<int> _index{"Index"};
+    clk::output_of<clk::color_rgb> _color{"Color"};
+
+    void update() override;
+};
+
+class grayscale_buffer final : public clk::algorithm_builder<grayscale_buffer>
+{
+public:
+    static constexpr std::string_view name = "Grayscale Buffer";
+
+    grayscale_buffer();
+
+private:
+    clk::input_of<clk::color_buffer> _input_buffer{"Buffer"};
+    clk::output_of<clk::color_buffer> _output_buffer{"Buffer"};
+
+    void update() override;
+};
+
+class mix_color_buffers final : public clk::algorithm_builder<mix_color_buffers>
+{
+public:
+    static constexpr std::string_view name = "Mix Color Buffers";
+
+    mix_color_buffers();
+
+private:
+    clk::input_of<float> _factor{"Factor"};
+    clk::input_of<clk::color_buffer> _buffer_a{"Buffer A"};
+    clk::input_of<clk::color_buffer> _buffer_b{"Buffer B"};
+    clk::output_of<clk::color_buffer> _mixed_buffer{"Mixed Buffer"};
+
+    void update() override;
+};
+
+class apply_gamma_buffer final : public clk::algorithm_builder<apply_gamma_buffer>
+{
+public:
+    static constexpr std::string_view name = "Apply Gamma Buffer";
+
+    apply_gamma_buffer();
+
+private:
+    clk::input_of<clk::color_buffer> _linear{"Linear"};
+    clk::output_of<clk::color_buffer> _gamma_corrected{"Gamma Corrected"};
+
+    void update() override;
+};
+
+class remove_gamma_buffer final : public clk::algorithm_builder<remove_gamma_buffer>
+{
+public:
+    static constexpr std::string_view name = "Remove Gamma Buffer";
+
+    remove_gamma_buffer();
+
+private:
+    clk::input_of<clk::color_buffer> _gamma_corrected{"Gamma Corrected"};
+    clk::output_of<clk::color_buffer> _linear{"Linear"};
+
+    void update() override;
+};
+
+class tonemap_reinhard_buffer final : public clk::algorithm_builder<tonemap_reinhard_buffer>
+{
+public:
+    static constexpr std::string_view name = "Tonemap Reinhard Buffer";
+
+    tonemap_reinhard_buffer();
+
+private:
+    clk::input_of<clk::color_buffer> _input_buffer{"Input Buffer"};
+    clk::output_of<clk::color_buffer> _tonemapped_buffer{"Tonemapped Buffer"};
+
+    void update() override;
+};
+
+class tonemap_filmic_aces_buffer final : public clk::algorithm_builder<tonemap_filmic_aces_buffer>
+{
+public:
+    static constexpr std::string_view name = "Tonemap Filmic ACES Buffer";
+
+    tonemap_filmic_aces_buffer();
+
+private:
+    clk::input_of<clk::color_buffer> _input_buffer{"Input Buffer"};
+    clk::output_of<clk::color_buffer> _tonemapped_buffer{"Tonemapped Buffer"};
+
+    void update() override;
+};
+
+} // namespace clk::algorithms
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "clk/base/input.hpp"
+#include "clk/base/node.hpp"
+#include "clk/base/output.hpp"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace clk
+{
+class graph;
+}
+
+namespace clk::algorithms
+{
+enum class math_operation
+{
+    add,
+    subtract,
+    multiply,
+    divide,
+    pow,
+    nth_root,
+    rad_to_deg,
+    deg_to_rad,
+    sin,
+    cos
+};
+
+// Evaluates a tree of elementwise float operations in a single update. The values of the tree are numbered with the
+// inputs first, followed by the result of every operation in order, the last operation yields the result.
+class fused_math_node final : public clk::node
+{
+public:
+    struct operation
+    {
+        math_operation type = math_operation::add;
+        // unary operations only read the first operand
+        std::array<std::size_t, 2> operands = {0, 0};
+    };
+
+    fused_math_node() = delete;
+    fused_math_node(std::size_t input_count, std::vector<operation> operations);
+    fused_math_node(fused_math_node const&) = delete;
+    fused_math_node(fused_math_node&&) noexcept = delete;
+    auto operator=(fused_math_node const&) -> fused_math_node& = delete;
+    auto operator=(fused_math_node&&) noexcept -> fused_math_node& = delete;
+    ~fused_math_node() final = default;
+
+    auto name() const -> std::string_view final;
+    auto input(std::size_t index) -> clk::input_of<float>&;
+    auto result() -> clk::output_of<float>&;
+    auto operations() const -> std::vector<operation> const&;
+
+private:
+    std::vector<std::unique_ptr<clk::input_of<float>>> _operand_inputs;
+    clk::output_of<float> _result{"Result"};
+    std::vector<operation> _operations;
+    std::vector<float const*> _values;
+    std::vector<float> _columns;
+
+    void update() final;
+    void process_batch(std::size_t count) final;
+    // runs every operation over count elements, once the inputs are set and the columns are large enough
+    void evaluate(std::size_t count);
+};
+
+// Replaces every tree of at least two elementwise float math nodes with a fused math node. A node joins the tree of
+// the node that reads its result if that is its only reader, the connections into and out of a tree are kept. Nodes
+// with observed outputs are left as they are, so the outputs stay valid. Returns the number of fused nodes.
+auto fuse_elementwise_math(clk::graph& graph) -> std::size_t;
+
+} // namespace clk::algorithms
@@ -57,6 +57,7 @@ private:
     clk::output_of<int> _result{"Result"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 class subtract_integers final : public clk::algorithm_builder<subtract_integers>
@@ -72,6 +73,7 @@ private:
     clk::output_of<int> _result{"Result"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 class multiply_integers final : public clk::algorithm_builder<multiply_integers>
@@ -87,6 +89,7 @@ private:
     clk::output_of<int> _result{"Result"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 class divide_integers final : public clk::algorithm_builder<divide_integers>
@@ -132,6 +135,7 @@ private:
     clk::output_of<float> _result{"Result"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 class subtract_floats final : public clk::algorithm_builder<subtract_floats>
@@ -147,6 +151,7 @@ private:
     clk::output_of<float> _result{"Result"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 class multiply_floats final : public clk::algorithm_builder<multiply_floats>
@@ -162,6 +167,7 @@ private:
     clk::output_of<float> _result{"Result"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 class divide_floats final : public clk::algorithm_builder<divide_floats>
@@ -183,6 +189,7 @@ class pow final : public clk::algorithm_builder<pow>
 {
 public:
     static constexpr std::string_view name = "Pow";
+    static constexpr bool pure = true;
 
     pow();
 
@@ -192,12 +199,14 @@ private:
     clk::output_of<float> _result{"Result"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 class nth_root final : public clk::algorithm_builder<nth_root>
 {
 public:
     static constexpr std::string_view name = "Nth Root";
+    static constexpr bool pure = true;
 
     nth_root();
 
@@ -221,6 +230,7 @@ private:
     clk::output_of<float> _degrees{"Degrees"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 class deg_to_rad final : public clk::algorithm_builder<deg_to_rad>
@@ -235,6 +245,7 @@ private:
     clk::output_of<float> _radians{"Radians"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 class sin final : public clk::algorithm_builder<sin>
@@ -249,6 +260,7 @@ private:
     clk::output_of<float> _sin{"Sine"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 class cos final : public clk::algorithm_builder<cos>
@@ -263,6 +275,7 @@ private:
     clk::output_of<float> _cos{"Cosine"};
 
     void update() override;
+    void update_batch(std::size_t count) override;
 };
 
 class is_even final : public clk::algorithm_builder<is_even>
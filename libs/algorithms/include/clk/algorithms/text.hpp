@@ -14,6 +14,7 @@ class uppercase final : public clk::algorithm_builder<uppercase>
 {
 public:
     static constexpr std::string_view name = "Uppercase";
+    static constexpr bool pure = true;
 
     uppercase();
 
@@ -28,6 +29,7 @@ class lowercase final : public clk::algorithm_builder<lowercase>
 {
 public:
     static constexpr std::string_view name = "Lowercase";
+    static constexpr bool pure = true;
 
     lowercase();
 
@@ -6,6 +6,7 @@ boolean_not::boolean_not()
 {
     register_port(_a);
     register_port(_result);
+    _result.set_early_cutoff(true);
 }
 
 void boolean_not::update()
@@ -18,6 +19,7 @@ boolean_and::boolean_and()
     register_port(_a);
     register_port(_b);
     register_port(_result);
+    _result.set_early_cutoff(true);
 }
 
 void boolean_and::update()
@@ -30,6 +32,7 @@ boolean_nand::boolean_nand()
     register_port(_a);
     register_port(_b);
     register_port(_result);
+    _result.set_early_cutoff(true);
 }
 
 void boolean_nand::update()
@@ -42,6 +45,7 @@ boolean_or::boolean_or()
     register_port(_a);
     register_port(_b);
     register_port(_result);
+    _result.set_early_cutoff(true);
 }
 
 void boolean_or::update()
@@ -54,6 +58,7 @@ boolean_nor::boolean_nor()
     register_port(_a);
     register_port(_b);
     register_port(_result);
+    _result.set_early_cutoff(true);
 }
 
 void boolean_nor::update()
@@ -66,6 +71,7 @@ boolean_xor::boolean_xor()
     register_port(_a);
     register_port(_b);
     register_port(_result);
+    _result.set_early_cutoff(true);
 }
 
 void boolean_xor::update()
@@ -78,6 +84,7 @@ boolean_xnor::boolean_xnor()
     register_port(_a);
     register_port(_b);
     register_port(_result);
+    _result.set_early_cutoff(true);
 }
 
 void boolean_xnor::update()
@@ -89,6 +96,7 @@ integer_to_boolean::integer_to_boolean()
 {
     register_port(_integer);
     register_port(_boolean);
+    _boolean.set_early_cutoff(true);
 }
 
 void integer_to_boolean::update()
@@ -100,6 +108,7 @@ boolean_to_integer::boolean_to_integer()
 {
     register_port(_boolean);
     register_port(_integer);
+    _integer.set_early_cutoff(true);
 }
 
 void boolean_to_integer::update()
@@ -1,6 +1,8 @@
 #include "clk/algorithms/color.hpp"
+#include "transform_columns.hpp"
 
 #include <chrono>
+#include <functional>
 #include <glm/glm.hpp>
 #include <random>
 #include <stdexcept>
@@ -8,6 +10,47 @@
 
 namespace clk::algorithms
 {
+namespace
+{
+auto to_grayscale(clk::color_rgb const& color) -> clk::color_rgb
+{
+    const glm::vec3 linear_grayscale = glm::vec3(0.2126, 0.7152, 0.0722);
+    return clk::color_rgb(glm::dot(linear_grayscale, color.vector()));
+}
+
+auto mix(float factor, clk::color_rgb const& color_a, clk::color_rgb const& color_b) -> clk::color_rgb
+{
+    float f = factor / 100.0f;
+    return f * color_a + (1 - f) * color_b;
+}
+
+auto to_gamma_corrected(clk::color_rgb const& linear) -> clk::color_rgb
+{
+    return clk::color_rgb(glm::pow(linear.vector(), glm::vec3(1 / 2.2f)));
+}
+
+auto to_linear(clk::color_rgb const& gamma_corrected) -> clk::color_rgb
+{
+    return clk::color_rgb(glm::pow(gamma_corrected.vector(), glm::vec3(2.2f)));
+}
+
+auto reinhard(clk::color_rgb const& color) -> clk::color_rgb
+{
+    return color / clk::color_rgb(color + glm::vec3(1.0f));
+}
+
+auto filmic_aces(clk::color_rgb const& color) -> clk::color_rgb
+{
+    auto c = 2.43f;
+    auto d = 0.59f;
+    auto e = 0.14f;
+    auto a = 2.51f;
+    auto b = 0.03f;
+
+    return (color * (a * color + b)) / (color * (c * color + d) + e);
+}
+} // namespace
+
 add_colors::add_colors()
 {
     register_port(_color_a);
@@ -20,6 +63,11 @@ void add_colors::update()
     *_result = *_color_a + *_color_b;
 }
 
+void add_colors::update_batch(std::size_t count)
+{
+    transform_columns(count, _result, std::plus<>(), _color_a, _color_b);
+}
+
 subtract_colors::subtract_colors()
 {
     register_port(_color_a);
@@ -32,6 +80,11 @@ void subtract_colors::update()
     *_result = *_color_a - *_color_b;
 }
 
+void subtract_colors::update_batch(std::size_t count)
+{
+    transform_columns(count, _result, std::minus<>(), _color_a, _color_b);
+}
+
 multiply_colors::multiply_colors()
 {
     register_port(_color_a);
@@ -44,6 +97,11 @@ void multiply_colors::update()
     *_result = *_color_a * *_color_b;
 }
 
+void multiply_colors::update_batch(std::size_t count)
+{
+    transform_columns(count, _result, std::multiplies<>(), _color_a, _color_b);
+}
+
 divide_colors::divide_colors()
 {
     register_port(_color_a);
@@ -107,8 +165,12 @@ grayscale::grayscale()
 
 void grayscale::update()
 {
-    const glm::vec3 linear_grayscale = glm::vec3(0.2126, 0.7152, 0.0722);
-    *_output_color = clk::color_rgb(glm::dot(linear_grayscale, _input_color->vector()));
+    *_output_color = to_grayscale(*_input_color);
+}
+
+void grayscale::update_batch(std::size_t count)
+{
+    transform_columns(count, _output_color, to_grayscale, _input_color);
 }
 
 mix_colors::mix_colors()
@@ -121,8 +183,12 @@ mix_colors::mix_colors()
 
 void mix_colors::update()
 {
-    float f = _factor.data() / 100.0f;
-    *_mixed_color = f * _color_a.data() + (1 - f) * _color_b.data();
+    *_mixed_color = mix(*_factor, *_color_a, *_color_b);
+}
+
+void mix_colors::update_batch(std::size_t count)
+{
+    transform_columns(count, _mixed_color, mix, _factor, _color_a, _color_b);
 }
 
 random_color::random_color()
@@ -156,6 +222,16 @@ void value_to_color::update()
     *_color = clk::color_rgb{*_value};
 }
 
+void value_to_color::update_batch(std::size_t count)
+{
+    transform_columns(
+        count, _color,
+        [](float value) {
+            return clk::color_rgb{value};
+        },
+        _value);
+}
+
 apply_gamma::apply_gamma()
 {
     register_port(_linear);
@@ -164,7 +240,12 @@ apply_gamma::apply_gamma()
 
 void apply_gamma::update()
 {
-    *_gamma_corrected = clk::color_rgb(glm::pow(_linear->vector(), glm::vec3(1 / 2.2f)));
+    *_gamma_corrected = to_gamma_corrected(*_linear);
+}
+
+void apply_gamma::update_batch(std::size_t count)
+{
+    transform_columns(count, _gamma_corrected, to_gamma_corrected, _linear);
 }
 
 remove_gamma::remove_gamma()
@@ -175,7 +256,12 @@ remove_gamma::remove_gamma()
 
 void remove_gamma::update()
 {
-    *_linear = clk::color_rgb(glm::pow(_gamma_corrected->vector(), glm::vec3(2.2f)));
+    *_linear = to_linear(*_gamma_corrected);
+}
+
+void remove_gamma::update_batch(std::size_t count)
+{
+    transform_columns(count, _linear, to_linear, _gamma_corrected);
 }
 
 tonemap_reinhard::tonemap_reinhard()
@@ -186,7 +272,12 @@ tonemap_reinhard::tonemap_reinhard()
 
 void tonemap_reinhard::update()
 {
-    *_tonemapped_color = *_input_color / clk::color_rgb(*_input_color + glm::vec3(1.0f));
+    *_tonemapped_color = reinhard(*_input_color);
+}
+
+void tonemap_reinhard::update_batch(std::size_t count)
+{
+    transform_columns(count, _tonemapped_color, reinhard, _input_color);
 }
 
 tonemap_filmic_aces::tonemap_filmic_aces()
@@ -197,13 +288,12 @@ tonemap_filmic_aces::tonemap_filmic_aces()
 
 void tonemap_filmic_aces::update()
 {
-    auto c = 2.43f;
-    auto d = 0.59f;
-    auto e = 0.14f;
-    auto a = 2.51f;
-    auto b = 0.03f;
+    *_tonemapped_color = filmic_aces(*_input_color);
+}
 
-    *_tonemapped_color = (*_input_color * (a * *_input_color + b)) / *_input_color * (c * *_input_color + d) + e;
+void tonemap_filmic_aces::update_batch(std::size_t count)
+{
+    transform_columns(count, _tonemapped_color, filmic_aces, _input_color);
 }
 
 } // namespace clk::algorithms
@@ -0,0 +1,125 @@
+#include "clk/algorithms/color_buffer.hpp"
+#include "color_kernels.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace clk::algorithms
+{
+fill_color_buffer::fill_color_buffer()
+{
+    register_port(_size);
+    register_port(_color);
+    register_port(_buffer);
+
+    *_size.default_port() = 1;
+}
+
+void fill_color_buffer::update()
+{
+    if(*_size < 0)
+    {
+        throw std::runtime_error("Size is negative!");
+    }
+
+    _buffer->resize(static_cast<std::size_t>(*_size));
+    _buffer->fill(*_color);
+}
+
+sample_color_buffer::sample_color_buffer()
+{
+    register_port(_buffer);
+    register_port(_index);
+    register_port(_color);
+}
+
+void sample_color_buffer::update()
+{
+    if(*_index < 0 || static_cast<std::size_t>(*_index) >= _buffer->size())
+    {
+        throw std::runtime_error("Index is out of bounds!");
+    }
+
+    *_color = _buffer->at(static_cast<std::size_t>(*_index));
+}
+
+grayscale_buffer::grayscale_buffer()
+{
+    register_port(_input_buffer);
+    register_port(_output_buffer);
+}
+
+void grayscale_buffer::update()
+{
+    _output_buffer->resize(_input_buffer->size());
+    best_color_kernels().grayscale(*_input_buffer, *_output_buffer);
+}
+
+mix_color_buffers::mix_color_buffers()
+{
+    register_port(_factor);
+    register_port(_buffer_a);
+    register_port(_buffer_b);
+    register_port(_mixed_buffer);
+}
+
+void mix_color_buffers::update()
+{
+    if(_buffer_a->size() != _buffer_b->size())
+    {
+        throw std::runtime_error("Buffers have different sizes!");
+    }
+
+    _mixed_buffer->resize(_buffer_a->size());
+    best_color_kernels().mix(*_factor, *_buffer_a, *_buffer_b, *_mixed_buffer);
+}
+
+apply_gamma_buffer::apply_gamma_buffer()
+{
+    register_port(_linear);
+    register_port(_gamma_corrected);
+}
+
+void apply_gamma_buffer::update()
+{
+    _gamma_corrected->resize(_linear->size());
+    best_color_kernels().apply_gamma(*_linear, *_gamma_corrected);
+}
+
+remove_gamma_buffer::remove_gamma_buffer()
+{
+    register_port(_gamma_corrected);
+    register_port(_linear);
+}
+
+void remove_gamma_buffer::update()
+{
+    _linear->resize(_gamma_corrected->size());
+    best_color_kernels().remove_gamma(*_gamma_corrected, *_linear);
+}
+
+tonemap_reinhard_buffer::tonemap_reinhard_buffer()
+{
+    register_port(_input_buffer);
+    register_port(_tonemapped_buffer);
+}
+
+void tonemap_reinhard_buffer::update()
+{
+    _tonemapped_buffer->resize(_input_buffer->size());
+    best_color_kernels().tonemap_reinhard(*_input_buffer, *_tonemapped_buffer);
+}
+
+tonemap_filmic_aces_buffer::tonemap_filmic_aces_buffer()
+{
+    register_port(_input_buffer);
+    register_port(_tonemapped_buffer);
+}
+
+void tonemap_filmic_aces_buffer::update()
+{
+    _tonemapped_buffer->resize(_input_buffer->size());
+    best_color_kernels().tonemap_filmic_aces(*_input_buffer, *_tonemapped_buffer);
+}
+
+} // namespace clk::algorithms
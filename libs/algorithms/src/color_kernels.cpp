@@ -0,0 +1,119 @@
+#include "color_kernels.hpp"
+#include "color_kernels_impl.hpp"
+
+#include <cmath>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace clk::algorithms
+{
+namespace
+{
+struct scalar_vector
+{
+    using type = float;
+    static constexpr std::size_t width = 1;
+
+    static auto load(float const* source) -> type
+    {
+        return *source;
+    }
+
+    static void store(float* destination, type value)
+    {
+        *destination = value;
+    }
+
+    static auto broadcast(float value) -> type
+    {
+        return value;
+    }
+
+    static auto add(type a, type b) -> type
+    {
+        return a + b;
+    }
+
+    static auto subtract(type a, type b) -> type
+    {
+        return a - b;
+    }
+
+    static auto multiply(type a, type b) -> type
+    {
+        return a * b;
+    }
+
+    static auto divide(type a, type b) -> type
+    {
+        return a / b;
+    }
+
+    static auto multiply_add(type a, type b, type c) -> type
+    {
+        return a * b + c;
+    }
+
+    static auto pow(type x, float exponent) -> type
+    {
+        return x > 0.0f ? std::pow(x, exponent) : 0.0f;
+    }
+};
+
+auto cpu_supports_sse41() -> bool
+{
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.1");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 19)) != 0;
+#else
+    return false;
+#endif
+}
+
+auto cpu_supports_avx2() -> bool
+{
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 1);
+    bool const fma = (info[2] & (1 << 12)) != 0;
+    bool const os_saves_registers = (info[2] & (1 << 27)) != 0;
+    bool const avx = (info[2] & (1 << 28)) != 0;
+    if(!fma || !os_saves_registers || !avx || (_xgetbv(0) & 0b110) != 0b110)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+} // namespace
+
+auto scalar_color_kernels() -> color_kernels const&
+{
+    static color_kernels const table = kernels::make_color_kernels<scalar_vector>();
+    return table;
+}
+
+auto best_color_kernels() -> color_kernels const&
+{
+    static color_kernels const& table = []() -> color_kernels const& {
+        if(auto const* avx2 = avx2_color_kernels(); avx2 != nullptr && cpu_supports_avx2())
+            return *avx2;
+        if(auto const* sse41 = sse41_color_kernels(); sse41 != nullptr && cpu_supports_sse41())
+            return *sse41;
+        return scalar_color_kernels();
+    }();
+    return table;
+}
+
+} // namespace clk::algorithms
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+
+namespace clk
+{
+class color_buffer;
+}
+
+namespace clk::algorithms
+{
+// Implementations of the color algorithms over whole color buffers, for one instruction set. The output buffer must
+// already have the size of the inputs, and may be the same buffer as one of them.
+struct color_kernels
+{
+    void (*grayscale)(clk::color_buffer const& input, clk::color_buffer& output);
+    void (*mix)(float factor, clk::color_buffer const& a, clk::color_buffer const& b, clk::color_buffer& output);
+    void (*apply_gamma)(clk::color_buffer const& input, clk::color_buffer& output);
+    void (*remove_gamma)(clk::color_buffer const& input, clk::color_buffer& output);
+    void (*tonemap_reinhard)(clk::color_buffer const& input, clk::color_buffer& output);
+    void (*tonemap_filmic_aces)(clk::color_buffer const& input, clk::color_buffer& output);
+};
+
+auto scalar_color_kernels() -> color_kernels const&;
+// null when the instruction set is not available for the target architecture
+auto sse41_color_kernels() -> color_kernels const*;
+auto avx2_color_kernels() -> color_kernels const*;
+
+// the fastest implementation supported by the running CPU, detected once
+auto best_color_kernels() -> color_kernels const&;
+
+} // namespace clk::algorithms
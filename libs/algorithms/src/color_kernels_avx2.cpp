@@ -0,0 +1,123 @@
+#include "color_kernels.hpp"
+
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+
+#include "color_kernels_impl.hpp"
+
+#include <immintrin.h>
+
+namespace clk::algorithms
+{
+namespace
+{
+struct avx2_vector
+{
+    using type = __m256;
+    static constexpr std::size_t width = 8;
+
+    static auto load(float const* source) -> type
+    {
+        return _mm256_load_ps(source);
+    }
+
+    static void store(float* destination, type value)
+    {
+        _mm256_store_ps(destination, value);
+    }
+
+    static auto broadcast(float value) -> type
+    {
+        return _mm256_set1_ps(value);
+    }
+
+    static auto add(type a, type b) -> type
+    {
+        return _mm256_add_ps(a, b);
+    }
+
+    static auto subtract(type a, type b) -> type
+    {
+        return _mm256_sub_ps(a, b);
+    }
+
+    static auto multiply(type a, type b) -> type
+    {
+        return _mm256_mul_ps(a, b);
+    }
+
+    static auto divide(type a, type b) -> type
+    {
+        return _mm256_div_ps(a, b);
+    }
+
+    static auto multiply_add(type a, type b, type c) -> type
+    {
+        return _mm256_fmadd_ps(a, b, c);
+    }
+
+    static auto min(type a, type b) -> type
+    {
+        return _mm256_min_ps(a, b);
+    }
+
+    static auto max(type a, type b) -> type
+    {
+        return _mm256_max_ps(a, b);
+    }
+
+    static auto floor(type a) -> type
+    {
+        return _mm256_floor_ps(a);
+    }
+
+    static auto keep_positive(type value, type condition) -> type
+    {
+        return _mm256_and_ps(_mm256_cmp_ps(condition, _mm256_setzero_ps(), _CMP_GT_OQ), value);
+    }
+
+    static auto exponent(type x) -> type
+    {
+        __m256i const bits = _mm256_castps_si256(x);
+        __m256i const biased = _mm256_and_si256(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(0xff));
+        return _mm256_cvtepi32_ps(_mm256_sub_epi32(biased, _mm256_set1_epi32(127)));
+    }
+
+    static auto mantissa(type x) -> type
+    {
+        __m256i const bits = _mm256_castps_si256(x);
+        return _mm256_castsi256_ps(
+            _mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)), _mm256_set1_epi32(0x3f800000)));
+    }
+
+    static auto power_of_two(type integral) -> type
+    {
+        __m256i const biased = _mm256_add_epi32(_mm256_cvtps_epi32(integral), _mm256_set1_epi32(127));
+        return _mm256_castsi256_ps(_mm256_slli_epi32(biased, 23));
+    }
+
+    static auto pow(type x, float exponent) -> type
+    {
+        return kernels::approximate_pow<avx2_vector>(x, exponent);
+    }
+};
+} // namespace
+
+auto avx2_color_kernels() -> color_kernels const*
+{
+    static color_kernels const table = kernels::make_color_kernels<avx2_vector>();
+    return &table;
+}
+
+} // namespace clk::algorithms
+
+#else
+
+namespace clk::algorithms
+{
+auto avx2_color_kernels() -> color_kernels const*
+{
+    return nullptr;
+}
+} // namespace clk::algorithms
+
+#endif
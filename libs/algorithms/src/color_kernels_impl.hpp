@@ -0,0 +1,147 @@
+#pragma once
+
+#include "color_kernels.hpp"
+#include "clk/util/color_buffer.hpp"
+
+#include <cstddef>
+
+// Included only by the translation units that implement the color kernels for one instruction set, each of them
+// instantiates the kernels with its own vector type V. Those translation units are compiled with instruction set
+// specific flags, so they must not odr-use inline functions that other translation units use as well, otherwise the
+// linker might pick a copy which the running CPU does not support. The kernels only touch color buffers through
+// their (out of line) plane accessors for this reason.
+namespace clk::algorithms::kernels
+{
+template <typename V>
+using vector = typename V::type;
+
+template <typename V>
+auto polynomial(vector<V> /*x*/, float c0) -> vector<V>
+{
+    return V::broadcast(c0);
+}
+
+// evaluates c0 + x * (c1 + x * (c2 + ...))
+template <typename V, typename... Coefficients>
+auto polynomial(vector<V> x, float c0, Coefficients... coefficients) -> vector<V>
+{
+    return V::multiply_add(polynomial<V>(x, coefficients...), x, V::broadcast(c0));
+}
+
+// polynomial approximations with a relative error in the order of 1e-5, far below what is visible in a color
+template <typename V>
+auto approximate_log2(vector<V> x) -> vector<V>
+{
+    auto const mantissa = V::mantissa(x);
+    auto const p = polynomial<V>(
+        mantissa, 3.1157899f, -3.3241990f, 2.5988452f, -1.2315303f, 3.1821337e-1f, -3.4436006e-2f);
+    return V::multiply_add(p, V::subtract(mantissa, V::broadcast(1.0f)), V::exponent(x));
+}
+
+template <typename V>
+auto approximate_exp2(vector<V> x) -> vector<V>
+{
+    x = V::min(V::max(x, V::broadcast(-126.99999f)), V::broadcast(127.99999f));
+    auto const integral = V::floor(x);
+    auto const fraction = V::subtract(x, integral);
+    auto const p = polynomial<V>(
+        fraction, 9.9999994e-1f, 6.9315308e-1f, 2.4015361e-1f, 5.5826318e-2f, 8.9893397e-3f, 1.8775767e-3f);
+    return V::multiply(p, V::power_of_two(integral));
+}
+
+// bases that are not positive yield zero
+template <typename V>
+auto approximate_pow(vector<V> x, float exponent) -> vector<V>
+{
+    return V::keep_positive(approximate_exp2<V>(V::multiply(approximate_log2<V>(x), V::broadcast(exponent))), x);
+}
+
+template <typename V, typename Function>
+void transform_planes(clk::color_buffer const& input, clk::color_buffer& output, Function function)
+{
+    std::size_t const size = input.size();
+    for(std::size_t channel = 0; channel < 3; channel++)
+    {
+        float const* in = input.plane(channel);
+        float* out = output.plane(channel);
+        for(std::size_t i = 0; i < size; i += V::width)
+            V::store(out + i, function(V::load(in + i)));
+    }
+}
+
+template <typename V>
+void grayscale(clk::color_buffer const& input, clk::color_buffer& output)
+{
+    std::size_t const size = input.size();
+    float const* red = input.red();
+    float const* green = input.green();
+    float const* blue = input.blue();
+    for(std::size_t i = 0; i < size; i += V::width)
+    {
+        auto luminance = V::multiply(V::load(red + i), V::broadcast(0.2126f));
+        luminance = V::multiply_add(V::load(green + i), V::broadcast(0.7152f), luminance);
+        luminance = V::multiply_add(V::load(blue + i), V::broadcast(0.0722f), luminance);
+        V::store(output.red() + i, luminance);
+        V::store(output.green() + i, luminance);
+        V::store(output.blue() + i, luminance);
+    }
+}
+
+template <typename V>
+void mix(float factor, clk::color_buffer const& a, clk::color_buffer const& b, clk::color_buffer& output)
+{
+    std::size_t const size = a.size();
+    auto const f = V::broadcast(factor / 100.0f);
+    auto const one_minus_f = V::broadcast(1.0f - factor / 100.0f);
+    for(std::size_t channel = 0; channel < 3; channel++)
+    {
+        float const* in_a = a.plane(channel);
+        float const* in_b = b.plane(channel);
+        float* out = output.plane(channel);
+        for(std::size_t i = 0; i < size; i += V::width)
+            V::store(out + i, V::multiply_add(V::load(in_a + i), f, V::multiply(V::load(in_b + i), one_minus_f)));
+    }
+}
+
+template <typename V>
+void apply_gamma(clk::color_buffer const& input, clk::color_buffer& output)
+{
+    transform_planes<V>(input, output, [](vector<V> x) {
+        return V::pow(x, 1 / 2.2f);
+    });
+}
+
+template <typename V>
+void remove_gamma(clk::color_buffer const& input, clk::color_buffer& output)
+{
+    transform_planes<V>(input, output, [](vector<V> x) {
+        return V::pow(x, 2.2f);
+    });
+}
+
+template <typename V>
+void tonemap_reinhard(clk::color_buffer const& input, clk::color_buffer& output)
+{
+    transform_planes<V>(input, output, [](vector<V> x) {
+        return V::divide(x, V::add(x, V::broadcast(1.0f)));
+    });
+}
+
+template <typename V>
+void tonemap_filmic_aces(clk::color_buffer const& input, clk::color_buffer& output)
+{
+    transform_planes<V>(input, output, [](vector<V> x) {
+        auto const numerator = V::multiply(x, V::multiply_add(x, V::broadcast(2.51f), V::broadcast(0.03f)));
+        auto const denominator = V::multiply_add(
+            x, V::multiply_add(x, V::broadcast(2.43f), V::broadcast(0.59f)), V::broadcast(0.14f));
+        return V::divide(numerator, denominator);
+    });
+}
+
+template <typename V>
+auto make_color_kernels() -> color_kernels
+{
+    return {&grayscale<V>, &mix<V>, &apply_gamma<V>, &remove_gamma<V>, &tonemap_reinhard<V>, &tonemap_filmic_aces<V>};
+}
+
+} // namespace clk::algorithms::kernels
@@ -0,0 +1,123 @@
+#include "color_kernels.hpp"
+
+#if defined(__SSE4_1__) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+
+#include "color_kernels_impl.hpp"
+
+#include <smmintrin.h>
+
+namespace clk::algorithms
+{
+namespace
+{
+struct sse41_vector
+{
+    using type = __m128;
+    static constexpr std::size_t width = 4;
+
+    static auto load(float const* source) -> type
+    {
+        return _mm_load_ps(source);
+    }
+
+    static void store(float* destination, type value)
+    {
+        _mm_store_ps(destination, value);
+    }
+
+    static auto broadcast(float value) -> type
+    {
+        return _mm_set1_ps(value);
+    }
+
+    static auto add(type a, type b) -> type
+    {
+        return _mm_add_ps(a, b);
+    }
+
+    static auto subtract(type a, type b) -> type
+    {
+        return _mm_sub_ps(a, b);
+    }
+
+    static auto multiply(type a, type b) -> type
+    {
+        return _mm_mul_ps(a, b);
+    }
+
+    static auto divide(type a, type b) -> type
+    {
+        return _mm_div_ps(a, b);
+    }
+
+    static auto multiply_add(type a, type b, type c) -> type
+    {
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+    }
+
+    static auto min(type a, type b) -> type
+    {
+        return _mm_min_ps(a, b);
+    }
+
+    static auto max(type a, type b) -> type
+    {
+        return _mm_max_ps(a, b);
+    }
+
+    static auto floor(type a) -> type
+    {
+        return _mm_floor_ps(a);
+    }
+
+    static auto keep_positive(type value, type condition) -> type
+    {
+        return _mm_and_ps(_mm_cmpgt_ps(condition, _mm_setzero_ps()), value);
+    }
+
+    static auto exponent(type x) -> type
+    {
+        __m128i const bits = _mm_castps_si128(x);
+        __m128i const biased = _mm_and_si128(_mm_srli_epi32(bits, 23), _mm_set1_epi32(0xff));
+        return _mm_cvtepi32_ps(_mm_sub_epi32(biased, _mm_set1_epi32(127)));
+    }
+
+    static auto mantissa(type x) -> type
+    {
+        __m128i const bits = _mm_castps_si128(x);
+        return _mm_castsi128_ps(
+            _mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x3f800000)));
+    }
+
+    static auto power_of_two(type integral) -> type
+    {
+        __m128i const biased = _mm_add_epi32(_mm_cvtps_epi32(integral), _mm_set1_epi32(127));
+        return _mm_castsi128_ps(_mm_slli_epi32(biased, 23));
+    }
+
+    static auto pow(type x, float exponent) -> type
+    {
+        return kernels::approximate_pow<sse41_vector>(x, exponent);
+    }
+};
+} // namespace
+
+auto sse41_color_kernels() -> color_kernels const*
+{
+    static color_kernels const table = kernels::make_color_kernels<sse41_vector>();
+    return &table;
+}
+
+} // namespace clk::algorithms
+
+#else
+
+namespace clk::algorithms
+{
+auto sse41_color_kernels() -> color_kernels const*
+{
+    return nullptr;
+}
+} // namespace clk::algorithms
+
+#endif
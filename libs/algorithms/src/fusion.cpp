@@ -0,0 +1,405 @@
+#include "clk/algorithms/fusion.hpp"
+#include "clk/algorithms/math.hpp"
+#include "clk/base/algorithm_node.hpp"
+#include "clk/base/graph.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <range/v3/algorithm/any_of.hpp>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace clk::algorithms
+{
+namespace
+{
+constexpr std::array<std::pair<std::string_view, math_operation>, 10> fusable_algorithms = {{
+    {add_floats::name, math_operation::add},
+    {subtract_floats::name, math_operation::subtract},
+    {multiply_floats::name, math_operation::multiply},
+    {divide_floats::name, math_operation::divide},
+    {pow::name, math_operation::pow},
+    {nth_root::name, math_operation::nth_root},
+    {rad_to_deg::name, math_operation::rad_to_deg},
+    {deg_to_rad::name, math_operation::deg_to_rad},
+    {sin::name, math_operation::sin},
+    {cos::name, math_operation::cos},
+}};
+
+auto operand_count(math_operation type) -> std::size_t
+{
+    switch(type)
+    {
+    case math_operation::rad_to_deg:
+    case math_operation::deg_to_rad:
+    case math_operation::sin:
+    case math_operation::cos:
+        return 1;
+    default:
+        return 2;
+    }
+}
+
+auto fusable_operation(clk::node const& node) -> std::optional<math_operation>
+{
+    if(dynamic_cast<clk::algorithm_node const*>(&node) == nullptr)
+        return std::nullopt;
+    for(auto const& [name, type] : fusable_algorithms)
+        if(node.name() == name)
+            return type;
+    return std::nullopt;
+}
+
+// every operation is a separate loop over the columns, simple enough for the compiler to vectorize
+template <typename Function>
+void transform(std::size_t count, float* result, Function function, float const* a, float const* b)
+{
+    for(std::size_t i = 0; i < count; i++)
+        result[i] = function(a[i], b[i]);
+}
+
+void apply(math_operation type, std::size_t count, float* result, float const* a, float const* b)
+{
+    switch(type)
+    {
+    case math_operation::add:
+        transform(count, result, std::plus<>(), a, b);
+        break;
+    case math_operation::subtract:
+        transform(count, result, std::minus<>(), a, b);
+        break;
+    case math_operation::multiply:
+        transform(count, result, std::multiplies<>(), a, b);
+        break;
+    case math_operation::divide:
+        if(std::any_of(b, b + count, [](float divisor) { return divisor == 0; }))
+            throw std::runtime_error("Division by zero!");
+        transform(count, result, std::divides<>(), a, b);
+        break;
+    case math_operation::pow:
+        transform(
+            count, result,
+            [](float number, float exponent) {
+                return std::pow(number, exponent);
+            },
+            a, b);
+        break;
+    case math_operation::nth_root:
+        if(std::any_of(b, b + count, [](float root_degree) { return root_degree == 0.0f; }))
+            throw std::runtime_error("Cannot take 0th root!");
+        if(std::any_of(a, a + count, [](float number) { return number < 0.0f; }))
+            throw std::runtime_error("Cannot take root of negative number!");
+        transform(
+            count, result,
+            [](float number, float root_degree) {
+                return std::pow(number, 1.0f / root_degree);
+            },
+            a, b);
+        break;
+    case math_operation::rad_to_deg:
+        transform(
+            count, result,
+            [](float radians, float /*unused*/) {
+                return radians * 180.0f / 3.14159265f;
+            },
+            a, a);
+        break;
+    case math_operation::deg_to_rad:
+        transform(
+            count, result,
+            [](float degrees, float /*unused*/) {
+                return degrees * 3.14159265f / 180.0f;
+            },
+            a, a);
+        break;
+    case math_operation::sin:
+        transform(
+            count, result,
+            [](float angle, float /*unused*/) {
+                return std::sin(angle);
+            },
+            a, a);
+        break;
+    case math_operation::cos:
+        transform(
+            count, result,
+            [](float angle, float /*unused*/) {
+                return std::cos(angle);
+            },
+            a, a);
+        break;
+    }
+}
+
+// the nodes of a tree in the order they are evaluated, and the inputs that read from outside of the tree
+struct fusion_tree
+{
+    std::vector<clk::node*> nodes;
+    std::vector<clk::input*> external_inputs;
+};
+
+class fusion_pass
+{
+public:
+    fusion_pass() = delete;
+    explicit fusion_pass(clk::graph& graph) : _graph(graph)
+    {
+        for(auto const& node : graph.nodes())
+        {
+            for(auto* output : node->outputs())
+                _output_owners[output] = node.get();
+
+            auto type = fusable_operation(*node);
+            bool const observed = ranges::any_of(node->outputs(), [&](auto const* output) {
+                return graph.is_observed(*output);
+            });
+            if(!type.has_value() || observed)
+                continue;
+
+            _operations[node.get()] = *type;
+            for(auto* input : node->inputs())
+                _input_owners[input] = node.get();
+        }
+    }
+    fusion_pass(fusion_pass const&) = delete;
+    fusion_pass(fusion_pass&&) = delete;
+    auto operator=(fusion_pass const&) -> fusion_pass& = delete;
+    auto operator=(fusion_pass&&) -> fusion_pass& = delete;
+    ~fusion_pass() = default;
+
+    auto run() -> std::size_t
+    {
+        std::vector<clk::node*> roots;
+        for(auto const& node : _graph.nodes())
+            if(_operations.count(node.get()) != 0 && !is_absorbed(node.get()))
+                roots.push_back(node.get());
+
+        std::size_t fused_count = 0;
+        for(auto* root : roots)
+        {
+            fusion_tree tree;
+            collect(root, tree);
+            if(tree.nodes.size() > 1 && !reads_itself(root, tree))
+            {
+                fuse(root, tree);
+                fused_count++;
+            }
+        }
+        return fused_count;
+    }
+
+private:
+    clk::graph& _graph; // NOLINT
+    std::unordered_map<clk::node*, math_operation> _operations;
+    std::unordered_map<clk::input const*, clk::node*> _input_owners;
+    std::unordered_map<clk::output const*, clk::node*> _output_owners;
+
+    // fusable nodes whose result is read by exactly one other fusable node become part of its tree
+    auto is_absorbed(clk::node* node) const -> bool
+    {
+        auto const& readers = node->outputs().front()->connected_inputs();
+        if(readers.size() != 1)
+            return false;
+        auto it = _input_owners.find(readers.front());
+        return it != _input_owners.end() && it->second != node;
+    }
+
+    auto absorbed_source(clk::input const* input) const -> clk::node*
+    {
+        auto it = _output_owners.find(input->connected_output());
+        if(it == _output_owners.end() || _operations.count(it->second) == 0 || !is_absorbed(it->second))
+            return nullptr;
+        return it->second;
+    }
+
+    void collect(clk::node* node, fusion_tree& tree) const
+    {
+        for(auto* input : node->inputs())
+        {
+            if(auto* source = absorbed_source(input); source != nullptr)
+                collect(source, tree);
+            else
+                tree.external_inputs.push_back(input);
+        }
+        tree.nodes.push_back(node);
+    }
+
+    // a cycle through the root can not be fused, the root's output would be removed while it is still read
+    static auto reads_itself(clk::node* root, fusion_tree const& tree) -> bool
+    {
+        return ranges::any_of(tree.external_inputs, [&](auto const* input) {
+            return input->connected_output() == root->outputs().front();
+        });
+    }
+
+    void fuse(clk::node* root, fusion_tree const& tree)
+    {
+        // inputs reading the same output share an input of the fused node
+        std::unordered_map<clk::input const*, std::size_t> input_values;
+        std::unordered_map<clk::output const*, std::size_t> output_values;
+        std::vector<clk::input*> fused_inputs;
+        for(auto* input : tree.external_inputs)
+        {
+            auto const* source = input->connected_output();
+            if(source != nullptr)
+            {
+                if(auto it = output_values.find(source); it != output_values.end())
+                {
+                    input_values[input] = it->second;
+                    continue;
+                }
+                output_values[source] = fused_inputs.size();
+            }
+            input_values[input] = fused_inputs.size();
+            fused_inputs.push_back(input);
+        }
+
+        std::unordered_map<clk::node const*, std::size_t> node_values;
+        std::vector<fused_math_node::operation> operations;
+        for(auto* node : tree.nodes)
+        {
+            auto& operation = operations.emplace_back();
+            operation.type = _operations.at(node);
+            auto const& inputs = node->inputs();
+            for(std::size_t i = 0; i < operand_count(operation.type); i++)
+            {
+                auto* source = absorbed_source(inputs[i]);
+                operation.operands[i] = source != nullptr ? node_values.at(source) : input_values.at(inputs[i]);
+            }
+            node_values[node] = fused_inputs.size() + operations.size() - 1;
+        }
+
+        auto fused_node = std::make_unique<fused_math_node>(fused_inputs.size(), std::move(operations));
+        for(std::size_t i = 0; i < fused_inputs.size(); i++)
+        {
+            auto& fused_input = fused_node->input(i);
+            fused_input.set_name(std::string(fused_inputs[i]->name()));
+            *fused_input.default_port() = *static_cast<clk::input_of<float> const*>(fused_inputs[i])->default_port();
+            if(auto* source = fused_inputs[i]->connected_output(); source != nullptr)
+                fused_input.connect_to(*source, false);
+        }
+
+        // the readers are copied, connecting them elsewhere removes them from the root's output
+        auto const readers = root->outputs().front()->connected_inputs();
+        for(auto* reader : readers)
+            reader->connect_to(fused_node->result(), false);
+
+        // disconnecting first, so removing the nodes does not push through the rest of the graph, and forgetting them,
+        // so the addresses they free can not be mistaken for them later on
+        for(auto* node : tree.nodes)
+        {
+            for(auto* port : node->all_ports())
+                port->disconnect(false);
+            for(auto const* input : node->inputs())
+                _input_owners.erase(input);
+            for(auto const* output : node->outputs())
+                _output_owners.erase(output);
+            _operations.erase(node);
+            _graph.remove_node(node);
+        }
+        _graph.add_node(std::move(fused_node));
+    }
+};
+} // namespace
+
+fused_math_node::fused_math_node(std::size_t input_count, std::vector<operation> operations)
+    : _operations(std::move(operations))
+{
+    if(_operations.empty())
+        throw std::runtime_error("Fused math nodes need at least one operation");
+    for(std::size_t i = 0; i < _operations.size(); i++)
+    {
+        auto& operands = _operations[i].operands;
+        if(operand_count(_operations[i].type) == 1)
+            operands[1] = operands[0];
+        if(operands[0] >= input_count + i || operands[1] >= input_count + i)
+            throw std::runtime_error("Operations can only read the inputs and the results of earlier operations");
+    }
+
+    _operand_inputs.reserve(input_count);
+    for(std::size_t i = 0; i < input_count; i++)
+    {
+        auto& input = _operand_inputs.emplace_back(
+            std::make_unique<clk::input_of<float>>("Input " + std::to_string(i + 1)));
+        register_port(input.get());
+    }
+    register_port(&_result);
+}
+
+auto fused_math_node::name() const -> std::string_view
+{
+    return "Fused Math";
+}
+
+auto fused_math_node::input(std::size_t index) -> clk::input_of<float>&
+{
+    return *_operand_inputs.at(index);
+}
+
+auto fused_math_node::result() -> clk::output_of<float>&
+{
+    return _result;
+}
+
+auto fused_math_node::operations() const -> std::vector<operation> const&
+{
+    return _operations;
+}
+
+void fused_math_node::update()
+{
+    _columns.resize(_operand_inputs.size() + _operations.size());
+    _values.clear();
+    for(auto const& input : _operand_inputs)
+        _values.push_back(&input->data());
+    evaluate(1);
+    *_result = _values.back()[0];
+}
+
+void fused_math_node::process_batch(std::size_t count)
+{
+    std::size_t const value_count = _operand_inputs.size() + _operations.size();
+    _columns.resize(value_count * count);
+
+    // contiguous columns are read in place, broadcast values are spread over a column of their own
+    _values.clear();
+    for(std::size_t i = 0; i < _operand_inputs.size(); i++)
+    {
+        auto const column = _operand_inputs[i]->column();
+        if(column.is_broadcast())
+        {
+            std::fill_n(_columns.data() + i * count, count, column[0]);
+            _values.push_back(_columns.data() + i * count);
+        }
+        else
+        {
+            _values.push_back(column.data());
+        }
+    }
+    evaluate(count);
+
+    _result.resize_column(count);
+    std::copy_n(_values.back(), count, _result.column());
+}
+
+void fused_math_node::evaluate(std::size_t count)
+{
+    std::size_t const input_count = _operand_inputs.size();
+    for(std::size_t i = 0; i < _operations.size(); i++)
+    {
+        auto const& step = _operations[i];
+        float* result = _columns.data() + (input_count + i) * count;
+        apply(step.type, count, result, _values[step.operands[0]], _values[step.operands[1]]);
+        _values.push_back(result);
+    }
+}
+
+auto fuse_elementwise_math(clk::graph& graph) -> std::size_t
+{
+    return fusion_pass(graph).run();
+}
+
+} // namespace clk::algorithms
@@ -1,6 +1,7 @@
 #include "clk/algorithms/init.hpp"
 #include "clk/algorithms/boolean.hpp"
 #include "clk/algorithms/color.hpp"
+#include "clk/algorithms/color_buffer.hpp"
 #include "clk/algorithms/math.hpp"
 #include "clk/algorithms/text.hpp"
 #include "clk/base/algorithm.hpp"
@@ -58,6 +59,15 @@ void init()
     clk::algorithm::register_factory<tonemap_reinhard>();
     clk::algorithm::register_factory<tonemap_filmic_aces>();
 
+    clk::algorithm::register_factory<fill_color_buffer>();
+    clk::algorithm::register_factory<sample_color_buffer>();
+    clk::algorithm::register_factory<grayscale_buffer>();
+    clk::algorithm::register_factory<mix_color_buffers>();
+    clk::algorithm::register_factory<apply_gamma_buffer>();
+    clk::algorithm::register_factory<remove_gamma_buffer>();
+    clk::algorithm::register_factory<tonemap_reinhard_buffer>();
+    clk::algorithm::register_factory<tonemap_filmic_aces_buffer>();
+
     clk::algorithm::register_factory<boolean_not>();
     clk::algorithm::register_factory<boolean_and>();
     clk::algorithm::register_factory<boolean_nand>();
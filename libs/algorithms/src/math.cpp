@@ -1,7 +1,9 @@
 #include "clk/algorithms/math.hpp"
+#include "transform_columns.hpp"
 
 #include <chrono>
 #include <cmath>
+#include <functional>
 #include <random>
 #include <stdexcept>
 #include <utility>
@@ -64,6 +66,11 @@ void add_integers::update()
     *_result = *_number_a + *_number_b;
 }
 
+void add_integers::update_batch(std::size_t count)
+{
+    transform_columns(count, _result, std::plus<>(), _number_a, _number_b);
+}
+
 subtract_integers::subtract_integers()
 {
     register_port(_number_a);
@@ -76,6 +83,11 @@ void subtract_integers::update()
     *_result = *_number_a - *_number_b;
 }
 
+void subtract_integers::update_batch(std::size_t count)
+{
+    transform_columns(count, _result, std::minus<>(), _number_a, _number_b);
+}
+
 multiply_integers::multiply_integers()
 {
     register_port(_number_a);
@@ -88,6 +100,11 @@ void multiply_integers::update()
     *_result = *_number_a * *_number_b;
 }
 
+void multiply_integers::update_batch(std::size_t count)
+{
+    transform_columns(count, _result, std::multiplies<>(), _number_a, _number_b);
+}
+
 divide_integers::divide_integers()
 {
     register_port(_number_a);
@@ -134,6 +151,11 @@ void add_floats::update()
     *_result = *_number_a + *_number_b;
 }
 
+void add_floats::update_batch(std::size_t count)
+{
+    transform_columns(count, _result, std::plus<>(), _number_a, _number_b);
+}
+
 subtract_floats::subtract_floats()
 {
     register_port(_number_a);
@@ -146,6 +168,11 @@ void subtract_floats::update()
     *_result = *_number_a - *_number_b;
 }
 
+void subtract_floats::update_batch(std::size_t count)
+{
+    transform_columns(count, _result, std::minus<>(), _number_a, _number_b);
+}
+
 multiply_floats::multiply_floats()
 {
     register_port(_number_a);
@@ -158,6 +185,11 @@ void multiply_floats::update()
     *_result = *_number_a * *_number_b;
 }
 
+void multiply_floats::update_batch(std::size_t count)
+{
+    transform_columns(count, _result, std::multiplies<>(), _number_a, _number_b);
+}
+
 divide_floats::divide_floats()
 {
     register_port(_number_a);
@@ -189,6 +221,16 @@ void pow::update()
     *_result = std::pow(*_number, *_exponent);
 }
 
+void pow::update_batch(std::size_t count)
+{
+    transform_columns(
+        count, _result,
+        [](float number, float exponent) {
+            return std::pow(number, exponent);
+        },
+        _number, _exponent);
+}
+
 nth_root::nth_root()
 {
     register_port(_number);
@@ -224,6 +266,16 @@ void rad_to_deg::update()
     *_degrees = *_radians * 180.0f / 3.14159265f;
 }
 
+void rad_to_deg::update_batch(std::size_t count)
+{
+    transform_columns(
+        count, _degrees,
+        [](float radians) {
+            return radians * 180.0f / 3.14159265f;
+        },
+        _radians);
+}
+
 deg_to_rad::deg_to_rad()
 {
     register_port(_degrees);
@@ -235,6 +287,16 @@ void deg_to_rad::update()
     *_radians = *_degrees * 3.14159265f / 180.0f;
 }
 
+void deg_to_rad::update_batch(std::size_t count)
+{
+    transform_columns(
+        count, _radians,
+        [](float degrees) {
+            return degrees * 3.14159265f / 180.0f;
+        },
+        _degrees);
+}
+
 sin::sin()
 {
     register_port(_angle);
@@ -246,6 +308,16 @@ void sin::update()
     *_sin = std::sin(*_angle);
 }
 
+void sin::update_batch(std::size_t count)
+{
+    transform_columns(
+        count, _sin,
+        [](float angle) {
+            return std::sin(angle);
+        },
+        _angle);
+}
+
 cos::cos()
 {
     register_port(_angle);
@@ -257,6 +329,16 @@ void cos::update()
     *_cos = std::cos(*_angle);
 }
 
+void cos::update_batch(std::size_t count)
+{
+    transform_columns(
+        count, _cos,
+        [](float angle) {
+            return std::cos(angle);
+        },
+        _angle);
+}
+
 is_even::is_even()
 {
     register_port(_number);
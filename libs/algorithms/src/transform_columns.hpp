@@ -0,0 +1,38 @@
+#pragma once
+
+#include "clk/base/input.hpp"
+#include "clk/base/output.hpp"
+
+#include <cstddef>
+
+namespace clk::algorithms
+{
+// Batch evaluation helper, resizes the result's column to count elements and fills it with function applied to the
+// corresponding elements of the inputs. Loops over contiguous inputs are kept free of strides, so they can be
+// vectorized.
+template <typename Result, typename Function, typename... Inputs>
+void transform_columns(
+    std::size_t count, clk::output_of<Result>& result, Function function, clk::input_of<Inputs> const&... inputs)
+{
+    result.resize_column(count);
+    Result* result_column = result.column();
+
+    if((!inputs.column().is_broadcast() && ...))
+    {
+        auto loop = [&](Inputs const*... input_columns) {
+            for(std::size_t i = 0; i < count; i++)
+                result_column[i] = function(input_columns[i]...);
+        };
+        loop(inputs.column().data()...);
+    }
+    else
+    {
+        auto loop = [&](clk::column_view<Inputs> const&... input_columns) {
+            for(std::size_t i = 0; i < count; i++)
+                result_column[i] = function(input_columns[i]...);
+        };
+        loop(inputs.column()...);
+    }
+}
+
+} // namespace clk::algorithms
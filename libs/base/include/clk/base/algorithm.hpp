@@ -1,11 +1,13 @@
 #pragma once
 
+#include <cstddef>
 #include <functional>
 #include <map>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace clk
@@ -13,6 +15,20 @@ namespace clk
 class input;
 class output;
 
+namespace impl
+{
+template <typename AlgorithmImplementation, typename = void>
+struct is_pure_algorithm : std::false_type
+{
+};
+
+template <typename AlgorithmImplementation>
+struct is_pure_algorithm<AlgorithmImplementation, std::void_t<decltype(AlgorithmImplementation::pure)>>
+    : std::bool_constant<AlgorithmImplementation::pure>
+{
+};
+} // namespace impl
+
 class algorithm
 {
 public:
@@ -37,7 +53,11 @@ public:
     virtual ~algorithm() = default;
 
     virtual auto name() const noexcept -> std::string_view = 0;
+    // the outputs of pure algorithms only depend on the values of their inputs, so their results can be reused
+    virtual auto is_pure() const noexcept -> bool;
     virtual void update() = 0;
+    // processes the columns of the inputs element by element, unless overridden with a vectorized implementation
+    virtual void update_batch(std::size_t count);
     auto inputs() const noexcept -> std::vector<clk::input*> const&;
     auto outputs() const noexcept -> std::vector<clk::output*> const&;
 
@@ -62,6 +82,12 @@ public:
     {
         return AlgorithmImplementation::name;
     }
+
+    // declared with a static constexpr bool pure = true member
+    auto is_pure() const noexcept -> bool final
+    {
+        return impl::is_pure_algorithm<AlgorithmImplementation>::value;
+    }
 };
 
 } // namespace clk
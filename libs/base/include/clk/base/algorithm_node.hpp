@@ -1,8 +1,10 @@
 #pragma once
 
 #include "clk/base/algorithm.hpp"
+#include "clk/base/memo_cache.hpp"
 #include "clk/base/node.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <string_view>
 
@@ -25,12 +27,16 @@ public:
 
     auto name() const -> std::string_view final;
     void set_algorithm(std::unique_ptr<clk::algorithm>&& algorithm);
+    // nullptr unless the algorithm is pure
+    auto memo_cache() const -> clk::memo_cache*;
 
 private:
     std::unique_ptr<clk::algorithm> _algorithm;
+    std::unique_ptr<clk::memo_cache> _memo_cache;
 
     auto update_possible() const -> bool override;
     void update() override;
+    void process_batch(std::size_t count) override;
 };
 
 } // namespace clk
@@ -19,15 +19,20 @@ public:
 
     void set_data(void const* data_pointer, std::size_t data_type_hash);
     void clear_data();
+    void set_column(void const* column_pointer, std::size_t column_size);
 
     auto data_type_hash() const noexcept -> std::size_t final;
     auto data_pointer() const noexcept -> void const* final;
     auto data_pointer() noexcept -> void* final;
+    auto column_pointer() const noexcept -> void const* final;
+    auto column_size() const noexcept -> std::size_t final;
 
     auto create_compatible_port() const -> std::unique_ptr<port> final;
 
 private:
     void const* _data_pointer = nullptr;
     std::size_t _data_type_hash = 0;
+    void const* _column_pointer = nullptr;
+    std::size_t _column_size = 0;
 };
 } // namespace clk
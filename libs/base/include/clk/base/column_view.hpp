@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+
+namespace clk
+{
+// A read only view of the values an input sees during a batch evaluation. Inputs that are not connected to a column
+// broadcast their single value to every element, which is expressed through a stride of zero.
+template <typename T>
+class column_view final
+{
+public:
+    column_view() = default;
+    column_view(T const* data, std::size_t stride) noexcept : _data(data), _stride(stride)
+    {
+    }
+    column_view(column_view const&) = default;
+    column_view(column_view&&) noexcept = default;
+    auto operator=(column_view const&) -> column_view& = default;
+    auto operator=(column_view&&) noexcept -> column_view& = default;
+    ~column_view() = default;
+
+    auto operator[](std::size_t index) const noexcept -> T const&
+    {
+        return _data[index * _stride];
+    }
+
+    auto data() const noexcept -> T const*
+    {
+        return _data;
+    }
+
+    auto stride() const noexcept -> std::size_t
+    {
+        return _stride;
+    }
+
+    auto is_broadcast() const noexcept -> bool
+    {
+        return _stride == 0;
+    }
+
+private:
+    T const* _data = nullptr;
+    std::size_t _stride = 0;
+};
+
+} // namespace clk
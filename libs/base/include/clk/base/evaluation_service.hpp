@@ -0,0 +1,120 @@
+#pragma once
+
+#include "clk/util/timestamp.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace clk
+{
+class graph;
+class node;
+class output;
+class port;
+
+// Runs the pulls and pushes of a graph on a worker thread, so a slow algorithm does not block the thread that asked
+// for the evaluation. The worker holds the lock of the service while it evaluates, everyone else may only read or
+// modify the graph while holding it as well. Before and after every evaluation the data of the outputs, the errors of
+// the nodes and the faulty ports are published as a snapshot, which can be read while the worker is busy.
+class evaluation_service final
+{
+public:
+    class snapshot final
+    {
+    public:
+        // the data of an output, or of the output an input reads from, nullptr if it could not be copied
+        auto data_pointer(clk::port const& port) const -> void const*;
+        auto error(clk::node const& node) const -> std::string const&;
+        auto is_faulty(clk::port const& port) const -> bool;
+
+    private:
+        friend class evaluation_service;
+
+        struct copied_output
+        {
+            clk::timestamp timestamp;
+            std::size_t data_type_hash = 0;
+            std::shared_ptr<clk::output const> copy;
+        };
+
+        std::unordered_map<clk::output const*, copied_output> _outputs;
+        std::unordered_map<clk::node const*, std::string> _errors;
+        std::unordered_set<clk::port const*> _faulty_ports;
+    };
+
+    evaluation_service() = delete;
+    explicit evaluation_service(clk::graph const& graph);
+    evaluation_service(evaluation_service const&) = delete;
+    evaluation_service(evaluation_service&&) = delete;
+    auto operator=(evaluation_service const&) -> evaluation_service& = delete;
+    auto operator=(evaluation_service&&) -> evaluation_service& = delete;
+    // waits for the running evaluation, the queued ones are dropped
+    ~evaluation_service();
+
+    // equal requests are merged while they wait in the queue
+    void queue_pull(clk::node& node);
+    void queue_push(clk::node& node);
+    void queue_push(clk::port& port);
+    // drops the queued requests of a node and its ports, has to be called before removing the node from the graph
+    void cancel(clk::node const& node);
+    void cancel(clk::port const& port);
+    // whether requests are queued or running
+    auto is_busy() const -> bool;
+    // whether a pull or push of the node itself is queued or running
+    auto is_evaluating(clk::node const& node) const -> bool;
+    auto queued_request_count() const -> std::size_t;
+    // blocks until every queued request has been evaluated
+    void wait() const;
+
+    auto lock() -> std::unique_lock<std::mutex>;
+    // the returned lock does not own the mutex if the worker is evaluating
+    auto try_lock() -> std::unique_lock<std::mutex>;
+    auto published_snapshot() const -> std::shared_ptr<snapshot const>;
+    // called on the worker thread whenever a snapshot was published
+    void set_published_callback(std::function<void()> callback);
+
+private:
+    struct request
+    {
+        enum class kind
+        {
+            pull_node,
+            push_node,
+            push_port
+        };
+
+        kind type = kind::pull_node;
+        clk::node* node = nullptr;
+        clk::port* port = nullptr;
+
+        auto operator==(request const& other) const -> bool;
+    };
+
+    clk::graph const& _graph;
+    std::mutex _graph_mutex;
+    mutable std::mutex _queue_mutex;
+    mutable std::condition_variable _queue_changed;
+    std::deque<request> _queue;
+    std::optional<request> _running_request;
+    std::function<void()> _published_callback;
+    bool _stopping = false;
+    mutable std::mutex _snapshot_mutex;
+    std::shared_ptr<snapshot const> _snapshot;
+    std::thread _worker;
+
+    void queue(request new_request);
+    void work();
+    void evaluate(request const& current) const;
+    void publish_snapshot();
+};
+
+} // namespace clk
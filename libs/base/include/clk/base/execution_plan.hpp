@@ -0,0 +1,62 @@
+#pragma once
+
+#include "clk/util/timestamp.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace clk
+{
+class graph;
+class node;
+
+// A flat, topologically sorted view of a graph. Nodes that take part in (or depend on) a cycle cannot be ordered,
+// they are appended after all the other nodes and depend on each other in the order they appear in the graph.
+// Running the plan only visits the dirty frontier: the nodes whose sources were modified since the last run, the nodes
+// whose outputs were written since the last run, and the nodes reading outputs that changed during the run.
+// The frontier is not synchronised, mark_modified and run have to be called from the thread that modifies the graph.
+class execution_plan final
+{
+public:
+    execution_plan() = default;
+    explicit execution_plan(clk::graph const& graph);
+    execution_plan(execution_plan const&) = default;
+    execution_plan(execution_plan&&) = default;
+    auto operator=(execution_plan const&) -> execution_plan& = default;
+    auto operator=(execution_plan&&) -> execution_plan& = default;
+    ~execution_plan() = default;
+
+    auto is_outdated(clk::graph const& graph) const -> bool;
+    auto nodes() const -> std::vector<clk::node*> const&;
+    auto dependencies(std::size_t node_index) const -> std::vector<std::size_t> const&;
+    auto dependents(std::size_t node_index) const -> std::vector<std::size_t> const&;
+    // adds the node to the dirty frontier, called by the graph when the default port of one of its inputs changes
+    void mark_modified(clk::node const& node);
+    void run() const;
+    void run_batch(std::size_t count) const;
+
+private:
+    clk::timestamp _timestamp;
+    std::vector<clk::node*> _nodes;
+    std::vector<std::vector<std::size_t>> _dependencies;
+    std::vector<std::vector<std::size_t>> _dependents;
+    // the edges dropped inside of cycles, the nodes they lead to are visited in the next run
+    std::vector<std::vector<std::size_t>> _back_edges;
+    std::unordered_map<clk::node const*, std::size_t> _positions;
+    // nodes without inputs or outputs always need an update, nodes reading outputs from outside of the graph have
+    // sources the plan can not watch
+    std::vector<std::size_t> _unwatched_nodes;
+
+    // the dirty frontier is run state, running the plan does not change the order it describes
+    mutable std::vector<bool> _dirty;
+    mutable std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<>> _frontier;
+    mutable std::vector<std::size_t> _next_run;
+    mutable clk::timestamp _last_run;
+
+    void mark_dirty(std::size_t node_index) const;
+};
+
+} // namespace clk
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace clk
+{
+class execution_plan;
+
+// Runs execution plans on a pool of worker threads. Every thread owns a queue of ready nodes, finishing a node
+// pushes its newly ready dependents onto the finishing thread's queue, and idle threads steal from the others.
+// With a single thread, plans are run in order on the calling thread.
+class executor final
+{
+public:
+    executor();
+    explicit executor(std::size_t thread_count);
+    executor(executor const&) = delete;
+    executor(executor&&) = delete;
+    auto operator=(executor const&) -> executor& = delete;
+    auto operator=(executor&&) -> executor& = delete;
+    ~executor();
+
+    auto thread_count() const -> std::size_t;
+    void run(clk::execution_plan const& plan);
+    void run_batch(clk::execution_plan const& plan, std::size_t count);
+
+private:
+    struct task_queue
+    {
+        std::mutex mutex;
+        std::deque<std::size_t> tasks;
+    };
+
+    std::vector<std::thread> _workers;
+    std::vector<std::unique_ptr<task_queue>> _queues;
+    std::mutex _mutex;
+    std::condition_variable _run_started;
+    std::condition_variable _run_finished;
+    std::size_t _run_count = 0;
+    std::size_t _active_workers = 0;
+    bool _stopping = false;
+    clk::execution_plan const* _plan = nullptr;
+    std::optional<std::size_t> _batch_size;
+    std::unique_ptr<std::atomic<std::size_t>[]> _pending_dependencies;
+    std::size_t _pending_dependencies_size = 0;
+    std::atomic<std::size_t> _remaining_nodes = 0;
+
+    void start(clk::execution_plan const& plan, std::optional<std::size_t> batch_size);
+    void work_loop(std::size_t queue_index);
+    void work(std::size_t queue_index);
+    auto take_task(std::size_t queue_index) -> std::optional<std::size_t>;
+    void execute(std::size_t queue_index, std::size_t node_index);
+};
+
+} // namespace clk
@@ -1,13 +1,29 @@
 #pragma once
 
+#include "clk/base/execution_plan.hpp"
 #include "clk/base/node.hpp"
 #include "clk/util/timestamp.hpp"
 
+#include <chrono>
+#include <cstddef>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace clk
 {
+class output;
+class port;
+
+struct node_statistics
+{
+    clk::node const* node = nullptr;
+    std::size_t update_count = 0;
+    std::size_t skipped_update_count = 0;
+    std::chrono::nanoseconds average_update = std::chrono::nanoseconds(0);
+    std::chrono::nanoseconds longest_update = std::chrono::nanoseconds(0);
+};
+
 class graph final
 {
 public:
@@ -16,16 +32,43 @@ public:
     graph(graph&&) = default;
     auto operator=(graph const&) -> graph& = delete;
     auto operator=(graph&&) -> graph& = default;
-    ~graph() = default;
+    ~graph();
 
     void add_node(std::unique_ptr<clk::node>&& node);
     void remove_node(clk::node* node);
     auto nodes() const -> std::vector<std::unique_ptr<clk::node>> const&;
     auto timestamp() const -> clk::timestamp;
+    auto last_modification_time() const -> std::chrono::steady_clock::time_point;
+    auto compile() -> clk::execution_plan const&;
+    // applies to the nodes added later as well
+    void set_profiling(bool active);
+    auto is_profiling() const -> bool;
+    // sorted by the average duration of an update, most expensive nodes first
+    auto statistics() const -> std::vector<clk::node_statistics>;
+    // outputs are observed while something reads their data, e.g. a viewer, every observe needs its own unobserve
+    void observe(clk::output const& output);
+    void unobserve(clk::output const& output);
+    auto is_observed(clk::output const& output) const -> bool;
+    // pushes only update the nodes that observed outputs depend on, the other nodes are marked as outdated and
+    // updated when they are pulled, so a newly observed output needs a pull if its node is outdated
+    void set_demand_driven(bool active);
+    auto is_demand_driven() const -> bool;
 
 private:
+    bool _profiling = false;
+    bool _demand_driven = false;
     clk::timestamp _timestamp;
+    std::chrono::steady_clock::time_point _last_modification_time = std::chrono::steady_clock::now();
+    clk::execution_plan _execution_plan;
     std::vector<std::unique_ptr<clk::node>> _nodes;
+    std::unordered_map<clk::output const*, std::size_t> _observer_counts;
+
+    // ports registered after the node was added are watched as well
+    void watch_port(clk::node& node, clk::port& port);
+    void modified();
+    // marks the nodes that observed outputs depend on as demanded, and the outdated ones as modified
+    void update_demand();
+    void demand_observed_dependencies();
 };
 
 } // namespace clk
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "clk/base/column_view.hpp"
 #include "clk/base/output.hpp"
 #include "clk/base/port.hpp"
 #include "clk/util/timestamp.hpp"
@@ -15,7 +16,6 @@
 namespace clk
 {
 class output;
-class sentinel;
 
 class input : public port
 {
@@ -45,16 +45,22 @@ public:
 
     auto connected_output() const -> output*;
 
-    void push(std::weak_ptr<clk::sentinel> const& sentinel = {}) noexcept final;
-    void pull(std::weak_ptr<clk::sentinel> const& sentinel = {}) noexcept final;
-    void set_push_callback(std::function<void(std::weak_ptr<clk::sentinel> const&)> callback) noexcept;
+    void push(clk::sentinel sentinel = {}) noexcept final;
+    void pull(clk::sentinel sentinel = {}) noexcept final;
+    void set_push_callback(std::function<void(clk::sentinel)> callback) noexcept;
 
     virtual auto default_port() const -> output& = 0;
 
+    auto column_pointer() const noexcept -> void const*;
+    auto column_size() const noexcept -> std::size_t;
+    // while bound, reading the input yields the element at the given index of its column (if it has one)
+    virtual void bind_column_element(std::size_t index) noexcept;
+    virtual void unbind_column_element() noexcept;
+
 private:
     output* _connection = nullptr;
     std::vector<port*> _cached_connected_ports = {};
-    std::function<void(std::weak_ptr<clk::sentinel> const&)> _push_callback;
+    std::function<void(clk::sentinel)> _push_callback;
 };
 
 template <typename T>
@@ -87,9 +93,13 @@ public:
 
     auto data() const noexcept -> T const&
     {
-        if(connected_output() == nullptr)
+        if(_bound_element != nullptr)
+        {
+            return *_bound_element;
+        }
+        else if(connected_output() == nullptr)
         {
-            return _default_port.data();
+            return std::as_const(_default_port).data();
         }
         else
         {
@@ -105,9 +115,13 @@ public:
 
     auto operator->() const noexcept -> T const*
     {
-        if(connected_output() == nullptr)
+        if(_bound_element != nullptr)
         {
-            return _default_port.operator->();
+            return _bound_element;
+        }
+        else if(connected_output() == nullptr)
+        {
+            return std::as_const(_default_port).operator->();
         }
         else
         {
@@ -122,6 +136,25 @@ public:
         return hash;
     }
 
+    auto column() const noexcept -> clk::column_view<T>
+    {
+        if(auto const* column = static_cast<T const*>(column_pointer()); column != nullptr)
+            return {column, 1};
+        return {&data(), 0};
+    }
+
+    void bind_column_element(std::size_t index) noexcept final
+    {
+        _bound_element = nullptr;
+        if(auto const* column = static_cast<T const*>(column_pointer()); column != nullptr)
+            _bound_element = column + index;
+    }
+
+    void unbind_column_element() noexcept final
+    {
+        _bound_element = nullptr;
+    }
+
     auto default_port() const -> output_of<T>& final
     {
         return _default_port;
@@ -137,6 +170,7 @@ public:
 
 private:
     output_of<T> mutable _default_port = output_of<T>("Default port");
+    T const* _bound_element = nullptr;
 };
 
 } // namespace clk
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <any>
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace clk
+{
+class input;
+class output;
+
+// Remembers the outputs of a pure update for the values of its inputs. Once the cached data exceeds the memory budget,
+// the least recently used entries are dropped. Updates with inputs that can not be hashed, compared or copied are
+// never cached, neither are inputs that do not equal themselves, like NaN.
+class memo_cache final
+{
+public:
+    static constexpr std::size_t default_memory_budget = 1024 * 1024;
+
+    explicit memo_cache(std::size_t memory_budget = default_memory_budget);
+    memo_cache(memo_cache const&) = delete;
+    memo_cache(memo_cache&&) = delete;
+    auto operator=(memo_cache const&) -> memo_cache& = delete;
+    auto operator=(memo_cache&&) -> memo_cache& = delete;
+    ~memo_cache();
+
+    // assigns the cached outputs for the current values of the inputs, false if there are none
+    auto restore(std::vector<clk::input*> const& inputs, std::vector<clk::output*> const& outputs) -> bool;
+    void store(std::vector<clk::input*> const& inputs, std::vector<clk::output*> const& outputs);
+    void clear();
+
+    void set_memory_budget(std::size_t memory_budget);
+    auto memory_budget() const noexcept -> std::size_t;
+    // estimated from the sizes of the data types, the elements of containers and the entries holding them
+    auto memory_usage() const noexcept -> std::size_t;
+    auto size() const noexcept -> std::size_t;
+    auto hit_count() const noexcept -> std::size_t;
+    auto miss_count() const noexcept -> std::size_t;
+    void reset_counters() noexcept;
+
+private:
+    struct entry
+    {
+        std::size_t key = 0;
+        std::vector<std::any> inputs;
+        std::vector<std::any> outputs;
+        std::size_t size = 0;
+    };
+
+    std::size_t _memory_budget = default_memory_budget;
+    std::size_t _memory_usage = 0;
+    std::size_t _hit_count = 0;
+    std::size_t _miss_count = 0;
+    // the most recently used entry comes first
+    std::list<entry> _entries;
+    std::unordered_multimap<std::size_t, std::list<entry>::iterator> _index;
+
+    auto find(std::size_t key, std::vector<clk::input*> const& inputs) -> std::list<entry>::iterator;
+    void evict_to(std::size_t memory_budget);
+};
+
+} // namespace clk
@@ -1,5 +1,11 @@
 #pragma once
 
+#include "clk/base/sentinel.hpp"
+#include "clk/util/profiler.hpp"
+#include "clk/util/timestamp.hpp"
+
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -7,7 +13,6 @@
 
 namespace clk
 {
-class sentinel;
 class port;
 class input;
 class output;
@@ -26,11 +31,24 @@ public:
     auto all_ports() const -> std::vector<clk::port*> const&;
     auto inputs() const -> std::vector<clk::input*> const&;
     auto outputs() const -> std::vector<clk::output*> const&;
-    void pull(std::weak_ptr<clk::sentinel> const& sentinel = {});
-    void push(std::weak_ptr<clk::sentinel> const& sentinel = {});
+    void pull(clk::sentinel sentinel = {});
+    void push(clk::sentinel sentinel = {});
+    void update_if_needed();
+    void update_batch(std::size_t count);
     auto has_inputs() const -> bool;
     auto has_outputs() const -> bool;
     auto error() const -> std::string const&;
+    // the profiler is created the first time profiling is activated and records the duration of every update
+    void set_profiling(bool active);
+    auto is_profiling() const -> bool;
+    auto profiler() const -> clk::profiler const*;
+    auto update_count() const -> std::size_t;
+    auto skipped_update_count() const -> std::size_t;
+    void reset_update_counts();
+    // false while the graph is demand driven and none of its observed outputs depend on this node
+    auto is_demanded() const -> bool;
+    // a push reached the node while it was not demanded, the next pull updates it
+    auto is_outdated() const -> bool;
 
 protected:
     void clear_error();
@@ -41,19 +59,51 @@ protected:
     void unregister_port(clk::output* output);
     virtual auto update_possible() const -> bool;
     virtual void update();
+    virtual void process_batch(std::size_t count);
 
 private:
+    friend class graph;
+
+    class evaluation final
+    {
+    public:
+        explicit evaluation(clk::sentinel sentinel) noexcept;
+        evaluation(evaluation const&) = delete;
+        evaluation(evaluation&&) = delete;
+        auto operator=(evaluation const&) -> evaluation& = delete;
+        auto operator=(evaluation&&) -> evaluation& = delete;
+        ~evaluation();
+
+        auto sentinel() const noexcept -> clk::sentinel;
+        auto is_origin() const noexcept -> bool;
+
+    private:
+        clk::sentinel _sentinel;
+        bool _origin = false;
+        bool _owns_running_evaluation = false;
+    };
+
     std::string _last_error_message;
     std::vector<clk::port*> _ports;
     std::vector<clk::input*> _inputs;
     std::vector<clk::output*> _outputs;
-    std::weak_ptr<clk::sentinel> _sentinel;
+    clk::sentinel _sentinel;
+    clk::timestamp _last_update_timestamp;
+    std::unique_ptr<clk::profiler> _profiler;
+    // set by the graph that owns the node, called after a port was registered or unregistered
+    std::function<void(clk::port&)> _port_registered_callback;
+    std::function<void(clk::port&)> _port_unregistered_callback;
+    std::size_t _update_count = 0;
+    std::size_t _skipped_update_count = 0;
+    bool _demanded = true;
+    bool _outdated = false;
 
-    void pull_inputs(std::weak_ptr<clk::sentinel> const& sentinel);
-    void push_outputs(std::weak_ptr<clk::sentinel> const& sentinel);
-    auto sentinel_present() const -> bool;
+    void pull_inputs(clk::sentinel sentinel);
+    void push_outputs(clk::sentinel sentinel);
     auto update_needed() const -> bool;
     void try_update();
+    template <typename Function>
+    void invoke_update(Function&& function);
 };
 
 } // namespace clk
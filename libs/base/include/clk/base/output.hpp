@@ -3,18 +3,60 @@
 #include "clk/base/port.hpp"
 #include "clk/util/predicates.hpp"
 
+#include <any>
+#include <cassert>
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string_view>
+#include <type_traits>
 #include <typeindex>
 #include <unordered_set>
+#include <utility>
 #include <variant>
 
 namespace clk
 {
 class input;
-class sentinel;
+
+namespace impl
+{
+template <typename T, typename = void>
+struct is_equality_comparable : std::false_type
+{
+};
+
+template <typename T>
+struct is_equality_comparable<T, std::void_t<decltype(std::declval<T const&>() == std::declval<T const&>())>>
+    : std::true_type
+{
+};
+
+template <typename T>
+struct is_hashable : std::is_default_constructible<std::hash<T>>
+{
+};
+
+// the elements of containers are counted as well, whatever they allocate themselves is not
+template <typename T, typename = void>
+struct data_size
+{
+    static auto of(T const& /*data*/) -> std::size_t
+    {
+        return sizeof(T);
+    }
+};
+
+template <typename T>
+struct data_size<T, std::void_t<typename T::value_type, decltype(std::declval<T const&>().size())>>
+{
+    static auto of(T const& data) -> std::size_t
+    {
+        return sizeof(T) + data.size() * sizeof(typename T::value_type);
+    }
+};
+} // namespace impl
 
 class output : public port
 {
@@ -29,6 +71,32 @@ public:
     using port::data_pointer;
     virtual auto data_pointer() noexcept -> void* = 0;
 
+    // batch evaluation, outputs without a column broadcast their single value
+    virtual auto column_pointer() const noexcept -> void const*;
+    virtual auto column_size() const noexcept -> std::size_t;
+    virtual void resize_column(std::size_t size);
+    virtual void store_column_element(std::size_t index) noexcept;
+    // an unconnected output holding a copy of the data, nullptr if the data can not be copied
+    virtual auto create_copy() const -> std::unique_ptr<output>;
+    // a copy of the data without an output around it, empty if the data can not be copied
+    virtual auto copy_data() const -> std::any;
+    // assigns a copy of data of the same type, false if the data can not be copied
+    virtual auto assign_data(std::any const& data) -> bool;
+    // false if the data can not be compared
+    virtual auto data_equals(std::any const& data) const -> bool;
+    // nullopt if the data can not be hashed
+    virtual auto data_hash() const -> std::optional<std::size_t>;
+    // an estimate of the memory the data occupies
+    virtual auto data_size() const -> std::size_t;
+
+    // With early cutoff, an update that leaves the data equal to what it was keeps the previous timestamp, so the
+    // nodes behind the output see no change and skip their updates. Only has an effect for comparable data.
+    void set_early_cutoff(bool early_cutoff) noexcept;
+    auto has_early_cutoff() const noexcept -> bool;
+    // called by the node that owns the output around each of its updates
+    virtual void begin_update();
+    virtual void end_update();
+
     auto can_connect_to(port const& other_port) const noexcept -> bool final;
 
     void connect_to(output& other_port) = delete;
@@ -43,12 +111,13 @@ public:
     auto connected_ports() const -> std::vector<port*> const& final;
     auto connected_inputs() const -> std::vector<input*> const&;
 
-    void set_pull_callback(std::function<void(std::weak_ptr<clk::sentinel> const&)> callback) noexcept;
-    void push(std::weak_ptr<clk::sentinel> const& sentinel = {}) noexcept final;
-    void pull(std::weak_ptr<clk::sentinel> const& sentinel = {}) noexcept final;
+    void set_pull_callback(std::function<void(clk::sentinel)> callback) noexcept;
+    void push(clk::sentinel sentinel = {}) noexcept final;
+    void pull(clk::sentinel sentinel = {}) noexcept final;
 
 private:
-    std::function<void(std::weak_ptr<sentinel> const&)> _pull_callback;
+    bool _early_cutoff = false;
+    std::function<void(clk::sentinel)> _pull_callback;
     std::unordered_set<input*> _connections;
     std::vector<input*> _cached_connected_inputs;
     std::vector<port*> _cached_connected_ports;
@@ -85,6 +154,92 @@ public:
         return port;
     }
 
+    auto create_copy() const -> std::unique_ptr<output> final
+    {
+        if constexpr(std::is_copy_assignable_v<T>)
+        {
+            auto copy = std::make_unique<output_of<T>>(name());
+            copy->_data = _data;
+            return copy;
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+
+    auto copy_data() const -> std::any final
+    {
+        if constexpr(std::is_copy_constructible_v<T>)
+            return _data;
+        else
+            return {};
+    }
+
+    auto assign_data(std::any const& data) -> bool final
+    {
+        if constexpr(std::is_copy_assignable_v<T>)
+        {
+            if(auto const* value = std::any_cast<T>(&data); value != nullptr)
+            {
+                this->data() = *value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    auto data_equals(std::any const& data) const -> bool final
+    {
+        if constexpr(impl::is_equality_comparable<T>::value)
+        {
+            auto const* value = std::any_cast<T>(&data);
+            return value != nullptr && _data == *value;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    auto data_hash() const -> std::optional<std::size_t> final
+    {
+        if constexpr(impl::is_hashable<T>::value)
+            return std::hash<T>{}(_data);
+        else
+            return std::nullopt;
+    }
+
+    auto data_size() const -> std::size_t final
+    {
+        return impl::data_size<T>::of(_data);
+    }
+
+    void begin_update() final
+    {
+        if constexpr(supports_early_cutoff)
+        {
+            if(has_early_cutoff())
+                _before_update = snapshot{_data, timestamp()};
+        }
+    }
+
+    void end_update() final
+    {
+        if constexpr(supports_early_cutoff)
+        {
+            if(_before_update.has_value())
+            {
+                if(!_before_update->timestamp.is_reset() && timestamp() != _before_update->timestamp &&
+                    _data == _before_update->data)
+                {
+                    set_timestamp(_before_update->timestamp);
+                }
+                _before_update.reset();
+            }
+        }
+    }
+
     auto data_pointer() const noexcept -> void const* final
     {
         return &_data;
@@ -128,8 +283,61 @@ public:
         return &_data;
     }
 
+    auto column() noexcept -> T*
+    {
+        update_timestamp();
+        return _column.get();
+    }
+
+    auto column() const noexcept -> T const*
+    {
+        return _column.get();
+    }
+
+    auto column_pointer() const noexcept -> void const* final
+    {
+        return _column_size == 0 ? nullptr : _column.get();
+    }
+
+    auto column_size() const noexcept -> std::size_t final
+    {
+        return _column_size;
+    }
+
+    void resize_column(std::size_t size) final
+    {
+        if(size > _column_capacity)
+        {
+            _column = std::make_unique<T[]>(size);
+            _column_capacity = size;
+        }
+        _column_size = size;
+        update_timestamp();
+    }
+
+    void store_column_element(std::size_t index) noexcept final
+    {
+        assert(index < _column_size);
+        if constexpr(std::is_copy_assignable_v<T>)
+            _column[index] = _data;
+    }
+
 private:
+    static constexpr bool supports_early_cutoff =
+        std::is_copy_constructible_v<T> && impl::is_equality_comparable<T>::value;
+
+    struct snapshot
+    {
+        T data;
+        clk::timestamp timestamp;
+    };
+
     T _data = {};
+    // only holds a copy of the data during an update with early cutoff
+    std::conditional_t<supports_early_cutoff, std::optional<snapshot>, std::monostate> _before_update;
+    std::unique_ptr<T[]> _column;
+    std::size_t _column_size = 0;
+    std::size_t _column_capacity = 0;
 };
 
 } // namespace clk
@@ -24,5 +24,6 @@ private:
     any_output _out{"Out"};
 
     void update() override;
+    void process_batch(std::size_t count) override;
 };
 } // namespace clk
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "clk/base/graph.hpp"
+#include "clk/base/sentinel.hpp"
 #include "clk/util/timestamp.hpp"
 
 #include <cstddef>
@@ -12,7 +13,6 @@
 
 namespace clk
 {
-class sentinel;
 
 class port
 {
@@ -45,13 +45,14 @@ public:
     auto is_connected() const noexcept -> bool;
     auto is_connected_to(port const& other_port) const noexcept -> bool;
 
-    virtual void push(std::weak_ptr<clk::sentinel> const& sentinel = {}) noexcept = 0;
-    virtual void pull(std::weak_ptr<clk::sentinel> const& sentinel = {}) noexcept = 0;
+    virtual void push(clk::sentinel sentinel = {}) noexcept = 0;
+    virtual void pull(clk::sentinel sentinel = {}) noexcept = 0;
 
     virtual auto create_compatible_port() const -> std::unique_ptr<port> = 0;
 
 protected:
     void connection_changed();
+    void set_timestamp(clk::timestamp timestamp) noexcept;
 
 private:
     friend class graph;
@@ -60,8 +61,11 @@ private:
     clk::timestamp _timestamp;
     mutable bool _faulty = false;
     std::function<void()> _connection_changed_callback;
+    std::function<void()> _data_changed_callback;
 
     void set_connection_changed_callback(std::function<void()> const& callback);
+    // called whenever the timestamp is updated, i.e. whenever the data is accessed for writing
+    void set_data_changed_callback(std::function<void()> const& callback);
 };
 
 } // namespace clk
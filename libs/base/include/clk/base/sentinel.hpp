@@ -1,15 +1,31 @@
 #pragma once
 
+#include <cstdint>
+
 namespace clk
 {
-class sentinel
+// Identifies a single pull or push evaluation. Nodes remember the sentinel of the last evaluation that visited them,
+// so that cycles are broken with an integer comparison. A default constructed sentinel does not belong to any
+// evaluation.
+class sentinel final
 {
 public:
     sentinel() = default;
-    sentinel(sentinel const&) = delete;
-    sentinel(sentinel&&) = delete;
-    auto operator=(sentinel const&) -> sentinel& = delete;
-    auto operator=(sentinel&&) -> sentinel& = delete;
-    virtual ~sentinel() = default;
+    sentinel(sentinel const&) = default;
+    sentinel(sentinel&&) = default;
+    auto operator=(sentinel const&) -> sentinel& = default;
+    auto operator=(sentinel&&) -> sentinel& = default;
+    ~sentinel() = default;
+
+    static auto create() noexcept -> sentinel;
+
+    auto is_valid() const noexcept -> bool;
+    auto operator==(sentinel const& other) const noexcept -> bool;
+    auto operator!=(sentinel const& other) const noexcept -> bool;
+
+private:
+    std::uint64_t _generation = 0;
+
+    explicit sentinel(std::uint64_t generation) noexcept;
 };
 } // namespace clk
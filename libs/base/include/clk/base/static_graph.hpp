@@ -0,0 +1,342 @@
+#pragma once
+
+#include "clk/base/input.hpp"
+#include "clk/base/node.hpp"
+#include "clk/base/output.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace clk
+{
+// a value of the static graph that is set from outside of it
+template <typename T>
+struct static_input
+{
+};
+
+// calls Algorithm with the results of the nodes at the Sources indices, Algorithm is a class with a single, non
+// overloaded call operator
+template <typename Algorithm, std::size_t... Sources>
+struct static_node
+{
+};
+
+namespace impl
+{
+template <typename Function>
+struct call_signature : call_signature<decltype(&Function::operator())>
+{
+};
+
+template <typename Class, typename Result, typename... Arguments>
+struct call_signature<Result (Class::*)(Arguments...)>
+{
+    using result = Result;
+    using arguments = std::tuple<std::decay_t<Arguments>...>;
+};
+
+template <typename Class, typename Result, typename... Arguments>
+struct call_signature<Result (Class::*)(Arguments...) const> : call_signature<Result (Class::*)(Arguments...)>
+{
+};
+
+template <typename Node>
+struct static_node_traits;
+
+template <typename T>
+struct static_node_traits<static_input<T>>
+{
+    using result = T;
+    using algorithm = static_input<T>;
+    static constexpr bool is_input = true;
+    static constexpr std::array<std::size_t, 0> sources = {};
+};
+
+template <typename Algorithm, std::size_t... Sources>
+struct static_node_traits<static_node<Algorithm, Sources...>>
+{
+    using result = std::decay_t<typename call_signature<Algorithm>::result>;
+    using arguments = typename call_signature<Algorithm>::arguments;
+    using algorithm = Algorithm;
+    static constexpr bool is_input = false;
+    static constexpr std::array<std::size_t, sizeof...(Sources)> sources = {Sources...};
+
+    static_assert(std::tuple_size_v<arguments> == sizeof...(Sources), "Every argument needs exactly one source");
+    static_assert(!std::is_void_v<result>, "Algorithms of static nodes need a result");
+};
+
+struct static_order
+{
+    bool acyclic = true;
+    bool valid_sources = true;
+};
+
+// the nodes are ordered like Kahn's algorithm would, but with repeated passes, which is fine for the few nodes of a
+// pipeline and simple enough to run at compile time
+template <typename... Nodes>
+constexpr auto static_topological_order() -> std::pair<std::array<std::size_t, sizeof...(Nodes)>, static_order>
+{
+    constexpr std::size_t node_count = sizeof...(Nodes);
+    std::array<std::size_t, node_count> order = {};
+    static_order properties;
+
+    constexpr std::array<std::size_t, node_count> source_counts = {static_node_traits<Nodes>::sources.size()...};
+    constexpr std::size_t maximum_source_count =
+        std::max({std::size_t(1), static_node_traits<Nodes>::sources.size()...});
+    std::array<std::array<std::size_t, maximum_source_count>, node_count> sources = {};
+    {
+        std::size_t node = 0;
+        (
+            [&]() {
+                for(std::size_t i = 0; i < static_node_traits<Nodes>::sources.size(); i++)
+                    sources[node][i] = static_node_traits<Nodes>::sources[i];
+                node++;
+            }(),
+            ...);
+    }
+
+    for(std::size_t node = 0; node < node_count; node++)
+        for(std::size_t i = 0; i < source_counts[node]; i++)
+            properties.valid_sources = properties.valid_sources && sources[node][i] < node_count;
+    if(!properties.valid_sources)
+        return {order, properties};
+
+    std::array<bool, node_count> placed = {};
+    std::size_t placed_count = 0;
+    bool progress = true;
+    while(progress && placed_count < node_count)
+    {
+        progress = false;
+        for(std::size_t node = 0; node < node_count; node++)
+        {
+            if(placed[node])
+                continue;
+
+            bool ready = true;
+            for(std::size_t i = 0; i < source_counts[node]; i++)
+                ready = ready && placed[sources[node][i]];
+            if(!ready)
+                continue;
+
+            placed[node] = true;
+            order[placed_count++] = node;
+            progress = true;
+        }
+    }
+    properties.acyclic = placed_count == node_count;
+    return {order, properties};
+}
+} // namespace impl
+
+// A pipeline whose topology is fixed at compile time. The connections are type checked, the nodes are ordered at
+// compile time, and evaluate() calls every algorithm directly, so the compiler can inline the whole pipeline.
+template <typename... Nodes>
+class static_graph final
+{
+public:
+    static constexpr std::size_t node_count = sizeof...(Nodes);
+
+    template <std::size_t Node>
+    using node_type = std::tuple_element_t<Node, std::tuple<Nodes...>>;
+    template <std::size_t Node>
+    using result_type = typename impl::static_node_traits<node_type<Node>>::result;
+    template <std::size_t Node>
+    static constexpr bool is_input = impl::static_node_traits<node_type<Node>>::is_input;
+
+    static_assert(impl::static_topological_order<Nodes...>().second.valid_sources, "Sources must be node indices");
+    static_assert(impl::static_topological_order<Nodes...>().second.acyclic, "Static graphs can not have cycles");
+
+    static constexpr std::array<std::size_t, node_count> evaluation_order =
+        impl::static_topological_order<Nodes...>().first;
+
+    static_graph() = default;
+    static_graph(static_graph const&) = default;
+    static_graph(static_graph&&) = default;
+    auto operator=(static_graph const&) -> static_graph& = default;
+    auto operator=(static_graph&&) -> static_graph& = default;
+    ~static_graph() = default;
+
+    template <std::size_t Node>
+    void set(result_type<Node> value)
+    {
+        static_assert(is_input<Node>, "Only static inputs can be set");
+        std::get<Node>(_results) = std::move(value);
+    }
+
+    template <std::size_t Node>
+    auto get() const noexcept -> result_type<Node> const&
+    {
+        return std::get<Node>(_results);
+    }
+
+    template <std::size_t Node>
+    auto algorithm() noexcept -> typename impl::static_node_traits<node_type<Node>>::algorithm&
+    {
+        return std::get<Node>(_algorithms);
+    }
+
+    void evaluate()
+    {
+        evaluate_in_order(std::make_index_sequence<node_count>());
+    }
+
+private:
+    std::tuple<typename impl::static_node_traits<Nodes>::algorithm...> _algorithms;
+    std::tuple<typename impl::static_node_traits<Nodes>::result...> _results;
+
+    template <std::size_t... Steps>
+    void evaluate_in_order(std::index_sequence<Steps...> /*steps*/)
+    {
+        (evaluate_node<evaluation_order[Steps]>(), ...);
+    }
+
+    template <std::size_t Node>
+    void evaluate_node()
+    {
+        using traits = impl::static_node_traits<node_type<Node>>;
+        if constexpr(!traits::is_input)
+        {
+            check_arguments<Node>(std::make_index_sequence<traits::sources.size()>());
+            call_algorithm<Node>(std::make_index_sequence<traits::sources.size()>());
+        }
+    }
+
+    template <std::size_t Node, std::size_t... Arguments>
+    static constexpr void check_arguments(std::index_sequence<Arguments...> /*arguments*/)
+    {
+        using traits = impl::static_node_traits<node_type<Node>>;
+        static_assert((std::is_convertible_v<result_type<traits::sources[Arguments]>,
+                           std::tuple_element_t<Arguments, typename traits::arguments>> &&
+                          ...),
+            "The results of the sources must be convertible to the arguments of the algorithm");
+    }
+
+    template <std::size_t Node, std::size_t... Arguments>
+    void call_algorithm(std::index_sequence<Arguments...> /*arguments*/)
+    {
+        using traits = impl::static_node_traits<node_type<Node>>;
+        std::get<Node>(_results) = std::get<Node>(_algorithms)(std::get<traits::sources[Arguments]>(_results)...);
+    }
+};
+
+namespace impl
+{
+template <typename StaticGraph, typename = std::make_index_sequence<StaticGraph::node_count>>
+struct static_graph_inputs;
+
+template <typename StaticGraph, std::size_t... Nodes>
+struct static_graph_inputs<StaticGraph, std::index_sequence<Nodes...>>
+{
+    static constexpr std::size_t count = (std::size_t(StaticGraph::template is_input<Nodes>) + ... + 0);
+    static constexpr std::array<std::size_t, count> nodes = []() {
+        constexpr std::array<bool, sizeof...(Nodes)> input_flags = {StaticGraph::template is_input<Nodes>...};
+        std::array<std::size_t, count> input_nodes = {};
+        std::size_t input = 0;
+        for(std::size_t node = 0; node < input_flags.size(); node++)
+            if(input_flags[node])
+                input_nodes[input++] = node;
+        return input_nodes;
+    }();
+};
+
+template <typename StaticGraph, typename = std::make_index_sequence<static_graph_inputs<StaticGraph>::count>>
+struct static_graph_input_ports;
+
+template <typename StaticGraph, std::size_t... Inputs>
+struct static_graph_input_ports<StaticGraph, std::index_sequence<Inputs...>>
+{
+    using type = std::tuple<
+        clk::input_of<typename StaticGraph::template result_type<static_graph_inputs<StaticGraph>::nodes[Inputs]>>...>;
+};
+} // namespace impl
+
+// Exposes a static graph as a single node of a dynamic graph, with an input for every static input and an output for
+// every node listed in OutputNodes. Data is only copied at the ports of the node, not between the static nodes.
+template <typename StaticGraph, std::size_t... OutputNodes>
+class static_graph_node final : public node
+{
+public:
+    static_graph_node() = delete;
+    explicit static_graph_node(std::string_view name) : _name(name)
+    {
+        register_inputs(std::make_index_sequence<input_count>());
+        register_outputs(std::make_index_sequence<sizeof...(OutputNodes)>());
+    }
+    static_graph_node(static_graph_node const&) = delete;
+    static_graph_node(static_graph_node&&) noexcept = delete;
+    auto operator=(static_graph_node const&) -> static_graph_node& = delete;
+    auto operator=(static_graph_node&&) noexcept -> static_graph_node& = delete;
+    ~static_graph_node() override = default;
+
+    auto name() const -> std::string_view override
+    {
+        return _name;
+    }
+
+    auto graph() noexcept -> StaticGraph&
+    {
+        return _graph;
+    }
+
+private:
+    static constexpr std::size_t input_count = impl::static_graph_inputs<StaticGraph>::count;
+    static constexpr std::array<std::size_t, input_count> input_nodes = impl::static_graph_inputs<StaticGraph>::nodes;
+    static constexpr std::array<std::size_t, sizeof...(OutputNodes)> output_nodes = {OutputNodes...};
+
+    std::string _name;
+    StaticGraph _graph;
+    typename impl::static_graph_input_ports<StaticGraph>::type _inputs;
+    std::tuple<output_of<typename StaticGraph::template result_type<OutputNodes>>...> _outputs;
+
+    template <std::size_t... Inputs>
+    void register_inputs(std::index_sequence<Inputs...> /*inputs*/)
+    {
+        (
+            [&]() {
+                auto& input = std::get<Inputs>(_inputs);
+                input.set_name("Input " + std::to_string(Inputs + 1));
+                register_port(&input);
+            }(),
+            ...);
+    }
+
+    template <std::size_t... Outputs>
+    void register_outputs(std::index_sequence<Outputs...> /*outputs*/)
+    {
+        (
+            [&]() {
+                auto& output = std::get<Outputs>(_outputs);
+                output.set_name("Output " + std::to_string(Outputs + 1));
+                register_port(&output);
+            }(),
+            ...);
+    }
+
+    template <std::size_t... Inputs>
+    void read_inputs(std::index_sequence<Inputs...> /*inputs*/)
+    {
+        (_graph.template set<input_nodes[Inputs]>(*std::get<Inputs>(_inputs)), ...);
+    }
+
+    template <std::size_t... Outputs>
+    void write_outputs(std::index_sequence<Outputs...> /*outputs*/)
+    {
+        ((*std::get<Outputs>(_outputs) = _graph.template get<output_nodes[Outputs]>()), ...);
+    }
+
+    void update() override
+    {
+        read_inputs(std::make_index_sequence<input_count>());
+        _graph.evaluate();
+        write_outputs(std::make_index_sequence<sizeof...(OutputNodes)>());
+    }
+};
+
+} // namespace clk
@@ -1,4 +1,6 @@
 #include "clk/base/algorithm.hpp"
+#include "clk/base/input.hpp"
+#include "clk/base/output.hpp"
 
 #include <range/v3/algorithm/find.hpp>
 #include <range/v3/functional/identity.hpp>
@@ -20,6 +22,40 @@ auto algorithm::factories() -> std::map<std::string, std::unique_ptr<algorithm>
     return factories_map();
 }
 
+auto algorithm::is_pure() const noexcept -> bool
+{
+    return false;
+}
+
+void algorithm::update_batch(std::size_t count)
+{
+    for(auto* output : _outputs)
+        output->resize_column(count);
+
+    try
+    {
+        for(std::size_t i = 0; i < count; i++)
+        {
+            for(auto* input : _inputs)
+                input->bind_column_element(i);
+
+            update();
+
+            for(auto* output : _outputs)
+                output->store_column_element(i);
+        }
+    }
+    catch(...)
+    {
+        for(auto* input : _inputs)
+            input->unbind_column_element();
+        throw;
+    }
+
+    for(auto* input : _inputs)
+        input->unbind_column_element();
+}
+
 auto algorithm::inputs() const noexcept -> std::vector<clk::input*> const&
 {
     return _inputs;
@@ -22,6 +22,7 @@ auto algorithm_node::name() const -> std::string_view
 void algorithm_node::set_algorithm(std::unique_ptr<clk::algorithm>&& algorithm)
 {
     _algorithm = std::move(algorithm);
+    _memo_cache = _algorithm->is_pure() ? std::make_unique<clk::memo_cache>() : nullptr;
     for(auto* input : _algorithm->inputs())
         register_port(input);
 
@@ -31,6 +32,11 @@ void algorithm_node::set_algorithm(std::unique_ptr<clk::algorithm>&& algorithm)
     pull();
 }
 
+auto algorithm_node::memo_cache() const -> clk::memo_cache*
+{
+    return _memo_cache.get();
+}
+
 auto algorithm_node::update_possible() const -> bool
 {
     return _algorithm != nullptr;
@@ -38,7 +44,18 @@ auto algorithm_node::update_possible() const -> bool
 
 void algorithm_node::update()
 {
+    if(_memo_cache != nullptr && _memo_cache->restore(inputs(), outputs()))
+        return;
+
     _algorithm->update();
+
+    if(_memo_cache != nullptr)
+        _memo_cache->store(inputs(), outputs());
+}
+
+void algorithm_node::process_batch(std::size_t count)
+{
+    _algorithm->update_batch(count);
 }
 
 } // namespace clk
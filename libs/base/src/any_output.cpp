@@ -47,6 +47,13 @@ void any_output::clear_data()
     set_data(nullptr, 0);
 }
 
+void any_output::set_column(void const* column_pointer, std::size_t column_size)
+{
+    update_timestamp();
+    _column_pointer = column_pointer;
+    _column_size = column_pointer == nullptr ? 0 : column_size;
+}
+
 auto any_output::data_type_hash() const noexcept -> std::size_t
 {
     return _data_type_hash;
@@ -62,6 +69,16 @@ auto any_output::data_pointer() noexcept -> void*
     return nullptr;
 }
 
+auto any_output::column_pointer() const noexcept -> void const*
+{
+    return _column_pointer;
+}
+
+auto any_output::column_size() const noexcept -> std::size_t
+{
+    return _column_size;
+}
+
 auto any_output::create_compatible_port() const -> std::unique_ptr<port>
 {
     return std::make_unique<any_input>();
@@ -0,0 +1,263 @@
+#include "clk/base/evaluation_service.hpp"
+#include "clk/base/graph.hpp"
+#include "clk/base/input.hpp"
+#include "clk/base/node.hpp"
+#include "clk/base/output.hpp"
+#include "clk/base/port.hpp"
+
+#include <range/v3/algorithm/any_of.hpp>
+#include <range/v3/algorithm/find.hpp>
+#include <range/v3/algorithm/remove_if.hpp>
+#include <utility>
+
+namespace clk
+{
+
+auto evaluation_service::snapshot::data_pointer(clk::port const& port) const -> void const*
+{
+    auto const* output = dynamic_cast<clk::output const*>(&port);
+    if(auto const* input = dynamic_cast<clk::input const*>(&port); input != nullptr)
+        output = input->connected_output() != nullptr ? input->connected_output() : &input->default_port();
+
+    auto it = _outputs.find(output);
+    if(it == _outputs.end() || it->second.copy == nullptr)
+        return nullptr;
+    return it->second.copy->data_pointer();
+}
+
+auto evaluation_service::snapshot::error(clk::node const& node) const -> std::string const&
+{
+    static std::string const no_error;
+    auto it = _errors.find(&node);
+    return it != _errors.end() ? it->second : no_error;
+}
+
+auto evaluation_service::snapshot::is_faulty(clk::port const& port) const -> bool
+{
+    return _faulty_ports.count(&port) != 0;
+}
+
+auto evaluation_service::request::operator==(request const& other) const -> bool
+{
+    return type == other.type && node == other.node && port == other.port;
+}
+
+evaluation_service::evaluation_service(clk::graph const& graph)
+    : _graph(graph), _snapshot(std::make_shared<snapshot const>())
+{
+    {
+        std::scoped_lock lock(_graph_mutex);
+        publish_snapshot();
+    }
+    _worker = std::thread([this]() {
+        work();
+    });
+}
+
+evaluation_service::~evaluation_service()
+{
+    {
+        std::scoped_lock lock(_queue_mutex);
+        _stopping = true;
+        _queue.clear();
+    }
+    _queue_changed.notify_all();
+    _worker.join();
+}
+
+void evaluation_service::queue_pull(clk::node& node)
+{
+    queue({request::kind::pull_node, &node, nullptr});
+}
+
+void evaluation_service::queue_push(clk::node& node)
+{
+    queue({request::kind::push_node, &node, nullptr});
+}
+
+void evaluation_service::queue_push(clk::port& port)
+{
+    queue({request::kind::push_port, nullptr, &port});
+}
+
+void evaluation_service::cancel(clk::node const& node)
+{
+    std::scoped_lock lock(_queue_mutex);
+    _queue.erase(ranges::remove_if(_queue,
+                     [&](request const& queued) {
+                         return queued.node == &node || ranges::any_of(node.all_ports(), [&](clk::port const* port) {
+                             return port == queued.port;
+                         });
+                     }),
+        _queue.end());
+    _queue_changed.notify_all();
+}
+
+void evaluation_service::cancel(clk::port const& port)
+{
+    std::scoped_lock lock(_queue_mutex);
+    _queue.erase(ranges::remove_if(_queue,
+                     [&](request const& queued) {
+                         return queued.port == &port;
+                     }),
+        _queue.end());
+    _queue_changed.notify_all();
+}
+
+auto evaluation_service::is_busy() const -> bool
+{
+    std::scoped_lock lock(_queue_mutex);
+    return !_queue.empty() || _running_request.has_value();
+}
+
+auto evaluation_service::is_evaluating(clk::node const& node) const -> bool
+{
+    std::scoped_lock lock(_queue_mutex);
+    if(_running_request.has_value() && _running_request->node == &node)
+        return true;
+    return ranges::any_of(_queue, [&](request const& queued) {
+        return queued.node == &node;
+    });
+}
+
+auto evaluation_service::queued_request_count() const -> std::size_t
+{
+    std::scoped_lock lock(_queue_mutex);
+    return _queue.size();
+}
+
+void evaluation_service::wait() const
+{
+    std::unique_lock lock(_queue_mutex);
+    _queue_changed.wait(lock, [&]() {
+        return _queue.empty() && !_running_request.has_value();
+    });
+}
+
+auto evaluation_service::lock() -> std::unique_lock<std::mutex>
+{
+    return std::unique_lock(_graph_mutex);
+}
+
+auto evaluation_service::try_lock() -> std::unique_lock<std::mutex>
+{
+    return std::unique_lock(_graph_mutex, std::try_to_lock);
+}
+
+auto evaluation_service::published_snapshot() const -> std::shared_ptr<snapshot const>
+{
+    std::scoped_lock lock(_snapshot_mutex);
+    return _snapshot;
+}
+
+void evaluation_service::set_published_callback(std::function<void()> callback)
+{
+    std::scoped_lock lock(_queue_mutex);
+    _published_callback = std::move(callback);
+}
+
+void evaluation_service::queue(request new_request)
+{
+    {
+        std::scoped_lock lock(_queue_mutex);
+        if(ranges::find(_queue, new_request) != _queue.end())
+            return;
+        _queue.push_back(new_request);
+    }
+    _queue_changed.notify_all();
+}
+
+void evaluation_service::work()
+{
+    while(true)
+    {
+        request current;
+        std::function<void()> published_callback;
+        {
+            std::unique_lock lock(_queue_mutex);
+            _queue_changed.wait(lock, [&]() {
+                return _stopping || !_queue.empty();
+            });
+            if(_stopping)
+                return;
+            current = _queue.front();
+            _queue.pop_front();
+            _running_request = current;
+            published_callback = _published_callback;
+        }
+
+        {
+            std::scoped_lock lock(_graph_mutex);
+            // the graph may have been edited since the last evaluation
+            publish_snapshot();
+            evaluate(current);
+            publish_snapshot();
+        }
+
+        {
+            std::scoped_lock lock(_queue_mutex);
+            _running_request.reset();
+        }
+        _queue_changed.notify_all();
+
+        if(published_callback)
+            published_callback();
+    }
+}
+
+void evaluation_service::evaluate(request const& current) const
+{
+    switch(current.type)
+    {
+        case request::kind::pull_node:
+            current.node->pull();
+            break;
+        case request::kind::push_node:
+            current.node->push();
+            break;
+        case request::kind::push_port:
+            current.port->push();
+            break;
+    }
+}
+
+// only the worker and the constructor publish, so the previous snapshot can be read without locking
+void evaluation_service::publish_snapshot()
+{
+    auto next = std::make_shared<snapshot>();
+    auto const& previous = *_snapshot;
+
+    auto copy_output = [&](clk::output const& output) {
+        // outputs whose data did not change since the previous snapshot share its copy
+        if(auto it = previous._outputs.find(&output); it != previous._outputs.end() &&
+                                                        !output.timestamp().is_reset() &&
+                                                        it->second.timestamp == output.timestamp() &&
+                                                        it->second.data_type_hash == output.data_type_hash())
+        {
+            next->_outputs.emplace(&output, it->second);
+        }
+        else
+        {
+            next->_outputs.emplace(
+                &output, snapshot::copied_output{output.timestamp(), output.data_type_hash(), output.create_copy()});
+        }
+    };
+
+    for(auto const& node : _graph.nodes())
+    {
+        if(!node->error().empty())
+            next->_errors.emplace(node.get(), node->error());
+        for(auto* port : node->all_ports())
+            if(port->is_faulty())
+                next->_faulty_ports.insert(port);
+        for(auto* output : node->outputs())
+            copy_output(*output);
+        for(auto* input : node->inputs())
+            copy_output(input->default_port());
+    }
+
+    std::scoped_lock lock(_snapshot_mutex);
+    _snapshot = std::move(next);
+}
+
+} // namespace clk
@@ -0,0 +1,211 @@
+#include "clk/base/execution_plan.hpp"
+#include "clk/base/graph.hpp"
+#include "clk/base/input.hpp"
+#include "clk/base/node.hpp"
+#include "clk/base/output.hpp"
+#include "clk/util/profiling_zones.hpp"
+
+#include <deque>
+#include <range/v3/algorithm/any_of.hpp>
+#include <range/v3/algorithm/find.hpp>
+#include <unordered_map>
+
+namespace clk
+{
+
+execution_plan::execution_plan(clk::graph const& graph) : _timestamp(graph.timestamp())
+{
+    auto const& graph_nodes = graph.nodes();
+    std::size_t const node_count = graph_nodes.size();
+
+    std::unordered_map<clk::output const*, std::size_t> output_owners;
+    for(std::size_t i = 0; i < node_count; i++)
+        for(auto const* output : graph_nodes[i]->outputs())
+            output_owners[output] = i;
+
+    std::vector<std::vector<std::size_t>> downstream(node_count);
+    std::vector<std::size_t> in_degree(node_count, 0);
+    std::vector<bool> unwatched(node_count, false);
+    std::vector<bool> reads_itself(node_count, false);
+    for(std::size_t i = 0; i < node_count; i++)
+    {
+        unwatched[i] = !graph_nodes[i]->has_inputs() || !graph_nodes[i]->has_outputs();
+        for(auto const* input : graph_nodes[i]->inputs())
+        {
+            auto owner = output_owners.find(input->connected_output());
+            if(owner == output_owners.end())
+            {
+                unwatched[i] = unwatched[i] || input->connected_output() != nullptr;
+                continue;
+            }
+            if(owner->second == i)
+            {
+                reads_itself[i] = true;
+                continue;
+            }
+
+            auto& owner_downstream = downstream[owner->second];
+            if(ranges::find(owner_downstream, i) != owner_downstream.end())
+                continue;
+
+            owner_downstream.push_back(i);
+            in_degree[i]++;
+        }
+    }
+
+    std::vector<std::size_t> order;
+    order.reserve(node_count);
+    std::deque<std::size_t> ready;
+    for(std::size_t i = 0; i < node_count; i++)
+        if(in_degree[i] == 0)
+            ready.push_back(i);
+
+    while(!ready.empty())
+    {
+        std::size_t current = ready.front();
+        ready.pop_front();
+        order.push_back(current);
+        for(std::size_t next : downstream[current])
+            if(--in_degree[next] == 0)
+                ready.push_back(next);
+    }
+
+    std::size_t const ordered_node_count = order.size();
+    for(std::size_t i = 0; i < node_count; i++)
+        if(in_degree[i] != 0)
+            order.push_back(i);
+
+    std::vector<std::size_t> position(node_count);
+    for(std::size_t i = 0; i < node_count; i++)
+        position[order[i]] = i;
+
+    _nodes.reserve(node_count);
+    _dependencies.resize(node_count);
+    _dependents.resize(node_count);
+    _back_edges.resize(node_count);
+    for(std::size_t i = 0; i < node_count; i++)
+    {
+        _nodes.push_back(graph_nodes[order[i]].get());
+        _positions[_nodes.back()] = i;
+        if(unwatched[order[i]])
+            _unwatched_nodes.push_back(i);
+        if(reads_itself[order[i]])
+            _back_edges[i].push_back(i);
+        for(std::size_t next : downstream[order[i]])
+        {
+            // back edges only occur inside of cycles, dropping them keeps the dependencies acyclic
+            if(position[next] < i)
+            {
+                _back_edges[i].push_back(position[next]);
+                continue;
+            }
+            _dependents[i].push_back(position[next]);
+            _dependencies[position[next]].push_back(i);
+        }
+    }
+
+    // nodes inside of cycles are chained one after the other, so that no node ever runs concurrently with a node
+    // that reads its outputs through a dropped back edge
+    for(std::size_t i = ordered_node_count + 1; i < node_count; i++)
+    {
+        if(ranges::find(_dependencies[i], i - 1) != _dependencies[i].end())
+            continue;
+        _dependents[i - 1].push_back(i);
+        _dependencies[i].push_back(i - 1);
+    }
+
+    // nothing was evaluated by this plan yet
+    _dirty.assign(node_count, false);
+    for(std::size_t i = 0; i < node_count; i++)
+        mark_dirty(i);
+}
+
+auto execution_plan::is_outdated(clk::graph const& graph) const -> bool
+{
+    return _timestamp != graph.timestamp();
+}
+
+auto execution_plan::nodes() const -> std::vector<clk::node*> const&
+{
+    return _nodes;
+}
+
+auto execution_plan::dependencies(std::size_t node_index) const -> std::vector<std::size_t> const&
+{
+    return _dependencies[node_index];
+}
+
+auto execution_plan::dependents(std::size_t node_index) const -> std::vector<std::size_t> const&
+{
+    return _dependents[node_index];
+}
+
+void execution_plan::mark_modified(clk::node const& node)
+{
+    if(auto it = _positions.find(&node); it != _positions.end())
+        mark_dirty(it->second);
+}
+
+void execution_plan::run() const
+{
+    CLK_PROFILE_SCOPE("Run execution plan");
+    for(std::size_t node_index : _unwatched_nodes)
+        mark_dirty(node_index);
+    for(std::size_t node_index : _next_run)
+        mark_dirty(node_index);
+    _next_run.clear();
+
+    // every output written since the last run has a newer timestamp, whether it was written by a node of the plan or
+    // from the outside, e.g. the output of a constant node
+    auto const last_run = _last_run;
+    auto const was_written = [&](auto const* output) {
+        return output->timestamp() > last_run;
+    };
+    // outputs written from the outside do not pass through mark_modified, the nodes reading them are found through
+    // the owner of the output
+    for(std::size_t node_index = 0; node_index < _nodes.size(); node_index++)
+        if(!_dirty[node_index] && ranges::any_of(_nodes[node_index]->outputs(), was_written))
+            mark_dirty(node_index);
+
+    while(!_frontier.empty())
+    {
+        std::size_t const node_index = _frontier.top();
+        _frontier.pop();
+        _dirty[node_index] = false;
+
+        auto* node = _nodes[node_index];
+        node->update_if_needed();
+
+        bool const changed = ranges::any_of(node->outputs(), [&](auto const* output) {
+            return was_written(output) || output->is_faulty();
+        });
+        if(!changed)
+            continue;
+
+        for(std::size_t dependent : _dependents[node_index])
+            mark_dirty(dependent);
+        _next_run.insert(_next_run.end(), _back_edges[node_index].begin(), _back_edges[node_index].end());
+    }
+    _last_run.update();
+}
+
+void execution_plan::run_batch(std::size_t count) const
+{
+    CLK_PROFILE_SCOPE("Run execution plan batch");
+    for(auto* node : _nodes)
+        node->update_batch(count);
+
+    // batches write the columns of every output, the next run checks every node again
+    for(std::size_t i = 0; i < _nodes.size(); i++)
+        mark_dirty(i);
+}
+
+void execution_plan::mark_dirty(std::size_t node_index) const
+{
+    if(_dirty[node_index])
+        return;
+    _dirty[node_index] = true;
+    _frontier.push(node_index);
+}
+
+} // namespace clk
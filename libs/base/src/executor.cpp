@@ -0,0 +1,194 @@
+#include "clk/base/executor.hpp"
+#include "clk/base/execution_plan.hpp"
+#include "clk/base/node.hpp"
+#include "clk/util/profiling_zones.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace clk
+{
+
+executor::executor() : executor(std::max<std::size_t>(std::thread::hardware_concurrency(), 1))
+{
+}
+
+executor::executor(std::size_t thread_count)
+{
+    thread_count = std::max<std::size_t>(thread_count, 1);
+    for(std::size_t i = 0; i < thread_count; i++)
+        _queues.push_back(std::make_unique<task_queue>());
+
+    // the calling thread takes part in every run, using the first queue
+    for(std::size_t i = 1; i < thread_count; i++)
+        _workers.emplace_back([this, i]() {
+            work_loop(i);
+        });
+}
+
+executor::~executor()
+{
+    {
+        std::scoped_lock lock(_mutex);
+        _stopping = true;
+    }
+    _run_started.notify_all();
+    for(auto& worker : _workers)
+        worker.join();
+}
+
+auto executor::thread_count() const -> std::size_t
+{
+    return _queues.size();
+}
+
+void executor::run(clk::execution_plan const& plan)
+{
+    if(_workers.empty())
+        plan.run();
+    else
+        start(plan, std::nullopt);
+}
+
+void executor::run_batch(clk::execution_plan const& plan, std::size_t count)
+{
+    if(_workers.empty())
+        plan.run_batch(count);
+    else
+        start(plan, count);
+}
+
+void executor::start(clk::execution_plan const& plan, std::optional<std::size_t> batch_size)
+{
+    CLK_PROFILE_SCOPE("Run executor");
+    std::size_t const node_count = plan.nodes().size();
+    if(node_count == 0)
+        return;
+
+    {
+        // everything a worker needs is published before the remaining node count, since a worker that slept
+        // through the previous run may start working as soon as it sees a non-zero count
+        std::scoped_lock lock(_mutex);
+        _plan = &plan;
+        _batch_size = batch_size;
+
+        if(_pending_dependencies_size < node_count)
+        {
+            _pending_dependencies = std::make_unique<std::atomic<std::size_t>[]>(node_count);
+            _pending_dependencies_size = node_count;
+        }
+
+        std::size_t next_queue = 0;
+        for(std::size_t i = 0; i < node_count; i++)
+        {
+            std::size_t const dependency_count = plan.dependencies(i).size();
+            _pending_dependencies[i].store(dependency_count, std::memory_order_relaxed);
+            if(dependency_count == 0)
+            {
+                auto& queue = *_queues[next_queue];
+                std::scoped_lock queue_lock(queue.mutex);
+                queue.tasks.push_back(i);
+                next_queue = (next_queue + 1) % _queues.size();
+            }
+        }
+
+        _remaining_nodes.store(node_count, std::memory_order_release);
+        _run_count++;
+    }
+    _run_started.notify_all();
+
+    work(0);
+
+    std::unique_lock lock(_mutex);
+    _run_finished.wait(lock, [&]() {
+        return _active_workers == 0;
+    });
+}
+
+void executor::work_loop(std::size_t queue_index)
+{
+    std::size_t last_run = 0;
+    while(true)
+    {
+        {
+            std::unique_lock lock(_mutex);
+            _run_started.wait(lock, [&]() {
+                return _stopping || _run_count != last_run;
+            });
+            if(_stopping)
+                return;
+            last_run = _run_count;
+            _active_workers++;
+        }
+
+        work(queue_index);
+
+        {
+            std::scoped_lock lock(_mutex);
+            _active_workers--;
+        }
+        _run_finished.notify_all();
+    }
+}
+
+void executor::work(std::size_t queue_index)
+{
+    while(_remaining_nodes.load(std::memory_order_acquire) != 0)
+    {
+        if(auto task = take_task(queue_index); task.has_value())
+            execute(queue_index, *task);
+        else
+            std::this_thread::yield();
+    }
+}
+
+auto executor::take_task(std::size_t queue_index) -> std::optional<std::size_t>
+{
+    {
+        auto& own_queue = *_queues[queue_index];
+        std::scoped_lock lock(own_queue.mutex);
+        if(!own_queue.tasks.empty())
+        {
+            std::size_t task = own_queue.tasks.back();
+            own_queue.tasks.pop_back();
+            return task;
+        }
+    }
+
+    for(std::size_t offset = 1; offset < _queues.size(); offset++)
+    {
+        auto& other_queue = *_queues[(queue_index + offset) % _queues.size()];
+        std::scoped_lock lock(other_queue.mutex);
+        if(!other_queue.tasks.empty())
+        {
+            std::size_t task = other_queue.tasks.front();
+            other_queue.tasks.pop_front();
+            return task;
+        }
+    }
+
+    return std::nullopt;
+}
+
+void executor::execute(std::size_t queue_index, std::size_t node_index)
+{
+    CLK_PROFILE_SCOPE("Execute node");
+    if(auto* node = _plan->nodes()[node_index]; _batch_size.has_value())
+        node->update_batch(*_batch_size);
+    else
+        node->update_if_needed();
+
+    for(std::size_t dependent : _plan->dependents(node_index))
+    {
+        if(_pending_dependencies[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            auto& own_queue = *_queues[queue_index];
+            std::scoped_lock lock(own_queue.mutex);
+            own_queue.tasks.push_back(dependent);
+        }
+    }
+
+    _remaining_nodes.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+} // namespace clk
@@ -1,9 +1,10 @@
 #include "clk/base/graph.hpp"
+#include "clk/base/input.hpp"
+#include "clk/base/output.hpp"
 #include "clk/base/port.hpp"
-#include "clk/util/predicates.hpp"
-#include "clk/util/projections.hpp"
 
-#include <range/v3/algorithm/remove_if.hpp>
+#include <algorithm>
+#include <range/v3/algorithm/sort.hpp>
 #include <range/v3/iterator/basic_iterator.hpp>
 #include <range/v3/view/any_view.hpp>
 #include <utility>
@@ -11,22 +12,49 @@
 namespace clk
 {
 
+graph::~graph()
+{
+    // destroying the nodes disconnects their ports, which would update the demand from a half destroyed graph
+    _demand_driven = false;
+}
+
 void graph::add_node(std::unique_ptr<clk::node>&& node)
 {
     for(auto* port : node->all_ports())
-        port->set_connection_changed_callback([this]() {
-            _timestamp.update();
-        });
+        watch_port(*node, *port);
+    node->_port_registered_callback = [this, node = node.get()](clk::port& port) {
+        watch_port(*node, port);
+        modified();
+    };
+    // the unregistered ports are destroyed, like the ports of removed nodes
+    node->_port_unregistered_callback = [this](clk::port& port) {
+        if(auto const* output = dynamic_cast<clk::output const*>(&port); output != nullptr)
+            _observer_counts.erase(output);
+        modified();
+    };
+
+    if(_profiling)
+        node->set_profiling(true);
 
     _nodes.push_back(std::move(node));
-    _timestamp.update();
+    modified();
 }
 
 void graph::remove_node(clk::node* node)
 {
-    _nodes.erase(
-        ranges::remove_if(_nodes, clk::predicates::is_equal_to(node), clk::projections::underlying()), _nodes.end());
-    _timestamp.update();
+    auto it = std::find_if(_nodes.begin(), _nodes.end(), [&](auto const& owned_node) {
+        return owned_node.get() == node;
+    });
+    if(it == _nodes.end())
+        return;
+
+    // the node leaves the graph before it is destroyed, disconnecting its ports modifies the graph
+    auto removed_node = std::move(*it);
+    _nodes.erase(it);
+    for(auto const* output : removed_node->outputs())
+        _observer_counts.erase(output);
+    removed_node.reset();
+    modified();
 }
 
 auto graph::nodes() const -> std::vector<std::unique_ptr<clk::node>> const&
@@ -38,4 +66,144 @@ auto graph::timestamp() const -> clk::timestamp
 {
     return _timestamp;
 }
+
+auto graph::last_modification_time() const -> std::chrono::steady_clock::time_point
+{
+    return _last_modification_time;
+}
+
+auto graph::compile() -> clk::execution_plan const&
+{
+    if(_execution_plan.is_outdated(*this))
+        _execution_plan = clk::execution_plan(*this);
+    return _execution_plan;
+}
+
+void graph::set_profiling(bool active)
+{
+    _profiling = active;
+    for(auto const& node : _nodes)
+        node->set_profiling(active);
+}
+
+auto graph::is_profiling() const -> bool
+{
+    return _profiling;
+}
+
+auto graph::statistics() const -> std::vector<clk::node_statistics>
+{
+    std::vector<clk::node_statistics> statistics;
+    statistics.reserve(_nodes.size());
+    for(auto const& node : _nodes)
+    {
+        auto& entry = statistics.emplace_back();
+        entry.node = node.get();
+        entry.update_count = node->update_count();
+        entry.skipped_update_count = node->skipped_update_count();
+        if(auto const* profiler = node->profiler(); profiler != nullptr)
+        {
+            entry.average_update = profiler->average_sample();
+            entry.longest_update = profiler->longest_sample();
+        }
+    }
+
+    ranges::sort(statistics, [](auto const& lhs, auto const& rhs) {
+        return lhs.average_update > rhs.average_update;
+    });
+    return statistics;
+}
+
+void graph::observe(clk::output const& output)
+{
+    if(_observer_counts[&output]++ == 0 && _demand_driven)
+        update_demand();
+}
+
+void graph::unobserve(clk::output const& output)
+{
+    auto it = _observer_counts.find(&output);
+    if(it == _observer_counts.end() || --it->second != 0)
+        return;
+
+    _observer_counts.erase(it);
+    if(_demand_driven)
+        update_demand();
+}
+
+auto graph::is_observed(clk::output const& output) const -> bool
+{
+    return _observer_counts.count(&output) != 0;
+}
+
+void graph::set_demand_driven(bool active)
+{
+    if(_demand_driven == active)
+        return;
+    _demand_driven = active;
+    update_demand();
+}
+
+auto graph::is_demand_driven() const -> bool
+{
+    return _demand_driven;
+}
+
+void graph::watch_port(clk::node& node, clk::port& port)
+{
+    port.set_connection_changed_callback([this]() {
+        modified();
+    });
+    if(auto* input = dynamic_cast<clk::input*>(&port); input != nullptr)
+        input->default_port().set_data_changed_callback([this, node = &node]() {
+            _execution_plan.mark_modified(*node);
+        });
+}
+
+void graph::modified()
+{
+    _timestamp.update();
+    _last_modification_time = std::chrono::steady_clock::now();
+    if(_demand_driven)
+        update_demand();
+}
+
+void graph::update_demand()
+{
+    for(auto const& node : _nodes)
+        node->_demanded = !_demand_driven;
+    if(_demand_driven)
+        demand_observed_dependencies();
+
+    // nodes the plan skipped while they were not demanded are evaluated by its next run
+    for(auto const& node : _nodes)
+        if(node->_demanded && node->_outdated)
+            _execution_plan.mark_modified(*node);
+}
+
+void graph::demand_observed_dependencies()
+{
+    std::unordered_map<clk::output const*, clk::node*> output_owners;
+    for(auto const& node : _nodes)
+        for(auto const* output : node->outputs())
+            output_owners[output] = node.get();
+
+    std::vector<clk::node*> pending;
+    for(auto const& observer_count : _observer_counts)
+        if(auto it = output_owners.find(observer_count.first); it != output_owners.end())
+            pending.push_back(it->second);
+
+    while(!pending.empty())
+    {
+        auto* node = pending.back();
+        pending.pop_back();
+        if(node->_demanded)
+            continue;
+
+        node->_demanded = true;
+        for(auto const* input : node->inputs())
+            if(auto it = output_owners.find(input->connected_output()); it != output_owners.end())
+                pending.push_back(it->second);
+    }
+}
 } // namespace clk
@@ -101,18 +101,40 @@ auto input::connected_output() const -> output*
     return _connection;
 }
 
-void input::set_push_callback(std::function<void(std::weak_ptr<clk::sentinel> const&)> callback) noexcept
+auto input::column_pointer() const noexcept -> void const*
+{
+    if(auto* connection = connected_output(); connection != nullptr)
+        return connection->column_pointer();
+    return default_port().column_pointer();
+}
+
+auto input::column_size() const noexcept -> std::size_t
+{
+    if(auto* connection = connected_output(); connection != nullptr)
+        return connection->column_size();
+    return default_port().column_size();
+}
+
+void input::bind_column_element(std::size_t /*index*/) noexcept
+{
+}
+
+void input::unbind_column_element() noexcept
+{
+}
+
+void input::set_push_callback(std::function<void(clk::sentinel)> callback) noexcept
 {
     _push_callback = std::move(callback);
 }
 
-void input::push(std::weak_ptr<clk::sentinel> const& sentinel) noexcept
+void input::push(clk::sentinel sentinel) noexcept
 {
     if(_push_callback)
         _push_callback(sentinel);
 }
 
-void input::pull(std::weak_ptr<clk::sentinel> const& sentinel) noexcept
+void input::pull(clk::sentinel sentinel) noexcept
 {
     if(auto* connection = connected_output(); connection != nullptr)
     {
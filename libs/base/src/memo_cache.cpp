@@ -0,0 +1,179 @@
+#include "clk/base/memo_cache.hpp"
+#include "clk/base/input.hpp"
+#include "clk/base/output.hpp"
+
+#include <any>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+namespace clk
+{
+namespace
+{
+// the output the input reads its data from
+auto source_of(clk::input const& input) -> clk::output const&
+{
+    return input.connected_output() != nullptr ? *input.connected_output() : input.default_port();
+}
+
+auto key_of(std::vector<clk::input*> const& inputs) -> std::optional<std::size_t>
+{
+    std::size_t key = 0;
+    for(auto const* input : inputs)
+    {
+        auto const hash = source_of(*input).data_hash();
+        if(!hash.has_value())
+            return std::nullopt;
+        key ^= *hash + 0x9e3779b9 + (key << 6) + (key >> 2);
+    }
+    return key;
+}
+} // namespace
+
+memo_cache::memo_cache(std::size_t memory_budget) : _memory_budget(memory_budget)
+{
+}
+
+memo_cache::~memo_cache() = default;
+
+auto memo_cache::restore(std::vector<clk::input*> const& inputs, std::vector<clk::output*> const& outputs) -> bool
+{
+    auto const key = key_of(inputs);
+    if(!key.has_value())
+        return false;
+
+    auto it = find(*key, inputs);
+    if(it == _entries.end() || it->outputs.size() != outputs.size())
+    {
+        _miss_count++;
+        return false;
+    }
+
+    for(std::size_t i = 0; i < outputs.size(); i++)
+        outputs[i]->assign_data(it->outputs[i]);
+    _entries.splice(_entries.begin(), _entries, it);
+    _hit_count++;
+    return true;
+}
+
+void memo_cache::store(std::vector<clk::input*> const& inputs, std::vector<clk::output*> const& outputs)
+{
+    auto const key = key_of(inputs);
+    if(!key.has_value() || find(*key, inputs) != _entries.end())
+        return;
+
+    // the list and index nodes are not counted, the values are
+    entry new_entry{*key, {}, {}, sizeof(entry)};
+    new_entry.inputs.reserve(inputs.size());
+    for(auto const* input : inputs)
+    {
+        auto const& source = source_of(*input);
+        auto copy = source.copy_data();
+        // an input that does not equal itself would never be found again
+        if(!copy.has_value() || !source.data_equals(copy))
+            return;
+        new_entry.size += sizeof(std::any) + source.data_size();
+        new_entry.inputs.push_back(std::move(copy));
+    }
+    new_entry.outputs.reserve(outputs.size());
+    for(auto const* output : outputs)
+    {
+        auto copy = output->copy_data();
+        if(!copy.has_value())
+            return;
+        new_entry.size += sizeof(std::any) + output->data_size();
+        new_entry.outputs.push_back(std::move(copy));
+    }
+
+    if(new_entry.size > _memory_budget)
+        return;
+
+    evict_to(_memory_budget - new_entry.size);
+    _memory_usage += new_entry.size;
+    _entries.push_front(std::move(new_entry));
+    _index.emplace(*key, _entries.begin());
+}
+
+void memo_cache::clear()
+{
+    _entries.clear();
+    _index.clear();
+    _memory_usage = 0;
+}
+
+void memo_cache::set_memory_budget(std::size_t memory_budget)
+{
+    _memory_budget = memory_budget;
+    evict_to(memory_budget);
+}
+
+auto memo_cache::memory_budget() const noexcept -> std::size_t
+{
+    return _memory_budget;
+}
+
+auto memo_cache::memory_usage() const noexcept -> std::size_t
+{
+    return _memory_usage;
+}
+
+auto memo_cache::size() const noexcept -> std::size_t
+{
+    return _entries.size();
+}
+
+auto memo_cache::hit_count() const noexcept -> std::size_t
+{
+    return _hit_count;
+}
+
+auto memo_cache::miss_count() const noexcept -> std::size_t
+{
+    return _miss_count;
+}
+
+void memo_cache::reset_counters() noexcept
+{
+    _hit_count = 0;
+    _miss_count = 0;
+}
+
+auto memo_cache::find(std::size_t key, std::vector<clk::input*> const& inputs) -> std::list<entry>::iterator
+{
+    auto [first, last] = _index.equal_range(key);
+    for(auto it = first; it != last; ++it)
+    {
+        auto const& cached_inputs = it->second->inputs;
+        if(cached_inputs.size() != inputs.size())
+            continue;
+
+        bool equal = true;
+        for(std::size_t i = 0; i < inputs.size() && equal; i++)
+            equal = source_of(*inputs[i]).data_equals(cached_inputs[i]);
+        if(equal)
+            return it->second;
+    }
+    return _entries.end();
+}
+
+void memo_cache::evict_to(std::size_t memory_budget)
+{
+    while(_memory_usage > memory_budget && !_entries.empty())
+    {
+        auto least_recently_used = std::prev(_entries.end());
+        auto [first, last] = _index.equal_range(least_recently_used->key);
+        for(auto it = first; it != last; ++it)
+        {
+            if(it->second == least_recently_used)
+            {
+                _index.erase(it);
+                break;
+            }
+        }
+        _memory_usage -= least_recently_used->size;
+        _entries.erase(least_recently_used);
+    }
+}
+
+} // namespace clk
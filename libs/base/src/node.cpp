@@ -2,11 +2,111 @@
 #include "clk/base/input.hpp"
 #include "clk/base/output.hpp"
 #include "clk/base/sentinel.hpp"
+#include "clk/util/tracer.hpp"
+
+#include <algorithm>
 #include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/algorithm/remove.hpp>
+#include <vector>
 
 namespace clk
 {
+namespace
+{
+// the evaluation that is currently running on this thread, calls made without a sentinel while it runs (e.g. from
+// inside of an update) join it instead of starting a new one, so nodes it already visited are not visited again
+thread_local clk::sentinel running_evaluation;
+
+// ends the update of the outputs even when the update throws, so that no output keeps the copy of its data that it
+// took for early cutoff
+class output_update_scope
+{
+public:
+    output_update_scope() = delete;
+
+    explicit output_update_scope(std::vector<clk::output*> const& outputs) : _outputs(outputs)
+    {
+        for(auto* output_port : _outputs)
+            output_port->begin_update();
+    }
+
+    output_update_scope(output_update_scope const&) = delete;
+    output_update_scope(output_update_scope&&) = delete;
+    auto operator=(output_update_scope const&) -> output_update_scope& = delete;
+    auto operator=(output_update_scope&&) -> output_update_scope& = delete;
+
+    ~output_update_scope()
+    {
+        for(auto* output_port : _outputs)
+            output_port->end_update();
+    }
+
+private:
+    std::vector<clk::output*> const& _outputs;
+};
+} // namespace
+
+node::evaluation::evaluation(clk::sentinel sentinel) noexcept : _origin(!sentinel.is_valid())
+{
+    if(!_origin)
+    {
+        _sentinel = sentinel;
+    }
+    else if(running_evaluation.is_valid())
+    {
+        _sentinel = running_evaluation;
+    }
+    else
+    {
+        _sentinel = clk::sentinel::create();
+        running_evaluation = _sentinel;
+        _owns_running_evaluation = true;
+    }
+}
+
+node::evaluation::~evaluation()
+{
+    if(_owns_running_evaluation)
+        running_evaluation = {};
+}
+
+auto node::evaluation::sentinel() const noexcept -> clk::sentinel
+{
+    return _sentinel;
+}
+
+auto node::evaluation::is_origin() const noexcept -> bool
+{
+    return _origin;
+}
+
+template <typename Function>
+void node::invoke_update(Function&& function)
+{
+    clk::tracer::scope const trace("update", [&]() {
+        return name();
+    });
+
+    _update_count++;
+    if(_profiler != nullptr)
+        _profiler->record_sample_start();
+
+    try
+    {
+        function();
+    }
+    catch(const std::exception& e)
+    {
+        set_error(e.what());
+    }
+    catch(...)
+    {
+        set_error("Unknown error");
+    }
+
+    if(_profiler != nullptr)
+        _profiler->record_sample_end();
+}
 
 auto node::all_ports() const -> std::vector<clk::port*> const&
 {
@@ -23,52 +123,116 @@ auto node::outputs() const -> std::vector<clk::output*> const&
     return _outputs;
 }
 
-void node::pull(std::weak_ptr<clk::sentinel> const& sentinel)
+void node::pull(clk::sentinel sentinel)
 {
-    if(sentinel_present() || !update_possible() || !error().empty())
+    evaluation const current(sentinel);
+    if(_sentinel == current.sentinel() || !update_possible() || !error().empty())
         return;
 
-    std::shared_ptr<clk::sentinel> sentinel_origin;
-    if(sentinel.expired())
-    {
-        sentinel_origin = std::make_shared<clk::sentinel>();
-        _sentinel = sentinel_origin;
-    }
+    clk::tracer::scope const trace("pull", [&]() {
+        return name();
+    });
+    _sentinel = current.sentinel();
+
+    pull_inputs(_sentinel);
+
+    if(current.is_origin() || update_needed())
+        try_update();
     else
+        _skipped_update_count++;
+}
+
+void node::push(clk::sentinel sentinel)
+{
+    evaluation const current(sentinel);
+    if(_sentinel == current.sentinel() || !update_possible())
+        return;
+
+    clk::tracer::scope const trace("push", [&]() {
+        return name();
+    });
+    _sentinel = current.sentinel();
+
+    clear_error();
+
+    if(!_demanded)
     {
-        _sentinel = sentinel;
+        // nothing observed reads the results, the nodes downstream are only marked as well
+        _outdated = true;
+        push_outputs(_sentinel);
+        return;
     }
 
     pull_inputs(_sentinel);
 
-    if(sentinel_origin != nullptr || update_needed())
+    if(current.is_origin() || update_needed())
         try_update();
+    else
+        _skipped_update_count++;
+
+    push_outputs(_sentinel);
 }
 
-void node::push(std::weak_ptr<clk::sentinel> const& sentinel)
+void node::update_if_needed()
 {
-    if(sentinel_present() || !update_possible())
+    if(!update_possible())
         return;
 
-    std::shared_ptr<clk::sentinel> sentinel_origin;
-    if(sentinel.expired())
+    if(!_demanded)
     {
-        sentinel_origin = std::make_shared<clk::sentinel>();
-        _sentinel = sentinel_origin;
+        // like a push, the update is left to the next pull
+        _outdated = update_needed();
+        return;
     }
-    else
+
+    bool const faulty_inputs = ranges::any_of(_inputs, [](auto const* input) {
+        return input->is_faulty();
+    });
+    if(faulty_inputs)
     {
-        _sentinel = sentinel;
+        for(auto* output_port : _outputs)
+            output_port->mark_as_faulty();
+        return;
+    }
+
+    if(!update_needed())
+    {
+        _skipped_update_count++;
+        return;
     }
 
     clear_error();
+    try_update();
+}
 
-    pull_inputs(sentinel);
+void node::update_batch(std::size_t count)
+{
+    if(!update_possible())
+        return;
 
-    if(sentinel_origin != nullptr || update_needed())
-        try_update();
+    bool const faulty_inputs = ranges::any_of(_inputs, [](auto const* input) {
+        return input->is_faulty();
+    });
+    if(faulty_inputs)
+    {
+        for(auto* output_port : _outputs)
+            output_port->mark_as_faulty();
+        return;
+    }
 
-    push_outputs(sentinel);
+    bool const short_columns = ranges::any_of(_inputs, [&](auto const* input) {
+        return input->column_pointer() != nullptr && input->column_size() < count;
+    });
+    if(short_columns)
+    {
+        set_error("Input column is shorter than the batch");
+        return;
+    }
+
+    clear_error();
+    invoke_update([&]() {
+        process_batch(count);
+    });
 }
 
 auto node::has_inputs() const -> bool
@@ -86,6 +250,50 @@ auto node::error() const -> std::string const&
     return _last_error_message;
 }
 
+void node::set_profiling(bool active)
+{
+    if(active && _profiler == nullptr)
+        _profiler = std::make_unique<clk::profiler>();
+    if(_profiler != nullptr)
+        _profiler->set_active(active);
+}
+
+auto node::is_profiling() const -> bool
+{
+    return _profiler != nullptr && _profiler->is_active();
+}
+
+auto node::profiler() const -> clk::profiler const*
+{
+    return _profiler.get();
+}
+
+auto node::update_count() const -> std::size_t
+{
+    return _update_count;
+}
+
+auto node::skipped_update_count() const -> std::size_t
+{
+    return _skipped_update_count;
+}
+
+void node::reset_update_counts()
+{
+    _update_count = 0;
+    _skipped_update_count = 0;
+}
+
+auto node::is_demanded() const -> bool
+{
+    return _demanded;
+}
+
+auto node::is_outdated() const -> bool
+{
+    return _outdated;
+}
+
 void node::clear_error()
 {
     _last_error_message.clear();
@@ -110,6 +318,8 @@ void node::register_port(clk::input* input)
 
     _ports.push_back(input);
     _inputs.push_back(input);
+    if(_port_registered_callback)
+        _port_registered_callback(*input);
 }
 
 void node::register_port(clk::output* output)
@@ -120,18 +330,24 @@ void node::register_port(clk::output* output)
 
     _ports.push_back(output);
     _outputs.push_back(output);
+    if(_port_registered_callback)
+        _port_registered_callback(*output);
 }
 
 void node::unregister_port(clk::input* input)
 {
     _ports.erase(ranges::remove(_ports, input), _ports.end());
     _inputs.erase(ranges::remove(_inputs, input), _inputs.end());
+    if(_port_unregistered_callback)
+        _port_unregistered_callback(*input);
 }
 
 void node::unregister_port(clk::output* output)
 {
     _ports.erase(ranges::remove(_ports, output), _ports.end());
     _outputs.erase(ranges::remove(_outputs, output), _outputs.end());
+    if(_port_unregistered_callback)
+        _port_unregistered_callback(*output);
 }
 
 auto node::update_possible() const -> bool
@@ -143,7 +359,12 @@ void node::update()
 {
 }
 
-void node::pull_inputs(std::weak_ptr<clk::sentinel> const& sentinel)
+void node::process_batch(std::size_t /*count*/)
+{
+    update();
+}
+
+void node::pull_inputs(clk::sentinel sentinel)
 {
     for(auto* input_port : _inputs)
     {
@@ -159,43 +380,39 @@ void node::pull_inputs(std::weak_ptr<clk::sentinel> const& sentinel)
     }
 }
 
-void node::push_outputs(std::weak_ptr<clk::sentinel> const& sentinel)
+void node::push_outputs(clk::sentinel sentinel)
 {
     for(auto* output_port : _outputs)
         output_port->push(sentinel);
 }
 
-auto node::sentinel_present() const -> bool
-{
-    return !_sentinel.expired();
-}
-
 auto node::update_needed() const -> bool
 {
-    if(!has_inputs() || !has_outputs())
+    if(_outdated || !has_inputs() || !has_outputs())
         return true;
 
     return ranges::any_of(outputs(), [&](auto const* output) {
-        return ranges::any_of(inputs(), [&output](auto const* input) {
-            return input->timestamp() > output->timestamp();
+        if(output->timestamp().is_reset())
+            return true;
+
+        // outputs with early cutoff can be older than the last update that wrote them
+        auto const last_change = std::max(output->timestamp(), _last_update_timestamp);
+        return ranges::any_of(inputs(), [&last_change](auto const* input) {
+            return input->timestamp() > last_change;
         });
     });
 }
 
 void node::try_update()
 {
-    try
-    {
+    _outdated = false;
+    invoke_update([&]() {
+        output_update_scope const output_update(_outputs);
         update();
-    }
-    catch(const std::exception& e)
-    {
-        set_error(e.what());
-    }
-    catch(...)
-    {
-        set_error("Unknown error");
-    }
+    });
+
+    if(error().empty())
+        _last_update_timestamp.update();
 }
 
 } // namespace clk
@@ -1,6 +1,7 @@
 #include "clk/base/output.hpp"
 #include "clk/base/input.hpp"
 
+#include <any>
 #include <range/v3/algorithm/any_of.hpp>
 #include <stdexcept>
 #include <utility>
@@ -77,19 +78,85 @@ auto output::connected_inputs() const -> std::vector<input*> const&
     return _cached_connected_inputs;
 }
 
-void output::push(std::weak_ptr<clk::sentinel> const& sentinel) noexcept
+auto output::column_pointer() const noexcept -> void const*
+{
+    return nullptr;
+}
+
+auto output::column_size() const noexcept -> std::size_t
+{
+    return 0;
+}
+
+void output::resize_column(std::size_t /*size*/)
+{
+}
+
+void output::store_column_element(std::size_t /*index*/) noexcept
+{
+}
+
+auto output::create_copy() const -> std::unique_ptr<output>
+{
+    return nullptr;
+}
+
+auto output::copy_data() const -> std::any
+{
+    return {};
+}
+
+auto output::assign_data(std::any const& /*data*/) -> bool
+{
+    return false;
+}
+
+auto output::data_equals(std::any const& /*data*/) const -> bool
+{
+    return false;
+}
+
+auto output::data_hash() const -> std::optional<std::size_t>
+{
+    return std::nullopt;
+}
+
+auto output::data_size() const -> std::size_t
+{
+    return 0;
+}
+
+void output::set_early_cutoff(bool early_cutoff) noexcept
+{
+    _early_cutoff = early_cutoff;
+}
+
+auto output::has_early_cutoff() const noexcept -> bool
+{
+    return _early_cutoff;
+}
+
+void output::begin_update()
+{
+}
+
+void output::end_update()
+{
+}
+
+void output::push(clk::sentinel sentinel) noexcept
 {
     for(auto* connection : connected_inputs())
         connection->push(sentinel);
 }
 
-void output::pull(std::weak_ptr<clk::sentinel> const& sentinel) noexcept
+void output::pull(clk::sentinel sentinel) noexcept
 {
     if(_pull_callback)
         _pull_callback(sentinel);
 }
 
-void output::set_pull_callback(std::function<void(std::weak_ptr<clk::sentinel> const&)> callback) noexcept
+void output::set_pull_callback(std::function<void(clk::sentinel)> callback) noexcept
 {
     _pull_callback = std::move(callback);
 }
@@ -18,4 +18,10 @@ void passthrough_node::update()
     _out.set_data(_in.data_pointer(), _in.data_type_hash());
 }
 
+void passthrough_node::process_batch(std::size_t /*count*/)
+{
+    update();
+    _out.set_column(_in.column_pointer(), _in.column_size());
+}
+
 } // namespace clk
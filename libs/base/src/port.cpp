@@ -23,6 +23,13 @@ auto port::name() const noexcept -> std::string_view
 void port::update_timestamp() noexcept
 {
     _timestamp.update();
+    if(_data_changed_callback)
+        _data_changed_callback();
+}
+
+void port::set_timestamp(clk::timestamp timestamp) noexcept
+{
+    _timestamp = timestamp;
 }
 
 void port::mark_as_faulty() const noexcept
@@ -40,6 +47,11 @@ void port::set_connection_changed_callback(std::function<void()> const& callback
     _connection_changed_callback = callback;
 }
 
+void port::set_data_changed_callback(std::function<void()> const& callback)
+{
+    _data_changed_callback = callback;
+}
+
 auto port::timestamp() const noexcept -> clk::timestamp
 {
     return _timestamp;
@@ -0,0 +1,33 @@
+#include "clk/base/sentinel.hpp"
+
+#include <atomic>
+
+namespace clk
+{
+
+sentinel::sentinel(std::uint64_t generation) noexcept : _generation(generation)
+{
+}
+
+auto sentinel::create() noexcept -> sentinel
+{
+    static std::atomic<std::uint64_t> last_generation = 0;
+    return sentinel(last_generation.fetch_add(1, std::memory_order_relaxed) + 1);
+}
+
+auto sentinel::is_valid() const noexcept -> bool
+{
+    return _generation != 0;
+}
+
+auto sentinel::operator==(sentinel const& other) const noexcept -> bool
+{
+    return _generation == other._generation;
+}
+
+auto sentinel::operator!=(sentinel const& other) const noexcept -> bool
+{
+    return !(*this == other);
+}
+
+} // namespace clk
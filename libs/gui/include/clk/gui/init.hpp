@@ -8,4 +8,11 @@ class widget_factory;
 
 auto create_default_factory() -> std::shared_ptr<widget_factory>;
 void draw();
+// widgets that change without any input, like animations or results arriving in the background, request the next
+// frame with this, so the application can stop drawing while nothing changes
+void request_redraw();
+// whether a redraw was requested since the last call
+auto take_redraw_request() -> bool;
+// called by request_redraw, from any thread, to wake up the application while it waits for input, nullptr removes it
+void set_redraw_wakeup(void (*wakeup)());
 } // namespace clk::gui
\ No newline at end of file
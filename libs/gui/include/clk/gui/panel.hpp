@@ -31,6 +31,8 @@ public:
     };
 
     static void orphan(panel&& panel);
+    // the widgets of orphaned panels may refer to data that is destroyed before them, e.g. graph editors
+    static void delete_orphans();
 
     template <typename... Args>
     static void create_orphan(Args... args)
@@ -1,5 +1,6 @@
 #pragma once
 #include "clk/gui/widgets/editor.hpp"
+#include "clk/util/timestamp.hpp"
 #include "node_editors.hpp"
 #include "port_editors.hpp"
 
@@ -7,6 +8,8 @@
 #include <memory>
 #include <optional>
 #include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -14,6 +17,7 @@ struct ImNodesEditorContext;
 
 namespace clk
 {
+class evaluation_service;
 class graph;
 class input;
 class node;
@@ -28,6 +32,8 @@ class widget_cache;
 template <bool ConstData>
 class selection_manager;
 class layout_solver;
+class level_of_detail;
+class evaluation_view;
 } // namespace clk::gui::impl
 
 namespace clk::gui
@@ -64,24 +70,54 @@ private:
     std::unique_ptr<impl::widget_cache<clk::node, impl::node_editor>> _node_cache;
     std::unique_ptr<impl::widget_cache<clk::port, impl::port_editor>> _port_cache;
     mutable std::vector<std::pair<clk::input*, clk::output*>> _connections;
+    mutable std::unordered_map<clk::port const*, clk::node*> _port_owners;
+    mutable clk::timestamp _port_owners_timestamp;
+    mutable clk::timestamp _widget_caches_timestamp;
+    mutable std::vector<clk::node*> _drawn_nodes;
+    mutable std::unordered_set<clk::node const*> _drawn_node_set;
+    mutable std::unordered_set<clk::output const*> _observed_outputs;
     std::unique_ptr<impl::selection_manager<false>> _selection_manager;
     mutable std::optional<connection_change> _new_connection_in_progress = std::nullopt;
     mutable std::optional<std::function<bool()>> _queued_action = std::nullopt;
     mutable bool _context_menu_queued = false;
     std::unique_ptr<impl::layout_solver> _layout_solver;
+    std::unique_ptr<impl::level_of_detail> _level_of_detail;
+    mutable std::shared_ptr<clk::evaluation_service> _evaluation_service;
+    // the editor observes outputs of the graph and may change how it is evaluated until it is released
+    mutable clk::graph* _evaluated_graph = nullptr;
+    mutable std::optional<bool> _graph_was_demand_driven = std::nullopt;
+    std::unique_ptr<impl::evaluation_view> _evaluation_view;
     bool _draw_node_titles = true;
     bool _draw_port_widgets = true;
     bool _enable_layout_solver = true;
+    bool _cull_off_screen_nodes = true;
+    bool _evaluate_on_demand = true;
     mutable bool _centering_queued = true;
     mutable bool _clear_connections_queued = false;
     mutable bool _randomize_connections_queued = false;
     mutable bool _add_random_node_queued = false;
+    mutable bool _auto_layout_queued = false;
 
+    // removes the widgets of nodes and ports that are not part of the graph anymore
+    void remove_stale_widgets(clk::graph const& graph) const;
     void draw_graph(clk::graph& graph) const;
+    // picks the nodes that are visible in the editor, plus the nodes at the other end of their links
+    void select_drawn_nodes(clk::graph const& graph) const;
+    // observes the outputs of the nodes on screen, so the graph only evaluates what is shown
+    void observe_drawn_outputs(clk::graph& graph) const;
+    // unobserves the outputs and restores the evaluation mode, the graph has to be alive still
+    void release_evaluated_graph() const;
     void draw_menus(clk::graph& graph) const;
     void update_connections(clk::graph& graph) const;
     void handle_mouse_interactions(clk::graph& graph) const;
     void restore_dropped_connection() const;
+    // the editor's own modifications are reported to the layout solver, so it only updates what they touch
+    void add_node(clk::graph& graph, std::unique_ptr<clk::node>&& node) const;
+    void remove_node(clk::graph& graph, clk::node* node) const;
+    void change_connection(clk::port& first, clk::port& second, bool connect) const;
+    // connections are changed without notifying the ports, the input is pushed like any other evaluation
+    void evaluate_connection_change(clk::port& first, clk::port& second) const;
     void run_layout_solver(clk::graph const& graph) const;
+    void run_auto_layout(clk::graph const& graph) const;
 };
 } // namespace clk::gui
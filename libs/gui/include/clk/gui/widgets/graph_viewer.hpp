@@ -1,6 +1,7 @@
 #pragma once
 
 #include "clk/gui/widgets/viewer.hpp"
+#include "clk/util/timestamp.hpp"
 #include "node_viewers.hpp"
 #include "port_viewers.hpp"
 
@@ -27,6 +28,8 @@ class widget_cache;
 template <bool ConstData>
 class selection_manager;
 class layout_solver;
+class level_of_detail;
+class evaluation_view;
 } // namespace clk::gui::impl
 
 namespace clk::gui
@@ -56,13 +59,18 @@ private:
     std::unique_ptr<impl::widget_cache<clk::node const, impl::node_viewer>> _node_cache;
     std::unique_ptr<impl::widget_cache<clk::port const, impl::port_viewer>> _port_cache;
     mutable std::vector<std::pair<clk::input const*, clk::output const*>> _connections;
+    mutable clk::timestamp _widget_caches_timestamp;
     std::unique_ptr<impl::selection_manager<true>> _selection_manager;
     std::unique_ptr<impl::layout_solver> _layout_solver;
+    std::unique_ptr<impl::level_of_detail> _level_of_detail;
+    std::unique_ptr<impl::evaluation_view> _evaluation_view;
     bool _draw_port_widgets = true;
     bool _draw_node_titles = true;
     bool _enable_layout_solver = true;
     mutable bool _centering_queued = true;
 
+    // removes the widgets of nodes and ports that are not part of the graph anymore
+    void remove_stale_widgets(clk::graph const& graph) const;
     void draw_graph(clk::graph const& graph) const;
     void run_layout_solver(clk::graph const& graph) const;
 };
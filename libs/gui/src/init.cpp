@@ -12,6 +12,7 @@
 #include "clk/util/profiler.hpp"
 #include "clk/util/type_list.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <glm/glm.hpp>
 #include <imgui.h>
@@ -33,6 +34,12 @@ class bounded;
 
 namespace clk::gui
 {
+namespace
+{
+// set from other threads as well
+std::atomic<bool> redraw_requested{false}; // NOLINT
+std::atomic<void (*)()> redraw_wakeup{nullptr}; // NOLINT
+} // namespace
 
 template <typename DataType>
 class editor_of;
@@ -143,4 +150,25 @@ void draw()
 
     panel::_queued_actions.clear();
 }
+
+void request_redraw()
+{
+    // only the first request wakes up the application, the others are handled by the same frame
+    if(!redraw_requested.exchange(true))
+    {
+        if(auto* wakeup = redraw_wakeup.load(); wakeup != nullptr)
+            wakeup();
+    }
+}
+
+auto take_redraw_request() -> bool
+{
+    return redraw_requested.exchange(false);
+}
+
+void set_redraw_wakeup(void (*wakeup)())
+{
+    redraw_wakeup = wakeup;
+}
+
 } // namespace clk::gui
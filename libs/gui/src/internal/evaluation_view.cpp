@@ -0,0 +1,134 @@
+#include "evaluation_view.hpp"
+#include "clk/base/graph.hpp"
+#include "clk/base/node.hpp"
+#include "clk/base/port.hpp"
+#include "clk/gui/init.hpp"
+
+#include <unordered_map>
+#include <utility>
+
+namespace clk::gui::impl
+{
+namespace
+{
+// only touched while drawing, so it needs no lock
+std::unordered_map<clk::graph const*, std::weak_ptr<clk::evaluation_service>> evaluation_services; // NOLINT
+} // namespace
+
+auto evaluation_service_for(clk::graph const& graph) -> std::shared_ptr<clk::evaluation_service>
+{
+    if(auto service = find_evaluation_service(graph); service != nullptr)
+        return service;
+
+    for(auto it = evaluation_services.begin(); it != evaluation_services.end();)
+    {
+        if(it->second.expired())
+            it = evaluation_services.erase(it);
+        else
+            ++it;
+    }
+
+    auto service = std::make_shared<clk::evaluation_service>(graph);
+    service->set_published_callback(&request_redraw);
+    evaluation_services[&graph] = service;
+    return service;
+}
+
+auto find_evaluation_service(clk::graph const& graph) -> std::shared_ptr<clk::evaluation_service>
+{
+    if(auto it = evaluation_services.find(&graph); it != evaluation_services.end())
+        return it->second.lock();
+    return nullptr;
+}
+
+void evaluation_view::begin_frame(std::shared_ptr<clk::evaluation_service> service)
+{
+    _service = std::move(service);
+    _snapshot = nullptr;
+    if(_service == nullptr)
+        return;
+
+    _lock = _service->try_lock();
+    if(!_lock.owns_lock())
+        _snapshot = _service->published_snapshot();
+}
+
+void evaluation_view::end_frame()
+{
+    if(_lock.owns_lock())
+        _lock.unlock();
+    _lock = {};
+}
+
+auto evaluation_view::is_live() const -> bool
+{
+    return _snapshot == nullptr;
+}
+
+auto evaluation_view::is_busy() const -> bool
+{
+    return _service != nullptr && _service->is_busy();
+}
+
+auto evaluation_view::queued_request_count() const -> std::size_t
+{
+    return _service != nullptr ? _service->queued_request_count() : 0;
+}
+
+auto evaluation_view::data_pointer(clk::port const& port) const -> void const*
+{
+    return is_live() ? port.data_pointer() : _snapshot->data_pointer(port);
+}
+
+auto evaluation_view::error(clk::node const& node) const -> std::string const&
+{
+    return is_live() ? node.error() : _snapshot->error(node);
+}
+
+auto evaluation_view::is_faulty(clk::port const& port) const -> bool
+{
+    return is_live() ? port.is_faulty() : _snapshot->is_faulty(port);
+}
+
+auto evaluation_view::is_evaluating(clk::node const& node) const -> bool
+{
+    return _service != nullptr && _service->is_evaluating(node);
+}
+
+void evaluation_view::pull(clk::node& node) const
+{
+    if(_service != nullptr)
+        _service->queue_pull(node);
+    else
+        node.pull();
+}
+
+void evaluation_view::push(clk::node& node) const
+{
+    if(_service != nullptr)
+        _service->queue_push(node);
+    else
+        node.push();
+}
+
+void evaluation_view::push(clk::port& port) const
+{
+    if(_service != nullptr)
+        _service->queue_push(port);
+    else
+        port.push();
+}
+
+void evaluation_view::cancel(clk::node const& node) const
+{
+    if(_service != nullptr)
+        _service->cancel(node);
+}
+
+void evaluation_view::cancel(clk::port const& port) const
+{
+    if(_service != nullptr)
+        _service->cancel(port);
+}
+
+} // namespace clk::gui::impl
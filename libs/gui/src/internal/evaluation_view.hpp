@@ -0,0 +1,62 @@
+#pragma once
+
+#include "clk/base/evaluation_service.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace clk
+{
+class graph;
+class node;
+class port;
+} // namespace clk
+
+namespace clk::gui::impl
+{
+// every widget of a graph shares the same service, it lives as long as one of them holds it
+auto evaluation_service_for(clk::graph const& graph) -> std::shared_ptr<clk::evaluation_service>;
+// nullptr if no editor evaluates the graph in the background
+auto find_evaluation_service(clk::graph const& graph) -> std::shared_ptr<clk::evaluation_service>;
+
+// What the widgets of a graph read while they are drawn. A frame holds the lock of the evaluation service if the worker
+// is idle and reads the graph directly, otherwise it reads the last published snapshot and must not modify the graph.
+class evaluation_view
+{
+public:
+    evaluation_view() = default;
+    evaluation_view(evaluation_view const&) = delete;
+    evaluation_view(evaluation_view&&) = delete;
+    auto operator=(evaluation_view const&) -> evaluation_view& = delete;
+    auto operator=(evaluation_view&&) -> evaluation_view& = delete;
+    ~evaluation_view() = default;
+
+    void begin_frame(std::shared_ptr<clk::evaluation_service> service);
+    void end_frame();
+    // whether the graph can be read and modified directly in this frame
+    auto is_live() const -> bool;
+    auto is_busy() const -> bool;
+    auto queued_request_count() const -> std::size_t;
+
+    auto data_pointer(clk::port const& port) const -> void const*;
+    auto error(clk::node const& node) const -> std::string const&;
+    auto is_faulty(clk::port const& port) const -> bool;
+    auto is_evaluating(clk::node const& node) const -> bool;
+
+    // run on the worker of the service if there is one, right away otherwise
+    void pull(clk::node& node) const;
+    void push(clk::node& node) const;
+    void push(clk::port& port) const;
+    // has to be called before the node or port is removed
+    void cancel(clk::node const& node) const;
+    void cancel(clk::port const& port) const;
+
+private:
+    std::shared_ptr<clk::evaluation_service> _service;
+    std::unique_lock<std::mutex> _lock;
+    std::shared_ptr<clk::evaluation_service::snapshot const> _snapshot;
+};
+
+} // namespace clk::gui::impl
@@ -4,11 +4,17 @@
 #include "clk/gui/widgets/widget.hpp"
 #include "clk/gui/widgets/widget_factory.hpp"
 #include "clk/gui/widgets/widget_tree.hpp"
+#include "node_editors.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
 #include <imgui.h>
 #include <imnodes.h>
 #include <ratio>
+#include <utility>
+#include <vector>
 
 namespace clk::gui::impl
 {
@@ -32,6 +38,7 @@ void layout_solver::register_settings(widget_tree& settings, widget_factory cons
         parameters.add(f.create(_mouse_influence_radius, "Mouse influence radius"));
         parameters.add(f.create(_time_multiplier, "Time multiplier"));
         parameters.add(f.create(_repulsion_intensity_multiplier, "Repulsion intensity"));
+        parameters.add(f.create(_repulsion_cell_size_multiplier, "Repulsion cell size"));
         parameters.add(f.create(_attraction_intensity_multiplier, "Attraction intensity"));
     }
     {
@@ -46,6 +53,59 @@ void layout_solver::register_settings(widget_tree& settings, widget_factory cons
     }
 }
 
+void layout_solver::node_removed(clk::timestamp previous_graph_timestamp, clk::graph const& graph,
+    clk::node const* node, std::vector<clk::port*> const& ports)
+{
+    if(_cached_graph_timestamp != previous_graph_timestamp)
+        return;
+
+    auto node_it = _node_indices.find(node);
+    if(node_it == _node_indices.end())
+        return;
+
+    _profilers[profiler_update_cache].record_sample_start();
+    std::size_t const node_index = node_it->second;
+    _node_indices.erase(node_it);
+
+    std::vector<std::size_t> removed_ports;
+    removed_ports.reserve(ports.size());
+    for(auto* port : ports)
+        removed_ports.push_back(_port_indices.at(port));
+
+    // the removal disconnected the ports from the ports of the other nodes
+    for(auto port_index : removed_ports)
+    {
+        auto& port = _ports[port_index];
+        for(std::size_t i = 0; i < port.connection_count; i++)
+        {
+            auto const connected_port_index = _connections[port.first_connection + i];
+            if(_ports[connected_port_index].parent_node_index != node_index)
+                remove_connection(connected_port_index, port_index);
+        }
+        _connection_count -= port.connection_count;
+        port.connection_count = 0;
+    }
+
+    // removing the highest index first keeps the indices of the other removed ports valid
+    std::sort(removed_ports.begin(), removed_ports.end(), std::greater<>());
+    for(auto port_index : removed_ports)
+        remove_port(port_index);
+
+    std::size_t const last_node_index = _nodes.size() - 1;
+    if(node_index != last_node_index)
+    {
+        _nodes[node_index] = _nodes[last_node_index];
+        _node_indices[_nodes[node_index].node] = node_index;
+        for(auto* port : _nodes[node_index].node->all_ports())
+            _ports[_port_indices.at(port)].parent_node_index = node_index;
+    }
+    _nodes.pop_back();
+
+    _cached_graph_timestamp = graph.timestamp();
+    _settled = false;
+    _profilers[profiler_update_cache].record_sample_end();
+}
+
 void layout_solver::step()
 {
     _profilers[profiler_step].record_sample_start();
@@ -80,12 +140,72 @@ void layout_solver::step()
     _profilers[profiler_step].record_sample_end();
 }
 
+auto layout_solver::is_settled() const -> bool
+{
+    return _settled;
+}
+
+void layout_solver::pack_connections()
+{
+    std::vector<std::size_t> packed_connections;
+    packed_connections.reserve(_connection_count);
+    for(auto& port : _ports)
+    {
+        auto const first_connection = _connections.begin() + static_cast<std::ptrdiff_t>(port.first_connection);
+        port.first_connection = packed_connections.size();
+        port.connection_capacity = port.connection_count;
+        packed_connections.insert(packed_connections.end(), first_connection,
+            first_connection + static_cast<std::ptrdiff_t>(port.connection_count));
+    }
+    _connections = std::move(packed_connections);
+}
+
+void layout_solver::remove_connection(std::size_t port_index, std::size_t connected_port_index)
+{
+    auto& port = _ports[port_index];
+    auto const first = _connections.begin() + static_cast<std::ptrdiff_t>(port.first_connection);
+    auto const last = first + static_cast<std::ptrdiff_t>(port.connection_count);
+    auto it = std::find(first, last, connected_port_index);
+    if(it == last)
+        return;
+
+    *it = *(last - 1);
+    port.connection_count--;
+    _connection_count--;
+}
+
+// moves the last port into the place of the removed one, which has no connections left
+void layout_solver::remove_port(std::size_t port_index)
+{
+    _port_indices.erase(_ports[port_index].port);
+    std::size_t const last_port_index = _ports.size() - 1;
+    if(port_index != last_port_index)
+    {
+        auto& port = _ports[port_index];
+        port = _ports[last_port_index];
+        _port_indices[port.port] = port_index;
+        for(std::size_t i = 0; i < port.connection_count; i++)
+        {
+            auto& connected_port = _ports[_connections[port.first_connection + i]];
+            auto const first = _connections.begin() + static_cast<std::ptrdiff_t>(connected_port.first_connection);
+            std::replace(first, first + static_cast<std::ptrdiff_t>(connected_port.connection_count),
+                last_port_index, port_index);
+        }
+    }
+    _ports.pop_back();
+}
+
 auto layout_solver::calculate_force(float ideal_distance, float distance) -> float
 {
     float force = ideal_distance - distance;
     return (force < 0 ? -1.0f : 1.0f) * force * force;
 }
 
+auto layout_solver::dimensions_of(node_representation const& node) -> glm::vec2
+{
+    return node.editor != nullptr ? node.editor->dimensions() : to_glm(ImNodes::GetNodeDimensions(node.id));
+}
+
 void layout_solver::update_nodes_from_gui()
 {
     _profilers[profiler_read_from_gui].record_sample_start();
@@ -95,8 +215,9 @@ void layout_solver::update_nodes_from_gui()
 
     for(auto& node : _nodes)
     {
-        glm::vec2 dim = to_glm(ImNodes::GetNodeDimensions(node.id));
-        glm::vec2 pos = to_glm(ImNodes::GetNodeGridSpacePos(node.id));
+        glm::vec2 dim = dimensions_of(node);
+        glm::vec2 pos = node.editor != nullptr ? node.editor->grid_position()
+                                               : to_glm(ImNodes::GetNodeGridSpacePos(node.id));
         pos += dim / 2.0f;
         if(_queue_gather)
         {
@@ -112,34 +233,103 @@ void layout_solver::update_nodes_from_gui()
         node.collision_sphere_centres[0][long_axis] -= dim[long_axis] / 4.0f;
         node.collision_sphere_centres[1][long_axis] += dim[long_axis] / 4.0f;
 
-        node.mass = dim.x * dim.y / 100.0f;
+        // nodes that were never drawn have no size yet, dividing by a mass of zero would fling them away
+        node.mass = std::max(dim.x * dim.y / 100.0f, 1.0f);
         node.velocity = glm::vec2{0.0f};
     }
     _queue_gather = false;
+
+    // the ports are laid out differently while their node is drawn without its port widgets
+    for(auto& port : _ports)
+    {
+        auto const& node = _nodes[port.parent_node_index];
+        if(port.position != nullptr &&
+            (node.editor == nullptr || (node.editor->is_drawn() && node.editor->is_on_screen())))
+            port.offset =
+                *port.position - to_glm(ImNodes::GetNodeScreenSpacePos(node.id)) - dimensions_of(node) / 2.0f;
+    }
     _profilers[profiler_read_from_gui].record_sample_end();
 }
 
 void layout_solver::calculate_repulsion()
 {
     _profilers[profiler_repulsion].record_sample_start();
-    for(auto node1 = _nodes.begin(); node1 != _nodes.end(); ++node1)
+
+    // collision spheres only repel each other while closer than twice the sum of their radii, so with cells at least
+    // that large, every sphere only has to be checked against the spheres in the cells around its own
+    float largest_radius = 0.0f;
+    for(auto const& node : _nodes)
+        largest_radius = std::max(largest_radius, node.collision_sphere_radius);
+    float const cell_size = std::max(largest_radius * 4.0f * _repulsion_cell_size_multiplier, 1.0f);
+
+    // far away cells are merged, so that converting them and looking at their neighbours does not overflow
+    auto cell_coordinate = [&](float position) {
+        float const limit = 1 << 30;
+        return static_cast<std::int32_t>(std::clamp(std::floor(position / cell_size), -limit, limit));
+    };
+    auto cell_coordinates = [&](glm::vec2 position) {
+        return std::pair{cell_coordinate(position.x), cell_coordinate(position.y)};
+    };
+    auto cell_key = [](std::int32_t x, std::int32_t y) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+    };
+
+    _collision_spheres.clear();
+    for(std::size_t node_index = 0; node_index < _nodes.size(); node_index++)
+    {
+        for(auto const& centre : _nodes[node_index].collision_sphere_centres)
+        {
+            // a node that was moved to an invalid position by the user or a bad step has no cell
+            if(!std::isfinite(centre.x) || !std::isfinite(centre.y))
+                continue;
+            auto [x, y] = cell_coordinates(centre);
+            _collision_spheres.push_back({cell_key(x, y), node_index, centre});
+        }
+    }
+    std::sort(_collision_spheres.begin(), _collision_spheres.end(), [](auto const& lhs, auto const& rhs) {
+        return lhs.cell < rhs.cell;
+    });
+
+    struct cell_less
     {
-        for(auto node2 = node1 + 1; node2 != _nodes.end(); ++node2)
+        auto operator()(collision_sphere const& sphere, std::uint64_t cell) const -> bool
+        {
+            return sphere.cell < cell;
+        }
+        auto operator()(std::uint64_t cell, collision_sphere const& sphere) const -> bool
         {
-            for(auto& collision_sphere_node1 : node1->collision_sphere_centres)
+            return cell < sphere.cell;
+        }
+    };
+
+    for(auto const& sphere1 : _collision_spheres)
+    {
+        auto& node1 = _nodes[sphere1.node_index];
+        auto [x, y] = cell_coordinates(sphere1.centre);
+        for(std::int32_t dx = -1; dx <= 1; dx++)
+        {
+            for(std::int32_t dy = -1; dy <= 1; dy++)
             {
-                for(auto& collision_sphere_node2 : node2->collision_sphere_centres)
+                auto [first, last] = std::equal_range(
+                    _collision_spheres.begin(), _collision_spheres.end(), cell_key(x + dx, y + dy), cell_less{});
+                for(auto sphere2 = first; sphere2 != last; ++sphere2)
                 {
-                    auto dir = collision_sphere_node2 - collision_sphere_node1;
+                    // every pair of nodes is handled once, from the node that comes first
+                    if(sphere2->node_index <= sphere1.node_index)
+                        continue;
+
+                    auto& node2 = _nodes[sphere2->node_index];
+                    auto dir = sphere2->centre - sphere1.centre;
                     float distance = glm::length(dir);
-                    const float ideal_distance = (node1->collision_sphere_radius + node2->collision_sphere_radius) * 2;
+                    const float ideal_distance = (node1.collision_sphere_radius + node2.collision_sphere_radius) * 2;
                     if(distance < ideal_distance)
                     {
-                        dir /= distance;
+                        // spheres at the same position, e.g. after gathering the nodes, are pushed apart sideways
+                        dir = distance > 0.0f ? dir / distance : glm::vec2{1.0f, 0.0f};
                         float force = calculate_force(ideal_distance, distance) * _repulsion_intensity_multiplier;
 
-                        node1->velocity -= dir * force / node1->mass;
-                        node2->velocity += dir * force / node2->mass;
+                        node1.velocity -= dir * force / node1.mass;
+                        node2.velocity += dir * force / node2.mass;
                     }
                 }
             }
@@ -151,17 +341,23 @@ void layout_solver::calculate_repulsion()
 void layout_solver::calculate_attraction()
 {
     _profilers[profiler_attraction].record_sample_start();
-    for(auto const& port1 : _ports)
+    for(std::size_t port1_index = 0; port1_index < _ports.size(); port1_index++)
     {
+        auto const& port1 = _ports[port1_index];
         auto& node1 = _nodes[port1.parent_node_index];
-        for(std::size_t port2_index : port1.connected_port_indices)
+        for(std::size_t i = port1.first_connection; i < port1.first_connection + port1.connection_count; i++)
         {
-            auto const& port2 = _ports[port2_index];
+            // both ports store the connection, it is handled from the one that comes second
+            if(_connections[i] > port1_index)
+                continue;
+            auto const& port2 = _ports[_connections[i]];
             auto& node2 = _nodes[port2.parent_node_index];
 
-            auto port1_to_port2 = *port2.position - *port1.position;
+            auto port1_to_port2 = (node2.position + port2.offset) - (node1.position + port1.offset);
             float distance = glm::length(port1_to_port2);
             const float ideal_distance = 0;
+            if(distance <= ideal_distance)
+                continue;
             port1_to_port2 /= distance;
             float force = calculate_force(ideal_distance, distance) * _attraction_intensity_multiplier;
 
@@ -176,6 +372,7 @@ void layout_solver::integrate(float seconds_elapsed)
 {
     _profilers[profiler_integration].record_sample_start();
     seconds_elapsed *= _time_multiplier;
+    _settled = true;
     for(auto& node : _nodes)
     {
         auto position_difference = node.velocity * seconds_elapsed;
@@ -192,7 +389,10 @@ void layout_solver::integrate(float seconds_elapsed)
         }
 
         if(glm::length(position_difference) > 0.1f)
+        {
             node.position += position_difference;
+            _settled = false;
+        }
     }
     _profilers[profiler_integration].record_sample_end();
 }
@@ -202,8 +402,11 @@ void layout_solver::write_out_results() const
     _profilers[profiler_write_to_gui].record_sample_start();
     for(auto const& node : _nodes)
     {
-        glm::vec2 dim = to_glm(ImNodes::GetNodeDimensions(node.id));
-        ImNodes::SetNodeGridSpacePos(node.id, to_imgui(node.position - dim / 2.0f));
+        glm::vec2 grid_position = node.position - dimensions_of(node) / 2.0f;
+        if(node.editor != nullptr)
+            node.editor->set_grid_position(grid_position);
+        else
+            ImNodes::SetNodeGridSpacePos(node.id, to_imgui(grid_position));
     }
     _profilers[profiler_write_to_gui].record_sample_end();
 }
@@ -8,14 +8,15 @@
 #include <array>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <memory>
 #include <range/v3/functional/bind_back.hpp>
 #include <range/v3/iterator/basic_iterator.hpp>
 #include <range/v3/view/adaptor.hpp>
 #include <range/v3/view/any_view.hpp>
-#include <range/v3/view/filter.hpp>
 #include <range/v3/view/view.hpp>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -28,6 +29,11 @@ class widget_tree;
 
 namespace clk::gui::impl
 {
+class node_editor;
+
+// Moves the nodes apart and pulls linked ports together. The nodes of the editor are read from and written to their
+// editors, so the nodes that are culled and not drawn take part as well. The viewer draws all of its nodes, which are
+// read from and written to ImNodes.
 class layout_solver
 {
 public:
@@ -43,61 +49,109 @@ public:
     template <typename T, typename U>
     void update_cache(clk::graph const& graph, T& node_cache, U& port_cache)
     {
-        if(_cached_graph_timestamp == graph.timestamp().time_point())
+        if(_cached_graph_timestamp == graph.timestamp())
             return;
 
         _profilers[profiler_update_cache].record_sample_start();
-        _cached_graph_timestamp = graph.timestamp().time_point();
+        _cached_graph_timestamp = graph.timestamp();
+        _settled = false;
+
         _nodes.clear();
         _ports.clear();
-        std::unordered_map<int, std::size_t> port_id_to_index;
+        _node_indices.clear();
+        _port_indices.clear();
+        _connections.clear();
+        _connection_count = 0;
         for(auto const& node : graph.nodes())
+            add_node(*node, node_cache);
+        for(std::size_t port_index = 0; port_index < _ports.size(); port_index++)
+            update_connections(port_index, port_cache);
+        _profilers[profiler_update_cache].record_sample_end();
+    }
+
+    // The editor reports its own modifications, so they only update the ports they touch. The previous timestamp is
+    // the one of the graph before the modification, any modification in between rebuilds the whole cache instead.
+    template <typename T, typename U>
+    void node_added(clk::timestamp previous_graph_timestamp, clk::graph const& graph, clk::node& node,
+        T& node_cache, U& port_cache)
+    {
+        if(_cached_graph_timestamp != previous_graph_timestamp)
+            return;
+
+        _profilers[profiler_update_cache].record_sample_start();
+        std::size_t const first_port = _ports.size();
+        add_node(node, node_cache);
+        bool updated = true;
+        for(std::size_t port_index = first_port; updated && port_index < _ports.size(); port_index++)
+            updated = update_connections_around(port_index, port_cache);
+        if(updated)
+        {
+            _cached_graph_timestamp = graph.timestamp();
+            _settled = false;
+        }
+        _profilers[profiler_update_cache].record_sample_end();
+    }
+
+    template <typename U>
+    void connections_changed(clk::timestamp previous_graph_timestamp, clk::graph const& graph,
+        clk::port const& first, clk::port const& second, U& port_cache)
+    {
+        if(_cached_graph_timestamp != previous_graph_timestamp)
+            return;
+
+        _profilers[profiler_update_cache].record_sample_start();
+        auto first_it = _port_indices.find(&first);
+        auto second_it = _port_indices.find(&second);
+        if(first_it != _port_indices.end() && second_it != _port_indices.end() &&
+            update_connections_around(first_it->second, port_cache) &&
+            update_connections_around(second_it->second, port_cache))
         {
-            auto id = node_cache.widget_for(node.get()).id();
-
-            node_representation n;
-            n.id = id;
-
-            _nodes.push_back(n);
-            for(auto const& port : node->all_ports() | ranges::views::filter(&clk::port::is_connected))
-            {
-                port_representation p;
-                auto const& widget = port_cache.widget_for(port);
-                port_id_to_index[widget.id()] = _ports.size();
-                p.position = &widget.position();
-                p.parent_node_index = _nodes.size() - 1;
-                for(auto const& connected_port : port->connected_ports())
-                {
-                    int connected_id = port_cache.widget_for(connected_port).id();
-                    // only add the connection if the index comes before the current port
-                    if(auto it = port_id_to_index.find(connected_id); it != port_id_to_index.end())
-                        p.connected_port_indices.push_back(it->second);
-                }
-
-                _ports.push_back(p);
-            }
+            _cached_graph_timestamp = graph.timestamp();
+            _settled = false;
         }
         _profilers[profiler_update_cache].record_sample_end();
     }
 
+    // the node and its ports are already destroyed, the pointers only identify them in the cache
+    void node_removed(clk::timestamp previous_graph_timestamp, clk::graph const& graph, clk::node const* node,
+        std::vector<clk::port*> const& ports);
+
     void step();
+    // whether the last step left every node where it was
+    auto is_settled() const -> bool;
 
 private:
     struct node_representation
     {
+        clk::node const* node = nullptr;
         int id = -1;
+        // only set for the nodes of the editor
+        node_editor* editor = nullptr;
         glm::vec2 position = {0.0f, 0.0f};
         std::array<glm::vec2, 2> collision_sphere_centres;
         float collision_sphere_radius;
         float mass = 1.0f;
         glm::vec2 velocity = {0.0f, 0.0f};
     };
+    struct collision_sphere
+    {
+        std::uint64_t cell = 0;
+        std::size_t node_index = 0;
+        glm::vec2 centre = {0.0f, 0.0f};
+    };
+    // the connections of a port are the indices of the connected ports in _connections, starting at
+    // first_connection, with room for as many as the capacity before the connections of the next port
     struct port_representation
     {
-        glm::vec2 const* position;
+        clk::port* port = nullptr;
+        // only connected ports have a position, the widgets of the others are not needed
+        glm::vec2 const* position = nullptr;
+        // from the centre of the node, kept while the node is not drawn
+        glm::vec2 offset = {0.0f, 0.0f};
         std::size_t parent_node_index = 0;
-        // does not contain all indices, only indices less than the index of the current port
-        std::vector<std::size_t> connected_port_indices;
+        std::size_t first_connection = 0;
+        std::size_t connection_count = 0;
+        std::size_t connection_capacity = 0;
     };
     enum profiler_category
     {
@@ -114,19 +168,102 @@ private:
     mutable std::array<profiler, profiler_n> _profilers;
     using chrono = std::chrono::high_resolution_clock;
     chrono::time_point _last_step_execution = chrono::time_point::min();
-    std::chrono::steady_clock::time_point _cached_graph_timestamp = std::chrono::steady_clock::time_point::min();
+    clk::timestamp _cached_graph_timestamp;
     std::chrono::milliseconds _minimum_timestep{10};
     std::chrono::milliseconds _maximum_timestep{100};
     glm::vec2 _mouse_position = {0.0f, 0.0f};
     std::vector<node_representation> _nodes;
     std::vector<port_representation> _ports;
+    std::unordered_map<clk::node const*, std::size_t> _node_indices;
+    std::unordered_map<clk::port const*, std::size_t> _port_indices;
+    std::vector<std::size_t> _connections;
+    // the number of connections in use, the rest of _connections is left free by ports that outgrew their capacity
+    std::size_t _connection_count = 0;
+    std::vector<collision_sphere> _collision_spheres;
     float _mouse_influence_radius = 500.0f;
     float _time_multiplier = 1.0f;
     float _repulsion_intensity_multiplier = 1.0f;
+    // cells smaller than the largest repulsion distance check fewer pairs, but miss some of the repulsion between the
+    // largest nodes
+    float _repulsion_cell_size_multiplier = 1.0f;
     float _attraction_intensity_multiplier = 1.0f;
     bool _queue_gather = false;
+    bool _settled = false;
 
     static auto calculate_force(float ideal_distance, float distance) -> float;
+    static auto dimensions_of(node_representation const& node) -> glm::vec2;
+
+    // the ports of every node are added after the ports of the nodes before it, without any connections
+    template <typename T>
+    void add_node(clk::node& node, T& node_cache)
+    {
+        node_representation n;
+        n.node = &node;
+        auto& widget = node_cache.widget_for(&node);
+        n.id = widget.id();
+        if constexpr(std::is_same_v<decltype(widget), node_editor&>)
+            n.editor = &widget;
+        for(auto* port : node.all_ports())
+        {
+            _port_indices[port] = _ports.size();
+            auto& cached_port = _ports.emplace_back();
+            cached_port.port = port;
+            cached_port.parent_node_index = _nodes.size();
+        }
+        _node_indices[&node] = _nodes.size();
+        _nodes.push_back(n);
+    }
+
+    // copies the connections of the port from the graph, false if it is connected to a port that is not cached
+    template <typename U>
+    auto update_connections(std::size_t port_index, U& port_cache) -> bool
+    {
+        auto const& connected_ports = _ports[port_index].port->connected_ports();
+        for(auto* connected_port : connected_ports)
+            if(_port_indices.count(connected_port) == 0)
+                return false;
+
+        auto& port = _ports[port_index];
+        if(connected_ports.size() > port.connection_capacity)
+        {
+            // the connections move to the end, once half of the connections are unused they are packed again
+            if(_connections.size() > 2 * (_connection_count + connected_ports.size()) + 64)
+                pack_connections();
+            port.first_connection = _connections.size();
+            port.connection_capacity = connected_ports.size() * 2;
+            _connections.resize(_connections.size() + port.connection_capacity);
+        }
+        _connection_count = _connection_count - port.connection_count + connected_ports.size();
+        port.connection_count = connected_ports.size();
+        for(std::size_t i = 0; i < connected_ports.size(); i++)
+            _connections[port.first_connection + i] = _port_indices.at(connected_ports[i]);
+        if(port.position == nullptr && port.connection_count != 0)
+            port.position = &port_cache.widget_for(port.port).position();
+        return true;
+    }
+
+    // updates the port and every port it was or is connected to
+    template <typename U>
+    auto update_connections_around(std::size_t port_index, U& port_cache) -> bool
+    {
+        auto const& port = _ports[port_index];
+        std::vector<std::size_t> affected_ports;
+        for(std::size_t i = 0; i < port.connection_count; i++)
+            affected_ports.push_back(_connections[port.first_connection + i]);
+        if(!update_connections(port_index, port_cache))
+            return false;
+        for(std::size_t i = 0; i < port.connection_count; i++)
+            affected_ports.push_back(_connections[port.first_connection + i]);
+
+        for(auto affected_port : affected_ports)
+            if(!update_connections(affected_port, port_cache))
+                return false;
+        return true;
+    }
+
+    void pack_connections();
+    void remove_connection(std::size_t port_index, std::size_t connected_port_index);
+    void remove_port(std::size_t port_index);
     void update_nodes_from_gui();
     void calculate_repulsion();
     void calculate_attraction();
@@ -0,0 +1,50 @@
+#include "level_of_detail.hpp"
+#include "clk/gui/widgets/widget.hpp"
+#include "clk/gui/widgets/widget_factory.hpp"
+#include "clk/gui/widgets/widget_tree.hpp"
+
+namespace clk::gui::impl
+{
+
+level_of_detail::level_of_detail(bool const& draw_node_titles, bool const& draw_port_widgets)
+    : _node_titles_enabled(draw_node_titles), _port_widgets_enabled(draw_port_widgets)
+{
+}
+
+void level_of_detail::register_settings(widget_tree& settings, widget_factory const& f)
+{
+    settings.add(f.create(_automatic, "Automatic"));
+    settings.add(f.create(_maximum_nodes_with_port_widgets, "Maximum nodes with port widgets"));
+    settings.add(f.create(_maximum_nodes_with_titles, "Maximum nodes with titles"));
+}
+
+void level_of_detail::update(std::size_t drawn_node_count)
+{
+    auto const node_count = static_cast<long long>(drawn_node_count);
+    if(!_automatic || node_count <= _maximum_nodes_with_port_widgets)
+        _level = level::full;
+    else if(node_count <= _maximum_nodes_with_titles)
+        _level = level::titles;
+    else
+        _level = level::pins;
+
+    _draw_node_titles = _node_titles_enabled && _level != level::pins;
+    _draw_port_widgets = _port_widgets_enabled && _level == level::full;
+}
+
+auto level_of_detail::current_level() const -> level
+{
+    return _level;
+}
+
+auto level_of_detail::draws_node_titles() const -> bool const&
+{
+    return _draw_node_titles;
+}
+
+auto level_of_detail::draws_port_widgets() const -> bool const&
+{
+    return _draw_port_widgets;
+}
+
+} // namespace clk::gui::impl
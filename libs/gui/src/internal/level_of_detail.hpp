@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+
+namespace clk::gui
+{
+class widget_factory;
+class widget_tree;
+} // namespace clk::gui
+
+namespace clk::gui::impl
+{
+// Decides how much of every node is drawn, based on how many nodes are drawn at once. The widgets of the ports are left
+// out first, then the titles of the nodes, so only their pins remain.
+class level_of_detail
+{
+public:
+    enum class level
+    {
+        pins,
+        titles,
+        full
+    };
+
+    level_of_detail() = delete;
+    // the settings of the graph widget, which limit the level of detail
+    level_of_detail(bool const& draw_node_titles, bool const& draw_port_widgets);
+    level_of_detail(level_of_detail const&) = delete;
+    level_of_detail(level_of_detail&&) = delete;
+    auto operator=(level_of_detail const&) -> level_of_detail& = delete;
+    auto operator=(level_of_detail&&) -> level_of_detail& = delete;
+    ~level_of_detail() = default;
+
+    void register_settings(widget_tree& settings, widget_factory const& f);
+    // picks the level for the number of nodes drawn in the current frame
+    void update(std::size_t drawn_node_count);
+    auto current_level() const -> level;
+    // references stay valid and change with the level, so widgets can keep them
+    auto draws_node_titles() const -> bool const&;
+    auto draws_port_widgets() const -> bool const&;
+
+private:
+    bool const& _node_titles_enabled;
+    bool const& _port_widgets_enabled;
+    bool _automatic = true;
+    int _maximum_nodes_with_port_widgets = 150;
+    int _maximum_nodes_with_titles = 600;
+    level _level = level::full;
+    bool _draw_node_titles = true;
+    bool _draw_port_widgets = true;
+};
+
+} // namespace clk::gui::impl
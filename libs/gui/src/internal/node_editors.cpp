@@ -4,11 +4,14 @@
 #include "clk/base/node.hpp"
 #include "clk/base/output.hpp"
 #include "clk/base/port.hpp"
+#include "clk/gui/imgui_conversions.hpp"
+#include "clk/gui/init.hpp"
 #include "clk/gui/widgets/data_writer.hpp"
 #include "clk/gui/widgets/widget_factory.hpp"
 #include "clk/util/color_rgb.hpp"
 #include "clk/util/color_rgba.hpp"
 #include "clk/util/timestamp.hpp"
+#include "evaluation_view.hpp"
 #include "imgui_guard.hpp"
 #include "port_editors.hpp"
 #include "widget_cache.hpp"
@@ -28,8 +31,14 @@ namespace clk::gui::impl
 {
 
 node_editor::node_editor(clk::node* node, int id, widget_cache<clk::port, port_editor>* port_cache,
-    std::optional<std::function<bool()>>& queued_action, bool const& draw_node_titles)
-    : _queued_action(queued_action), _port_cache(port_cache), _node(node), _id(id), _draw_node_titles(draw_node_titles)
+    std::optional<std::function<bool()>>& queued_action, evaluation_view const& evaluation,
+    bool const& draw_node_titles)
+    : _queued_action(queued_action)
+    , _evaluation(evaluation)
+    , _port_cache(port_cache)
+    , _node(node)
+    , _id(id)
+    , _draw_node_titles(draw_node_titles)
 {
 }
 
@@ -48,13 +57,70 @@ void node_editor::set_highlighted(bool highlighted)
     _highlighted = highlighted;
 }
 
+void node_editor::set_on_screen(bool on_screen)
+{
+    _on_screen = on_screen;
+}
+
+auto node_editor::is_on_screen() const -> bool
+{
+    return _on_screen;
+}
+
+auto node_editor::is_drawn() const -> bool
+{
+    return _drawn_frame == ImGui::GetFrameCount();
+}
+
+auto node_editor::is_visible_in(glm::vec2 view_min, glm::vec2 view_max) const -> bool
+{
+    if(_first_draw)
+        return true;
+
+    glm::vec2 const node_max = _grid_position + _dimensions;
+    return _grid_position.x < view_max.x && node_max.x > view_min.x && _grid_position.y < view_max.y &&
+           node_max.y > view_min.y;
+}
+
+auto node_editor::grid_position() const -> glm::vec2 const&
+{
+    return _grid_position;
+}
+
+auto node_editor::dimensions() const -> glm::vec2 const&
+{
+    return _dimensions;
+}
+
+void node_editor::set_grid_position(glm::vec2 position)
+{
+    _grid_position = position;
+    if(is_drawn())
+        ImNodes::SetNodeGridSpacePos(_id, to_imgui(position));
+}
+
+void node_editor::update_grid_position()
+{
+    if(is_drawn())
+        _grid_position = to_glm(ImNodes::GetNodeGridSpacePos(_id));
+}
+
 void node_editor::draw()
 {
+    if(!_first_draw)
+        ImNodes::SetNodeGridSpacePos(_id, to_imgui(_grid_position));
+    _drawn_frame = ImGui::GetFrameCount();
+
+    for(auto* port : _node->all_ports())
+        _port_cache->widget_for(port).set_on_screen(_on_screen);
+
     imgui_guard style_guard;
-    auto const& error_message = _node->error();
+    auto const& error_message = _evaluation.error(*_node);
 
     if(!error_message.empty())
     {
+        if(_on_screen)
+            request_redraw();
         const float t = std::chrono::duration_cast<std::chrono::duration<float, std::ratio<1, 1>>>(
             std::chrono::steady_clock::now().time_since_epoch())
                             .count();
@@ -99,6 +165,9 @@ void node_editor::draw()
 
     ImNodes::EndNode();
     _contents_width = ImGui::GetItemRectSize().x;
+    // the size of nodes drawn without their port widgets would hide them while they are just outside of the view
+    if(_on_screen)
+        _dimensions = to_glm(ImNodes::GetNodeDimensions(_id));
 
     _first_draw = false;
 }
@@ -108,7 +177,7 @@ void node_editor::draw_title_bar()
     if(!_node->inputs().empty())
     {
         if(ImGui::SmallButton("Pull"))
-            _node->pull();
+            _evaluation.pull(*_node);
         ImGui::SameLine();
     }
 
@@ -117,11 +186,17 @@ void node_editor::draw_title_bar()
         ImGui::Text("%s", _node->name().data());
     }
 
+    if(_evaluation.is_evaluating(*_node))
+    {
+        ImGui::SameLine();
+        ImGui::TextDisabled("(evaluating)");
+    }
+
     if(!_node->outputs().empty())
     {
         ImGui::SameLine();
         if(ImGui::SmallButton("Push"))
-            _node->push();
+            _evaluation.push(*_node);
     }
 }
 
@@ -139,8 +214,8 @@ void node_editor::draw_outputs()
 
 constant_node_editor::constant_node_editor(clk::constant_node* constant_node, int id,
     widget_cache<clk::port, port_editor>* port_cache, std::optional<std::function<bool()>>& queued_action,
-    widget_factory const& widget_factory, bool const& draw_node_titles)
-    : node_editor(constant_node, id, port_cache, queued_action, draw_node_titles)
+    evaluation_view const& evaluation, widget_factory const& widget_factory, bool const& draw_node_titles)
+    : node_editor(constant_node, id, port_cache, queued_action, evaluation, draw_node_titles)
     , _widget_factory(widget_factory)
     , _constant_node(constant_node)
 {
@@ -157,6 +232,7 @@ void constant_node_editor::draw_outputs()
             {
                 _queued_action = [&]() {
                     _constant_editors.erase(port);
+                    _evaluation.cancel(*port);
                     _constant_node->remove_output(port);
                     return true;
                 };
@@ -172,13 +248,14 @@ void constant_node_editor::draw_outputs()
                                                                    },
                                            [=]() {
                                                port->update_timestamp();
-                                               port->push();
+                                               _evaluation.push(*port);
                                            }},
                     port->data_type_hash(), port->name());
             _constant_editors[port]->set_maximum_width(200);
         }
 
-        _port_cache->widget_for(port).draw(_constant_editors[port].get());
+        // the port shows the published constant while the worker evaluates the graph
+        _port_cache->widget_for(port).draw(_evaluation.is_live() ? _constant_editors[port].get() : nullptr);
     }
 
     if(ImGui::SmallButton("+"))
@@ -242,14 +319,14 @@ void constant_node_editor::draw_outputs()
 }
 
 auto create_node_editor(clk::node* node, int id, widget_cache<clk::port, port_editor>* port_cache,
-    std::optional<std::function<bool()>>& queued_action, widget_factory const& widget_factory,
-    bool const& draw_node_titles) -> std::unique_ptr<node_editor>
+    std::optional<std::function<bool()>>& queued_action, evaluation_view const& evaluation,
+    widget_factory const& widget_factory, bool const& draw_node_titles) -> std::unique_ptr<node_editor>
 {
     if(auto* constant_node = dynamic_cast<clk::constant_node*>(node))
         return std::make_unique<constant_node_editor>(
-            constant_node, id, port_cache, queued_action, widget_factory, draw_node_titles);
+            constant_node, id, port_cache, queued_action, evaluation, widget_factory, draw_node_titles);
     else
-        return std::make_unique<node_editor>(node, id, port_cache, queued_action, draw_node_titles);
+        return std::make_unique<node_editor>(node, id, port_cache, queued_action, evaluation, draw_node_titles);
 }
 
 } // namespace clk::gui::impl
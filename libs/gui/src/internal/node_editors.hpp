@@ -1,6 +1,7 @@
 #pragma once
 #include "clk/gui/widgets/editor.hpp"
 #include <functional>
+#include <glm/glm.hpp>
 #include <memory>
 #include <optional>
 #include <unordered_map>
@@ -20,6 +21,7 @@ class widget_factory;
 
 namespace clk::gui::impl
 {
+class evaluation_view;
 class port_editor;
 template <typename DataType, typename Widget>
 class widget_cache;
@@ -33,7 +35,8 @@ class node_editor
 public:
     node_editor() = delete;
     node_editor(clk::node* node, int id, widget_cache<clk::port, port_editor>* port_cache,
-        std::optional<std::function<bool()>>& queued_action, bool const& draw_node_titles);
+        std::optional<std::function<bool()>>& queued_action, evaluation_view const& evaluation,
+        bool const& draw_node_titles);
     node_editor(node_editor const&) = delete;
     node_editor(node_editor&&) noexcept = delete;
     auto operator=(node_editor const&) -> node_editor& = delete;
@@ -43,10 +46,23 @@ public:
     auto id() const -> int;
     auto node() const -> clk::node*;
     void set_highlighted(bool highlighted);
+    // nodes that are only drawn because a link leads to them skip the widgets of their ports
+    void set_on_screen(bool on_screen);
+    auto is_on_screen() const -> bool;
+    // ImNodes only knows the nodes drawn in the current frame
+    auto is_drawn() const -> bool;
+    // nodes that were never drawn have no known size yet and always count as visible
+    auto is_visible_in(glm::vec2 view_min, glm::vec2 view_max) const -> bool;
+    auto grid_position() const -> glm::vec2 const&;
+    auto dimensions() const -> glm::vec2 const&;
+    // ImNodes forgets the nodes that are not drawn, so the position is kept here and restored when they are drawn again
+    void set_grid_position(glm::vec2 position);
+    void update_grid_position();
     void draw();
 
 protected:
     std::optional<std::function<bool()>>& _queued_action; // NOLINT
+    evaluation_view const& _evaluation; // NOLINT
     widget_cache<clk::port, port_editor>* _port_cache = nullptr; // NOLINT
     clk::node* _node = nullptr; // NOLINT
     int _id = -1; // NOLINT
@@ -54,6 +70,10 @@ protected:
     float _title_width = 0; // NOLINT
     float _contents_width = 0; // NOLINT
     bool _highlighted = false; // NOLINT
+    bool _on_screen = true; // NOLINT
+    int _drawn_frame = -1; // NOLINT
+    glm::vec2 _grid_position = {0.0f, 0.0f}; // NOLINT
+    glm::vec2 _dimensions = {0.0f, 0.0f}; // NOLINT
     bool const& _draw_node_titles; // NOLINT
 
     virtual void draw_title_bar();
@@ -66,8 +86,8 @@ class constant_node_editor final : public node_editor
 public:
     constant_node_editor() = delete;
     constant_node_editor(clk::constant_node* constant_node, int id, widget_cache<clk::port, port_editor>* port_cache,
-        std::optional<std::function<bool()>>& queued_action, widget_factory const& widget_factory,
-        bool const& draw_node_titles);
+        std::optional<std::function<bool()>>& queued_action, evaluation_view const& evaluation,
+        widget_factory const& widget_factory, bool const& draw_node_titles);
     constant_node_editor(constant_node_editor const&) = delete;
     constant_node_editor(constant_node_editor&&) noexcept = delete;
     auto operator=(constant_node_editor const&) -> constant_node_editor& = delete;
@@ -83,7 +103,7 @@ private:
 };
 
 auto create_node_editor(clk::node* node, int id, widget_cache<clk::port, port_editor>* port_cache,
-    std::optional<std::function<bool()>>& queued_action, widget_factory const& widget_factory,
-    bool const& draw_node_titles) -> std::unique_ptr<node_editor>;
+    std::optional<std::function<bool()>>& queued_action, evaluation_view const& evaluation,
+    widget_factory const& widget_factory, bool const& draw_node_titles) -> std::unique_ptr<node_editor>;
 
 } // namespace clk::gui::impl
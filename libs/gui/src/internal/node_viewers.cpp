@@ -3,7 +3,9 @@
 #include "clk/base/node.hpp"
 #include "clk/base/output.hpp"
 #include "clk/base/port.hpp"
+#include "clk/gui/init.hpp"
 #include "clk/util/color_rgba.hpp"
+#include "evaluation_view.hpp"
 #include "imgui_guard.hpp"
 #include "port_viewers.hpp"
 #include "widget_cache.hpp"
@@ -19,9 +21,9 @@
 namespace clk::gui::impl
 {
 
-node_viewer::node_viewer(
-    clk::node const* node, int id, widget_cache<clk::port const, port_viewer>* port_cache, bool const& draw_node_titles)
-    : _port_cache(port_cache), _node(node), _id(id), _draw_node_titles(draw_node_titles)
+node_viewer::node_viewer(clk::node const* node, int id, widget_cache<clk::port const, port_viewer>* port_cache,
+    evaluation_view const& evaluation, bool const& draw_node_titles)
+    : _port_cache(port_cache), _evaluation(evaluation), _node(node), _id(id), _draw_node_titles(draw_node_titles)
 {
 }
 
@@ -43,10 +45,11 @@ void node_viewer::set_highlighted(bool highlighted)
 void node_viewer::draw()
 {
     imgui_guard style_guard;
-    auto const& error_message = _node->error();
+    auto const& error_message = _evaluation.error(*_node);
 
     if(!error_message.empty())
     {
+        request_redraw();
         const float t = std::chrono::duration_cast<std::chrono::duration<float, std::ratio<1, 1>>>(
             std::chrono::steady_clock::now().time_since_epoch())
                             .count();
@@ -103,6 +106,12 @@ void node_viewer::draw_title_bar()
         ImGui::Text("%s", _node->name().data());
     }
 
+    if(_evaluation.is_evaluating(*_node))
+    {
+        ImGui::SameLine();
+        ImGui::TextDisabled("(evaluating)");
+    }
+
     ImGui::EndGroup();
 
     if(_first_draw)
@@ -112,9 +121,9 @@ void node_viewer::draw_title_bar()
 }
 
 auto create_node_viewer(clk::node const* node, int id, widget_cache<clk::port const, port_viewer>* port_cache,
-    bool const& draw_node_titles) -> std::unique_ptr<node_viewer>
+    evaluation_view const& evaluation, bool const& draw_node_titles) -> std::unique_ptr<node_viewer>
 {
-    return std::make_unique<node_viewer>(node, id, port_cache, draw_node_titles);
+    return std::make_unique<node_viewer>(node, id, port_cache, evaluation, draw_node_titles);
 }
 
 } // namespace clk::gui::impl
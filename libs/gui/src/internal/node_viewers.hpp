@@ -9,6 +9,7 @@ class port;
 
 namespace clk::gui::impl
 {
+class evaluation_view;
 class port_viewer;
 template <typename DataType, typename Widget>
 class widget_cache;
@@ -22,7 +23,7 @@ class node_viewer
 public:
     node_viewer() = delete;
     node_viewer(clk::node const* node, int id, widget_cache<clk::port const, port_viewer>* port_cache,
-        bool const& draw_node_titles);
+        evaluation_view const& evaluation, bool const& draw_node_titles);
     node_viewer(node_viewer const&) = delete;
     node_viewer(node_viewer&&) noexcept = delete;
     auto operator=(node_viewer const&) -> node_viewer& = delete;
@@ -36,6 +37,7 @@ public:
 
 private:
     widget_cache<clk::port const, port_viewer>* _port_cache = nullptr;
+    evaluation_view const& _evaluation;
     clk::node const* _node = nullptr;
     int _id = -1;
     bool _first_draw = true;
@@ -48,6 +50,6 @@ private:
 };
 
 auto create_node_viewer(clk::node const* node, int id, widget_cache<clk::port const, port_viewer>* port_cache,
-    bool const& draw_node_titles) -> std::unique_ptr<node_viewer>;
+    evaluation_view const& evaluation, bool const& draw_node_titles) -> std::unique_ptr<node_viewer>;
 
 } // namespace clk::gui::impl
@@ -1,12 +1,14 @@
 #include "port_editors.hpp"
 #include "clk/base/port.hpp"
 #include "clk/gui/imgui_conversions.hpp"
+#include "clk/gui/init.hpp"
 #include "clk/gui/widgets/data_reader.hpp"
 #include "clk/gui/widgets/data_writer.hpp"
 #include "clk/gui/widgets/widget.hpp"
 #include "clk/gui/widgets/widget_factory.hpp"
 #include "clk/util/color_rgb.hpp"
 #include "clk/util/color_rgba.hpp"
+#include "evaluation_view.hpp"
 #include "imgui_guard.hpp"
 #include "port_color.hpp"
 
@@ -17,15 +19,10 @@
 namespace clk::gui::impl
 {
 
-port_editor::port_editor(clk::port* port, int id, widget_factory const& widget_factory, bool const& draw_port_widgets)
-    : _id(id)
-    , _data_viewer(widget_factory.create(data_reader<void>{[=]() {
-        return port->data_pointer();
-    }},
-          port->data_type_hash(), port->name()))
-    , _draw_port_widgets(draw_port_widgets)
+port_editor::port_editor(clk::port* /*port*/, int id, widget_factory const& widget_factory,
+    evaluation_view const& evaluation, bool const& draw_port_widgets)
+    : _id(id), _widget_factory(widget_factory), _evaluation(evaluation), _draw_port_widgets(draw_port_widgets)
 {
-    _data_viewer->set_maximum_width(200);
 }
 
 auto port_editor::id() const -> int
@@ -43,38 +40,33 @@ void port_editor::set_stable_height(bool stable_height)
     _stable_height = stable_height;
 }
 
+void port_editor::set_on_screen(bool on_screen)
+{
+    _on_screen = on_screen;
+}
+
 auto port_editor::position() const -> glm::vec2 const&
 {
     return _position;
 }
 
+// the viewer is only created once it is drawn, most ports of big graphs are drawn without it
 void port_editor::update_viewer_type()
 {
-    if(_data_viewer->data_type_hash() != port()->data_type_hash())
+    if(_data_viewer == nullptr || _data_viewer->data_type_hash() != port()->data_type_hash())
     {
-        _data_viewer = _data_viewer->get_widget_factory()->create(data_reader<void>{[=]() {
-            return port()->data_pointer();
+        _data_viewer = _widget_factory.create(data_reader<void>{[=]() {
+            return _evaluation.data_pointer(*port());
         }},
             port()->data_type_hash(), port()->name());
         _data_viewer->set_maximum_width(200);
     }
 }
 
-input_editor::input_editor(
-    clk::input* port, int id, widget_factory const& widget_factory, bool const& draw_port_widgets)
-    : port_editor(port, id, widget_factory, draw_port_widgets), _port(port)
+input_editor::input_editor(clk::input* port, int id, widget_factory const& widget_factory,
+    evaluation_view const& evaluation, bool const& draw_port_widgets)
+    : port_editor(port, id, widget_factory, evaluation, draw_port_widgets), _port(port)
 {
-    auto* default_port = &port->default_port();
-
-    _default_data_editor = widget_factory.create(clk::gui::data_writer<void>{[=]() {
-                                                                                 return default_port->data_pointer();
-                                                                             },
-                                                     [=]() {
-                                                         default_port->update_timestamp();
-                                                         default_port->push();
-                                                     }},
-        default_port->data_type_hash(), port->name());
-    _default_data_editor->set_maximum_width(200);
 }
 
 auto input_editor::port() const -> input*
@@ -82,11 +74,28 @@ auto input_editor::port() const -> input*
     return _port;
 }
 
+void input_editor::create_default_data_editor()
+{
+    auto* default_port = &_port->default_port();
+
+    _default_data_editor = _widget_factory.create(clk::gui::data_writer<void>{[=]() {
+                                                                                  return default_port->data_pointer();
+                                                                              },
+                                                      [=]() {
+                                                          default_port->update_timestamp();
+                                                          _evaluation.push(*default_port);
+                                                      }},
+        default_port->data_type_hash(), _port->name());
+    _default_data_editor->set_maximum_width(200);
+}
+
 void input_editor::draw(clk::gui::widget* override_widget)
 {
     imgui_guard style_guard;
-    if(_port->is_faulty())
+    if(_evaluation.is_faulty(*_port))
     {
+        if(_on_screen)
+            request_redraw();
         const float t = std::chrono::duration_cast<std::chrono::duration<float, std::ratio<1, 1>>>(
             std::chrono::steady_clock::now().time_since_epoch())
                             .count();
@@ -110,7 +119,7 @@ void input_editor::draw(clk::gui::widget* override_widget)
     else
         ImNodes::BeginInputAttribute(_id, ImNodesPinShape_QuadFilled);
 
-    if(_draw_port_widgets)
+    if(_draw_port_widgets && _on_screen)
     {
         if(override_widget != nullptr)
         {
@@ -118,8 +127,11 @@ void input_editor::draw(clk::gui::widget* override_widget)
         }
         else
         {
-            if(!_port->is_connected())
+            // the default data can only be edited while the worker is not evaluating the graph
+            if(!_port->is_connected() && _evaluation.is_live())
             {
+                if(_default_data_editor == nullptr)
+                    create_default_data_editor();
                 _default_data_editor->draw();
             }
             else
@@ -131,7 +143,8 @@ void input_editor::draw(clk::gui::widget* override_widget)
             if(_stable_height)
             {
                 float current_height = ImGui::GetCursorPosY() - begin_y;
-                float max_height = std::max(_data_viewer->last_size().y, _default_data_editor->last_size().y);
+                float max_height = std::max(_data_viewer != nullptr ? _data_viewer->last_size().y : 0.0f,
+                    _default_data_editor != nullptr ? _default_data_editor->last_size().y : 0.0f);
                 if(current_height < max_height)
                     ImGui::Dummy(ImVec2(10, max_height - current_height));
             }
@@ -153,9 +166,9 @@ void input_editor::draw(clk::gui::widget* override_widget)
     _position.x = rect_min.x;
 }
 
-output_editor::output_editor(
-    clk::output* port, int id, widget_factory const& widget_factory, bool const& draw_port_widgets)
-    : port_editor(port, id, widget_factory, draw_port_widgets), _port(port)
+output_editor::output_editor(clk::output* port, int id, widget_factory const& widget_factory,
+    evaluation_view const& evaluation, bool const& draw_port_widgets)
+    : port_editor(port, id, widget_factory, evaluation, draw_port_widgets), _port(port)
 {
 }
 
@@ -168,8 +181,10 @@ void output_editor::draw(clk::gui::widget* override_widget)
 {
     imgui_guard style_guard;
 
-    if(_port->is_faulty())
+    if(_evaluation.is_faulty(*_port))
     {
+        if(_on_screen)
+            request_redraw();
         const float t = std::chrono::duration_cast<std::chrono::duration<float, std::ratio<1, 1>>>(
             std::chrono::steady_clock::now().time_since_epoch())
                             .count();
@@ -191,7 +206,7 @@ void output_editor::draw(clk::gui::widget* override_widget)
     else
         ImNodes::BeginOutputAttribute(_id, ImNodesPinShape_TriangleFilled);
 
-    if(_draw_port_widgets)
+    if(_draw_port_widgets && _on_screen)
     {
         if(override_widget != nullptr)
         {
@@ -219,13 +234,13 @@ void output_editor::draw(clk::gui::widget* override_widget)
     _position.x = rect_max.x;
 }
 
-auto create_port_editor(clk::port* port, int id, widget_factory const& widget_factory, bool const& draw_port_widgets)
-    -> std::unique_ptr<port_editor>
+auto create_port_editor(clk::port* port, int id, widget_factory const& widget_factory,
+    evaluation_view const& evaluation, bool const& draw_port_widgets) -> std::unique_ptr<port_editor>
 {
     if(auto* input = dynamic_cast<clk::input*>(port); input != nullptr)
-        return std::make_unique<input_editor>(input, id, widget_factory, draw_port_widgets);
+        return std::make_unique<input_editor>(input, id, widget_factory, evaluation, draw_port_widgets);
     else if(auto* output = dynamic_cast<clk::output*>(port); output != nullptr)
-        return std::make_unique<output_editor>(output, id, widget_factory, draw_port_widgets);
+        return std::make_unique<output_editor>(output, id, widget_factory, evaluation, draw_port_widgets);
     return nullptr;
 }
 
@@ -19,6 +19,11 @@ class widget;
 class widget_factory;
 } // namespace clk::gui
 
+namespace clk::gui::impl
+{
+class evaluation_view;
+} // namespace clk::gui::impl
+
 namespace clk::gui::impl
 {
 
@@ -26,7 +31,8 @@ class port_editor
 {
 public:
     port_editor() = delete;
-    port_editor(clk::port* port, int id, widget_factory const& widget_factory, bool const& draw_port_widgets);
+    port_editor(clk::port* port, int id, widget_factory const& widget_factory, evaluation_view const& evaluation,
+        bool const& draw_port_widgets);
     port_editor(port_editor const&) = delete;
     port_editor(port_editor&&) noexcept = delete;
     auto operator=(port_editor const&) -> port_editor& = delete;
@@ -36,15 +42,19 @@ public:
     auto id() const -> int;
     void set_enabled(bool enabled);
     void set_stable_height(bool stable_height);
+    void set_on_screen(bool on_screen);
     virtual auto port() const -> port* = 0;
     virtual void draw(clk::gui::widget* override_widget = nullptr) = 0;
     auto position() const -> glm::vec2 const&;
 
 protected:
     int _id = -1; // NOLINT
+    widget_factory const& _widget_factory; // NOLINT
+    evaluation_view const& _evaluation; // NOLINT
     std::unique_ptr<clk::gui::viewer> _data_viewer; // NOLINT
     bool _enabled = true; // NOLINT
     bool _stable_height = false; // NOLINT
+    bool _on_screen = true; // NOLINT
     glm::vec2 _position = {0.0f, 0.0f}; // NOLINT
     bool const& _draw_port_widgets; // NOLINT
 
@@ -55,7 +65,8 @@ class input_editor final : public port_editor
 {
 public:
     input_editor() = delete;
-    input_editor(clk::input* port, int id, widget_factory const& widget_factory, bool const& draw_port_widgets);
+    input_editor(clk::input* port, int id, widget_factory const& widget_factory, evaluation_view const& evaluation,
+        bool const& draw_port_widgets);
     input_editor(input_editor const&) = delete;
     input_editor(input_editor&&) noexcept = delete;
     auto operator=(input_editor const&) -> input_editor& = delete;
@@ -68,13 +79,16 @@ public:
 private:
     clk::input* _port = nullptr;
     std::unique_ptr<clk::gui::editor> _default_data_editor;
+
+    void create_default_data_editor();
 };
 
 class output_editor final : public port_editor
 {
 public:
     output_editor() = delete;
-    output_editor(clk::output* port, int id, widget_factory const& widget_factory, bool const& draw_port_widgets);
+    output_editor(clk::output* port, int id, widget_factory const& widget_factory, evaluation_view const& evaluation,
+        bool const& draw_port_widgets);
     output_editor(output_editor const&) = delete;
     output_editor(output_editor&&) noexcept = delete;
     auto operator=(output_editor const&) -> output_editor& = delete;
@@ -88,7 +102,7 @@ private:
     clk::output* _port = nullptr;
 };
 
-auto create_port_editor(clk::port* port, int id, widget_factory const& widget_factory, bool const& draw_port_widgets)
-    -> std::unique_ptr<port_editor>;
+auto create_port_editor(clk::port* port, int id, widget_factory const& widget_factory,
+    evaluation_view const& evaluation, bool const& draw_port_widgets) -> std::unique_ptr<port_editor>;
 
 } // namespace clk::gui::impl
@@ -1,10 +1,12 @@
 #include "port_viewers.hpp"
 #include "clk/base/port.hpp"
 #include "clk/gui/imgui_conversions.hpp"
+#include "clk/gui/init.hpp"
 #include "clk/gui/widgets/data_reader.hpp"
 #include "clk/gui/widgets/widget_factory.hpp"
 #include "clk/util/color_rgb.hpp"
 #include "clk/util/color_rgba.hpp"
+#include "evaluation_view.hpp"
 #include "imgui_guard.hpp"
 #include "port_color.hpp"
 
@@ -14,16 +16,10 @@
 namespace clk::gui::impl
 {
 
-port_viewer::port_viewer(
-    clk::port const* port, int id, widget_factory const& widget_factory, bool const& draw_port_widgets)
-    : _id(id)
-    , _data_viewer(widget_factory.create(data_reader<void>{[=]() {
-        return port->data_pointer();
-    }},
-          port->data_type_hash(), port->name()))
-    , _draw_port_widgets(draw_port_widgets)
+port_viewer::port_viewer(clk::port const* /*port*/, int id, widget_factory const& widget_factory,
+    evaluation_view const& evaluation, bool const& draw_port_widgets)
+    : _id(id), _widget_factory(widget_factory), _evaluation(evaluation), _draw_port_widgets(draw_port_widgets)
 {
-    _data_viewer->set_maximum_width(200);
 }
 
 auto port_viewer::id() const -> int
@@ -36,21 +32,22 @@ auto port_viewer::position() const -> glm::vec2 const&
     return _position;
 }
 
+// the viewer is only created once it is drawn, most ports of big graphs are drawn without it
 void port_viewer::update_viewer_type()
 {
-    if(_data_viewer->data_type_hash() != port()->data_type_hash())
+    if(_data_viewer == nullptr || _data_viewer->data_type_hash() != port()->data_type_hash())
     {
-        _data_viewer = _data_viewer->get_widget_factory()->create(data_reader<void>{[=]() {
-            return port()->data_pointer();
+        _data_viewer = _widget_factory.create(data_reader<void>{[=]() {
+            return _evaluation.data_pointer(*port());
         }},
             port()->data_type_hash(), port()->name());
         _data_viewer->set_maximum_width(200);
     }
 }
 
-input_viewer::input_viewer(
-    clk::input const* port, int id, widget_factory const& widget_factory, bool const& draw_port_widgets)
-    : port_viewer(port, id, widget_factory, draw_port_widgets), _port(port)
+input_viewer::input_viewer(clk::input const* port, int id, widget_factory const& widget_factory,
+    evaluation_view const& evaluation, bool const& draw_port_widgets)
+    : port_viewer(port, id, widget_factory, evaluation, draw_port_widgets), _port(port)
 {
 }
 
@@ -63,8 +60,9 @@ void input_viewer::draw()
 {
     imgui_guard style_guard;
 
-    if(_port->is_faulty())
+    if(_evaluation.is_faulty(*_port))
     {
+        request_redraw();
         const float t = std::chrono::duration_cast<std::chrono::duration<float, std::ratio<1, 1>>>(
             std::chrono::steady_clock::now().time_since_epoch())
                             .count();
@@ -101,9 +99,9 @@ void input_viewer::draw()
     _position.x = rect_min.x;
 }
 
-output_viewer::output_viewer(
-    clk::output const* port, int id, widget_factory const& widget_factory, bool const& draw_port_widgets)
-    : port_viewer(port, id, widget_factory, draw_port_widgets), _port(port)
+output_viewer::output_viewer(clk::output const* port, int id, widget_factory const& widget_factory,
+    evaluation_view const& evaluation, bool const& draw_port_widgets)
+    : port_viewer(port, id, widget_factory, evaluation, draw_port_widgets), _port(port)
 {
 }
 
@@ -116,8 +114,9 @@ void output_viewer::draw()
 {
     imgui_guard style_guard;
 
-    if(_port->is_faulty())
+    if(_evaluation.is_faulty(*_port))
     {
+        request_redraw();
         const float t = std::chrono::duration_cast<std::chrono::duration<float, std::ratio<1, 1>>>(
             std::chrono::steady_clock::now().time_since_epoch())
                             .count();
@@ -155,12 +154,12 @@ void output_viewer::draw()
 }
 
 auto create_port_viewer(clk::port const* port, int id, widget_factory const& widget_factory,
-    bool const& draw_port_widgets) -> std::unique_ptr<port_viewer>
+    evaluation_view const& evaluation, bool const& draw_port_widgets) -> std::unique_ptr<port_viewer>
 {
     if(auto const* input_port = dynamic_cast<clk::input const*>(port); input_port != nullptr)
-        return std::make_unique<input_viewer>(input_port, id, widget_factory, draw_port_widgets);
+        return std::make_unique<input_viewer>(input_port, id, widget_factory, evaluation, draw_port_widgets);
     else if(auto const* output_port = dynamic_cast<clk::output const*>(port); output_port != nullptr)
-        return std::make_unique<output_viewer>(output_port, id, widget_factory, draw_port_widgets);
+        return std::make_unique<output_viewer>(output_port, id, widget_factory, evaluation, draw_port_widgets);
     return nullptr;
 }
 
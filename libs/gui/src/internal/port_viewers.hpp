@@ -17,13 +17,19 @@ namespace clk::gui
 class widget_factory;
 }
 
+namespace clk::gui::impl
+{
+class evaluation_view;
+} // namespace clk::gui::impl
+
 namespace clk::gui::impl
 {
 class port_viewer
 {
 public:
     port_viewer() = delete;
-    port_viewer(clk::port const* port, int id, widget_factory const& widget_factory, bool const& draw_port_widgets);
+    port_viewer(clk::port const* port, int id, widget_factory const& widget_factory, evaluation_view const& evaluation,
+        bool const& draw_port_widgets);
     port_viewer(port_viewer const&) = delete;
     port_viewer(port_viewer&&) noexcept = delete;
     auto operator=(port_viewer const&) -> port_viewer& = delete;
@@ -37,6 +43,8 @@ public:
 
 protected:
     int _id = -1; // NOLINT
+    widget_factory const& _widget_factory; // NOLINT
+    evaluation_view const& _evaluation; // NOLINT
     std::unique_ptr<clk::gui::viewer> _data_viewer; // NOLINT
     glm::vec2 _position = {0.0f, 0.0f}; // NOLINT
     bool const& _draw_port_widgets; // NOLINT
@@ -48,7 +56,8 @@ class input_viewer final : public port_viewer
 {
 public:
     input_viewer() = delete;
-    input_viewer(clk::input const* port, int id, widget_factory const& widget_factory, bool const& draw_port_widgets);
+    input_viewer(clk::input const* port, int id, widget_factory const& widget_factory,
+        evaluation_view const& evaluation, bool const& draw_port_widgets);
     input_viewer(input_viewer const&) = delete;
     input_viewer(input_viewer&&) noexcept = delete;
     auto operator=(input_viewer const&) -> input_viewer& = delete;
@@ -66,7 +75,8 @@ class output_viewer final : public port_viewer
 {
 public:
     output_viewer() = delete;
-    output_viewer(clk::output const* port, int id, widget_factory const& widget_factory, bool const& draw_port_widgets);
+    output_viewer(clk::output const* port, int id, widget_factory const& widget_factory,
+        evaluation_view const& evaluation, bool const& draw_port_widgets);
     output_viewer(output_viewer const&) = delete;
     output_viewer(output_viewer&&) noexcept = delete;
     auto operator=(output_viewer const&) -> output_viewer& = delete;
@@ -81,6 +91,6 @@ private:
 };
 
 auto create_port_viewer(clk::port const* port, int id, widget_factory const& widget_factory,
-    bool const& draw_port_widgets) -> std::unique_ptr<port_viewer>;
+    evaluation_view const& evaluation, bool const& draw_port_widgets) -> std::unique_ptr<port_viewer>;
 
 } // namespace clk::gui::impl
@@ -38,8 +38,10 @@ public:
     {
         if(ImNodes::NumSelectedNodes() != static_cast<int>(_selected_nodes.size()) || _selected_nodes.size() == 1)
         {
+            // nodes that were removed from the graph have no widget anymore
             for(auto* node : _selected_nodes)
-                _node_cache->widget_for(node).set_highlighted(false);
+                if(_node_cache->has_widget_for(node))
+                    _node_cache->widget_for(node).set_highlighted(false);
 
             _selected_nodes.clear();
             if(ImNodes::NumSelectedNodes() > 0)
@@ -68,7 +70,8 @@ public:
             }
 
             if(_hovered_node != nullptr && new_hovered_node != _hovered_node &&
-                _selected_nodes.find(_hovered_node) == _selected_nodes.end())
+                _selected_nodes.find(_hovered_node) == _selected_nodes.end() &&
+                _node_cache->has_widget_for(_hovered_node))
                 _node_cache->widget_for(_hovered_node).set_highlighted(false);
 
             _hovered_node = new_hovered_node;
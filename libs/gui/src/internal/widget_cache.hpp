@@ -1,12 +1,19 @@
 #pragma once
 
+#include "clk/base/graph.hpp"
+#include "clk/base/node.hpp"
+
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <stdexcept>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace clk::gui::impl
 {
+// Ids are never handed out twice, so a widget created for data at the address of removed data starts with a fresh id
+// and ImNodes does not mix up the state of the two. Widgets have to be removed together with their data though.
 template <typename DataType, typename Widget>
 class widget_cache
 {
@@ -64,6 +71,38 @@ public:
         }
     }
 
+    void remove_widget_for(DataType* data)
+    {
+        if(auto found_it = _data_type_to_widget.find(data); found_it != _data_type_to_widget.end())
+        {
+            _id_to_widget.erase(found_it->second->id());
+            _data_type_to_widget.erase(found_it);
+        }
+    }
+
+    // removes the widgets of all data for which keep returns false
+    template <typename Predicate>
+    void remove_widgets_unless(Predicate const& keep)
+    {
+        for(auto it = _data_type_to_widget.begin(); it != _data_type_to_widget.end();)
+        {
+            if(keep(it->first))
+            {
+                ++it;
+            }
+            else
+            {
+                _id_to_widget.erase(it->second->id());
+                it = _data_type_to_widget.erase(it);
+            }
+        }
+    }
+
+    auto size() const -> std::size_t
+    {
+        return _data_type_to_widget.size();
+    }
+
 private:
     factory _make_widget;
     std::unordered_map<DataType*, std::unique_ptr<Widget>> _data_type_to_widget;
@@ -71,4 +110,22 @@ private:
     int _next_available_id = 0;
 };
 
+// removes the widgets of nodes and ports that are not part of the graph anymore, returns the ports that are
+template <typename NodeCache, typename PortCache>
+auto remove_stale_widgets(clk::graph const& graph, NodeCache& node_cache, PortCache& port_cache)
+    -> std::unordered_set<clk::port const*>
+{
+    std::unordered_set<clk::node const*> nodes;
+    std::unordered_set<clk::port const*> ports;
+    for(auto const& node : graph.nodes())
+    {
+        nodes.insert(node.get());
+        for(auto* port : node->all_ports())
+            ports.insert(port);
+    }
+    node_cache.remove_widgets_unless([&](clk::node const* node) { return nodes.count(node) != 0; });
+    port_cache.remove_widgets_unless([&](clk::port const* port) { return ports.count(port) != 0; });
+    return ports;
+}
+
 } // namespace clk::gui::impl
@@ -15,6 +15,11 @@ void panel::orphan(panel&& panel)
     _orphaned_panels.emplace_back(std::move(panel));
 }
 
+void panel::delete_orphans()
+{
+    _orphaned_panels.clear();
+}
+
 panel::panel() : _title("Unnamed panel")
 {
     update_title_with_id();
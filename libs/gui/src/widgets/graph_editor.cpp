@@ -2,22 +2,28 @@
 #include "clk/base/algorithm.hpp"
 #include "clk/base/algorithm_node.hpp"
 #include "clk/base/constant_node.hpp"
+#include "clk/base/evaluation_service.hpp"
 #include "clk/base/graph.hpp"
 #include "clk/base/input.hpp"
 #include "clk/base/node.hpp"
 #include "clk/base/output.hpp"
 #include "clk/base/passthrough_node.hpp"
 #include "clk/base/port.hpp"
+#include "clk/gui/imgui_conversions.hpp"
+#include "clk/gui/init.hpp"
 #include "clk/gui/widgets/action_widget.hpp"
 #include "clk/gui/widgets/editor.hpp"
 #include "clk/gui/widgets/widget.hpp"
 #include "clk/gui/widgets/widget_factory.hpp"
 #include "clk/gui/widgets/widget_tree.hpp"
+#include "clk/layout/layered_layout.hpp"
 #include "clk/util/color_rgb.hpp"
 #include "clk/util/color_rgba.hpp"
 #include "clk/util/timestamp.hpp"
+#include "evaluation_view.hpp"
 #include "imgui_guard.hpp"
 #include "layout_solver.hpp"
+#include "level_of_detail.hpp"
 #include "node_editors.hpp"
 #include "port_color.hpp"
 #include "port_editors.hpp"
@@ -26,6 +32,7 @@
 
 #include <chrono>
 #include <cstddef>
+#include <glm/glm.hpp>
 #include <imgui.h>
 #include <imgui_internal.h>
 #include <imnodes.h>
@@ -48,14 +55,17 @@ graph_editor::graph_editor(std::shared_ptr<widget_factory const> factory, std::s
     : editor_of<clk::graph>(std::move(factory), name)
     , _context(ImNodes::EditorContextCreate())
     , _node_cache(std::make_unique<impl::widget_cache<node, impl::node_editor>>([&](node* node, int id) {
-        return impl::create_node_editor(
-            node, id, _port_cache.get(), _queued_action, *get_widget_factory(), _draw_node_titles);
+        return impl::create_node_editor(node, id, _port_cache.get(), _queued_action, *_evaluation_view,
+            *get_widget_factory(), _level_of_detail->draws_node_titles());
     }))
     , _port_cache(std::make_unique<impl::widget_cache<port, impl::port_editor>>([&](port* port, int id) {
-        return impl::create_port_editor(port, id, *get_widget_factory(), _draw_port_widgets);
+        return impl::create_port_editor(
+            port, id, *get_widget_factory(), *_evaluation_view, _level_of_detail->draws_port_widgets());
     }))
     , _selection_manager(std::make_unique<impl::selection_manager<false>>(_node_cache.get(), _port_cache.get()))
     , _layout_solver(std::make_unique<impl::layout_solver>())
+    , _level_of_detail(std::make_unique<impl::level_of_detail>(_draw_node_titles, _draw_port_widgets))
+    , _evaluation_view(std::make_unique<impl::evaluation_view>())
 {
     auto const& f = *get_widget_factory();
     settings().add(f.create(_draw_node_titles, "Draw node titles"));
@@ -65,7 +75,17 @@ graph_editor::graph_editor(std::shared_ptr<widget_factory const> factory, std::s
             center_view();
         },
         "Center view"));
+    settings().add(std::make_unique<action_widget>(
+        [&]() {
+            // the force based solver would pull the layers apart again
+            _enable_layout_solver = false;
+            _auto_layout_queued = true;
+        },
+        "Auto layout"));
+    settings().add(f.create(_cull_off_screen_nodes, "Cull off-screen nodes"));
+    settings().add(f.create(_evaluate_on_demand, "Only evaluate nodes on screen"));
 
+    _level_of_detail->register_settings(settings().get_subtree("Level of detail"), f);
     {
         auto& layout_solver_settings = settings().get_subtree("Force based layout solver");
         layout_solver_settings.add(f.create(_enable_layout_solver, "Enabled"));
@@ -99,6 +119,7 @@ graph_editor::graph_editor(std::shared_ptr<widget_factory const> factory, std::s
 
 graph_editor::~graph_editor()
 {
+    release_evaluated_graph();
     ImNodes::EditorContextFree(_context);
 }
 
@@ -124,22 +145,41 @@ auto graph_editor::draw_contents(clk::graph& graph) const -> bool
     if(is_first_draw())
         center_view();
 
-    auto last_timestamp = graph.timestamp().time_point();
+    auto last_timestamp = graph.timestamp();
     auto time_since_last_modification = std::chrono::duration_cast<std::chrono::duration<float, std::ratio<1, 1>>>(
-        std::chrono::steady_clock::now() - last_timestamp);
+        std::chrono::steady_clock::now() - graph.last_modification_time());
+
+    if(_evaluated_graph != &graph)
+    {
+        release_evaluated_graph();
+        _evaluation_service = impl::evaluation_service_for(graph);
+        _evaluated_graph = &graph;
+    }
+    // while the worker evaluates the graph, the published snapshot is drawn and the graph can not be edited
+    _evaluation_view->begin_frame(_evaluation_service);
+    bool const live = _evaluation_view->is_live();
 
     ImGui::Text("Last modified: %.1fs", time_since_last_modification.count());
+    if(_evaluation_view->is_busy())
+    {
+        ImGui::SameLine();
+        ImGui::TextDisabled("Evaluating, %zu queued", _evaluation_view->queued_request_count());
+    }
 
     ImNodes::EditorContextSet(_context);
     ImNodes::PushStyleVar(ImNodesStyleVar_NodeCornerRounding, 0.0f);
     ImNodes::PushStyleVar(ImNodesStyleVar_PinOffset, ImNodes::GetStyle().PinHoverRadius * 0.75f);
+    remove_stale_widgets(graph);
     draw_graph(graph);
-    draw_menus(graph);
-    update_connections(graph);
+    if(live)
+    {
+        draw_menus(graph);
+        update_connections(graph);
+    }
     _selection_manager->update();
     handle_mouse_interactions(graph);
 
-    if(_queued_action.has_value())
+    if(live && _queued_action.has_value())
     {
         if((*_queued_action)())
             _queued_action = std::nullopt;
@@ -149,7 +189,14 @@ auto graph_editor::draw_contents(clk::graph& graph) const -> bool
     ImNodes::PopStyleVar();
     ImNodes::EditorContextSet(nullptr);
 
-    return last_timestamp != graph.timestamp().time_point();
+    // the next frame shows the results of the modification and retries the queued action
+    bool const modified = last_timestamp != graph.timestamp();
+    if(modified || _queued_action.has_value())
+        request_redraw();
+
+    _evaluation_view->end_frame();
+
+    return modified;
 }
 
 void graph_editor::draw_graph(clk::graph& graph) const
@@ -159,8 +206,9 @@ void graph_editor::draw_graph(clk::graph& graph) const
     ImNodes::PushAttributeFlag(ImNodesAttributeFlags_EnableLinkCreationOnSnap);
     if(_new_connection_in_progress)
     {
-        if(_new_connection_in_progress->starting_port.is_faulty())
+        if(_evaluation_view->is_faulty(_new_connection_in_progress->starting_port))
         {
+            request_redraw();
             const float t = std::chrono::duration_cast<std::chrono::duration<float, std::ratio<1, 1>>>(
                 std::chrono::steady_clock::now().time_since_epoch())
                                 .count();
@@ -198,7 +246,10 @@ void graph_editor::draw_graph(clk::graph& graph) const
         ImGui::SetWindowHitTestHole(current_window, current_window->Pos, current_window->Size);
     }
 
-    if(_clear_connections_queued)
+    // the stress tests wait until the graph can be modified
+    bool const live = _evaluation_view->is_live();
+
+    if(_clear_connections_queued && live)
     {
         for(const auto& node : graph.nodes())
             for(auto* port : node->all_ports())
@@ -207,7 +258,7 @@ void graph_editor::draw_graph(clk::graph& graph) const
         _clear_connections_queued = false;
     }
 
-    if(_randomize_connections_queued)
+    if(_randomize_connections_queued && live)
     {
         std::mt19937 generator(static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()));
         std::uniform_real_distribution<float> distribution(0, 1);
@@ -242,7 +293,7 @@ void graph_editor::draw_graph(clk::graph& graph) const
         _randomize_connections_queued = false;
     }
 
-    if(_add_random_node_queued)
+    if(_add_random_node_queued && live)
     {
         std::mt19937 generator(static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()));
         std::uniform_int_distribution<std::size_t> dis(0, clk::algorithm::factories().size() - 1);
@@ -250,17 +301,38 @@ void graph_editor::draw_graph(clk::graph& graph) const
         auto it = clk::algorithm::factories().begin();
         std::advance(it, index);
         auto random_node = std::make_unique<algorithm_node>(it->second());
-        graph.add_node(std::move(random_node));
+        add_node(graph, std::move(random_node));
         _add_random_node_queued = false;
     }
 
-    for(auto const& node : graph.nodes())
+    select_drawn_nodes(graph);
+    _level_of_detail->update(_drawn_nodes.size());
+    if(live)
+        observe_drawn_outputs(graph);
+    for(auto* node : _drawn_nodes)
+        _node_cache->widget_for(node).draw();
+
+    // links are only drawn between drawn nodes, and only if at least one of them is on screen
+    for(auto* node : _drawn_nodes)
     {
-        _node_cache->widget_for(node.get()).draw();
+        bool const on_screen = _node_cache->widget_for(node).is_on_screen();
         for(auto* output : node->outputs())
+        {
             for(auto* input : output->connected_inputs())
-                if(_port_cache->has_widget_for(input))
+            {
+                auto it = _port_owners.find(input);
+                if(it == _port_owners.end() || _drawn_node_set.count(it->second) == 0)
+                    continue;
+                if(on_screen || _node_cache->widget_for(it->second).is_on_screen())
                     _connections.emplace_back(std::make_pair(input, output));
+            }
+        }
+    }
+
+    if(_auto_layout_queued)
+    {
+        run_auto_layout(graph);
+        _auto_layout_queued = false;
     }
 
     {
@@ -287,8 +359,9 @@ void graph_editor::draw_graph(clk::graph& graph) const
                 clk::color_rgba(clk::color_rgb::create_random(connection.first->data_type_hash()), link_opacity)
                     .packed();
 
-            if(connection.first->is_faulty() || connection.second->is_faulty())
+            if(_evaluation_view->is_faulty(*connection.first) || _evaluation_view->is_faulty(*connection.second))
             {
+                request_redraw();
                 const float t = std::chrono::duration_cast<std::chrono::duration<float, std::ratio<1, 1>>>(
                     std::chrono::steady_clock::now().time_since_epoch())
                                     .count();
@@ -338,6 +411,121 @@ void graph_editor::draw_graph(clk::graph& graph) const
 
     ImNodes::EndNodeEditor();
     ImNodes::PopAttributeFlag();
+
+    for(auto* node : _drawn_nodes)
+        _node_cache->widget_for(node).update_grid_position();
+}
+
+void graph_editor::remove_stale_widgets(clk::graph const& graph) const
+{
+    if(_widget_caches_timestamp == graph.timestamp())
+        return;
+
+    auto const ports = impl::remove_stale_widgets(graph, *_node_cache, *_port_cache);
+    for(auto it = _observed_outputs.begin(); it != _observed_outputs.end();)
+        it = ports.count(*it) != 0 ? std::next(it) : _observed_outputs.erase(it);
+    _widget_caches_timestamp = graph.timestamp();
+}
+
+void graph_editor::select_drawn_nodes(clk::graph const& graph) const
+{
+    if(_port_owners_timestamp != graph.timestamp())
+    {
+        _port_owners.clear();
+        for(auto const& node : graph.nodes())
+            for(auto* port : node->all_ports())
+                _port_owners[port] = node.get();
+        _port_owners_timestamp = graph.timestamp();
+    }
+
+    _drawn_nodes.clear();
+    _drawn_node_set.clear();
+
+    glm::vec2 const view_min = -to_glm(ImNodes::EditorContextGetPanning());
+    glm::vec2 const view_max = view_min + to_glm(ImGui::GetWindowSize());
+    for(auto const& node : graph.nodes())
+    {
+        auto& node_editor = _node_cache->widget_for(node.get());
+        bool const on_screen = !_cull_off_screen_nodes || node_editor.is_visible_in(view_min, view_max);
+        node_editor.set_on_screen(on_screen);
+        if(on_screen)
+        {
+            _drawn_nodes.push_back(node.get());
+            _drawn_node_set.insert(node.get());
+        }
+    }
+
+    if(!_cull_off_screen_nodes)
+        return;
+
+    // off-screen nodes linked to a visible node are drawn as well, so their end of the link has a pin
+    std::size_t const visible_count = _drawn_nodes.size();
+    for(std::size_t i = 0; i < visible_count; i++)
+    {
+        for(auto* port : _drawn_nodes[i]->all_ports())
+        {
+            for(auto* connected_port : port->connected_ports())
+            {
+                auto it = _port_owners.find(connected_port);
+                if(it != _port_owners.end() && _drawn_node_set.insert(it->second).second)
+                    _drawn_nodes.push_back(it->second);
+            }
+        }
+    }
+}
+
+void graph_editor::observe_drawn_outputs(clk::graph& graph) const
+{
+    if(graph.is_demand_driven() != _evaluate_on_demand)
+    {
+        if(!_graph_was_demand_driven.has_value())
+            _graph_was_demand_driven = graph.is_demand_driven();
+        graph.set_demand_driven(_evaluate_on_demand);
+    }
+
+    // linked nodes off screen are drawn as pins only, their data is not shown, the nodes on screen are observed even
+    // while the level of detail hides their port widgets, otherwise nothing would be evaluated in large graphs
+    std::vector<clk::node*> shown_nodes;
+    std::unordered_set<clk::output const*> shown_outputs;
+    for(auto* node : _drawn_nodes)
+    {
+        if(!_node_cache->widget_for(node).is_on_screen())
+            continue;
+        shown_nodes.push_back(node);
+        for(auto const* output : node->outputs())
+            shown_outputs.insert(output);
+        for(auto const* input : node->inputs())
+            if(auto const* output = input->connected_output(); output != nullptr)
+                shown_outputs.insert(output);
+    }
+
+    for(auto const* output : _observed_outputs)
+        if(shown_outputs.count(output) == 0)
+            graph.unobserve(*output);
+    for(auto const* output : shown_outputs)
+        if(_observed_outputs.count(output) == 0)
+            graph.observe(*output);
+    _observed_outputs = std::move(shown_outputs);
+
+    // pushes skip the nodes while they are not shown, and nodes without outputs are never demanded
+    for(auto* node : shown_nodes)
+        if(node->is_outdated())
+            _evaluation_view->pull(*node);
+}
+
+void graph_editor::release_evaluated_graph() const
+{
+    if(_evaluated_graph == nullptr)
+        return;
+
+    // the worker may be evaluating the graph
+    auto lock = _evaluation_service->lock();
+    for(auto const* output : _observed_outputs)
+        _evaluated_graph->unobserve(*output);
+    _observed_outputs.clear();
+    if(_graph_was_demand_driven.has_value())
+        _evaluated_graph->set_demand_driven(*_graph_was_demand_driven);
+    _graph_was_demand_driven = std::nullopt;
 }
 
 void graph_editor::draw_menus(clk::graph& graph) const
@@ -382,7 +570,7 @@ void graph_editor::draw_menus(clk::graph& graph) const
             {
                 if(!_node_cache->has_widget_for(new_node.get()))
                     ImNodes::SetNodeScreenSpacePos(_node_cache->widget_for(new_node.get()).id(), ImGui::GetMousePos());
-                graph.add_node(std::move(new_node));
+                add_node(graph, std::move(new_node));
             }
 
             if(ImGui::MenuItem("Random node"))
@@ -416,7 +604,7 @@ void graph_editor::draw_menus(clk::graph& graph) const
                                 dynamic_cast<output*>(input->create_compatible_port().release())));
                     }
 
-                    graph.add_node(std::move(constant_node));
+                    add_node(graph, std::move(constant_node));
                 }
             }
             delet_this = ImGui::MenuItem("Delete");
@@ -432,12 +620,12 @@ void graph_editor::draw_menus(clk::graph& graph) const
             std::vector<int> selected_links(ImNodes::NumSelectedLinks());
             ImNodes::GetSelectedLinks(selected_links.data());
             for(auto link_id : selected_links)
-                _connections[link_id].first->disconnect_from(*_connections[link_id].second);
+                change_connection(*_connections[link_id].first, *_connections[link_id].second, false);
             ImNodes::ClearLinkSelection();
         }
 
         for(auto* selected_node : _selection_manager->selected_nodes())
-            graph.remove_node(selected_node);
+            remove_node(graph, selected_node);
 
         ImNodes::ClearNodeSelection();
     }
@@ -472,7 +660,10 @@ void graph_editor::update_connections(clk::graph& graph) const
         auto* output = dynamic_cast<clk::output*>(_port_cache->widget_for(output_id).port());
 
         if(_new_connection_in_progress->ending_port != nullptr)
-            _new_connection_in_progress->starting_port.disconnect_from(*_new_connection_in_progress->ending_port);
+        {
+            auto& connection = *_new_connection_in_progress;
+            change_connection(connection.starting_port, *connection.ending_port, false);
+        }
 
         if(input == &_new_connection_in_progress->starting_port)
             _new_connection_in_progress->ending_port = output;
@@ -484,13 +675,14 @@ void graph_editor::update_connections(clk::graph& graph) const
         if(input->is_connected())
             _new_connection_in_progress->dropped_connection = std::pair(input, input->connected_output());
 
-        input->connect_to(*output);
+        change_connection(*input, *output, true);
     }
 
     if(int dummy = -1; _new_connection_in_progress && _new_connection_in_progress->ending_port != nullptr &&
                        !ImNodes::IsPinHovered(&dummy))
     {
-        _new_connection_in_progress->starting_port.disconnect_from(*_new_connection_in_progress->ending_port);
+        auto& connection = *_new_connection_in_progress;
+        change_connection(connection.starting_port, *connection.ending_port, false);
         _new_connection_in_progress->ending_port = nullptr;
         restore_dropped_connection();
     }
@@ -514,12 +706,13 @@ void graph_editor::handle_mouse_interactions(clk::graph& graph) const
         }
     }
 
-    if(ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left) && ImNodes::NumSelectedLinks() > 0)
+    if(ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left) && ImNodes::NumSelectedLinks() > 0 &&
+        _evaluation_view->is_live())
     {
         std::vector<int> selected_links(ImNodes::NumSelectedLinks());
         ImNodes::GetSelectedLinks(selected_links.data());
         for(auto link_id : selected_links)
-            _connections[link_id].first->disconnect_from(*_connections[link_id].second);
+            change_connection(*_connections[link_id].first, *_connections[link_id].second, false);
         ImNodes::ClearLinkSelection();
     }
 }
@@ -528,16 +721,71 @@ void graph_editor::restore_dropped_connection() const
 {
     if(_new_connection_in_progress && _new_connection_in_progress->dropped_connection)
     {
-        _new_connection_in_progress->dropped_connection->first->connect_to(
-            *_new_connection_in_progress->dropped_connection->second);
+        auto [input, output] = *_new_connection_in_progress->dropped_connection;
+        change_connection(*input, *output, true);
         _new_connection_in_progress->dropped_connection = std::nullopt;
     }
 }
 
+void graph_editor::add_node(clk::graph& graph, std::unique_ptr<clk::node>&& node) const
+{
+    auto const previous_timestamp = graph.timestamp();
+    auto& added_node = *node;
+    graph.add_node(std::move(node));
+    _layout_solver->node_added(previous_timestamp, graph, added_node, *_node_cache, *_port_cache);
+}
+
+void graph_editor::remove_node(clk::graph& graph, clk::node* node) const
+{
+    auto const previous_timestamp = graph.timestamp();
+    auto const ports = node->all_ports();
+    // a node created later at the same address must not pick up the widgets of the removed one
+    for(auto* port : ports)
+        _port_cache->remove_widget_for(port);
+    _node_cache->remove_widget_for(node);
+    _evaluation_view->cancel(*node);
+    graph.remove_node(node);
+    _layout_solver->node_removed(previous_timestamp, graph, node, ports);
+}
+
+void graph_editor::change_connection(clk::port& first, clk::port& second, bool connect) const
+{
+    auto const previous_timestamp = _evaluated_graph->timestamp();
+    if(connect)
+        first.connect_to(second, false);
+    else
+        first.disconnect_from(second, false);
+    _layout_solver->connections_changed(previous_timestamp, *_evaluated_graph, first, second, *_port_cache);
+    evaluate_connection_change(first, second);
+}
+
+void graph_editor::evaluate_connection_change(clk::port& first, clk::port& second) const
+{
+    auto* input = dynamic_cast<clk::input*>(&first);
+    if(input == nullptr)
+        input = dynamic_cast<clk::input*>(&second);
+    if(input != nullptr)
+        _evaluation_view->push(*input);
+}
+
 void graph_editor::run_layout_solver(clk::graph const& graph) const
 {
     _layout_solver->update_cache(graph, *_node_cache, *_port_cache);
     _layout_solver->step();
+    if(!_layout_solver->is_settled())
+        request_redraw();
+}
+
+void graph_editor::run_auto_layout(clk::graph const& graph) const
+{
+    std::vector<glm::vec2> node_sizes;
+    node_sizes.reserve(graph.nodes().size());
+    for(auto const& node : graph.nodes())
+        node_sizes.push_back(_node_cache->widget_for(node.get()).dimensions());
+
+    clk::layout::layered_layout const layout(graph, node_sizes);
+    for(std::size_t i = 0; i < graph.nodes().size(); i++)
+        _node_cache->widget_for(graph.nodes()[i].get()).set_grid_position(layout.positions()[i]);
 }
 
 } // namespace clk::gui
@@ -5,14 +5,18 @@
 #include "clk/base/output.hpp"
 #include "clk/base/port.hpp"
 #include "clk/gui/imgui_conversions.hpp"
+#include "clk/gui/init.hpp"
 #include "clk/gui/widgets/action_widget.hpp"
 #include "clk/gui/widgets/widget.hpp"
 #include "clk/gui/widgets/widget_factory.hpp"
 #include "clk/gui/widgets/widget_tree.hpp"
 #include "clk/util/color_rgb.hpp"
 #include "clk/util/color_rgba.hpp"
+#include "clk/util/timestamp.hpp"
+#include "evaluation_view.hpp"
 #include "imgui_guard.hpp"
 #include "layout_solver.hpp"
+#include "level_of_detail.hpp"
 #include "node_viewers.hpp"
 #include "port_viewers.hpp"
 #include "selection_manager.hpp"
@@ -33,14 +37,18 @@ graph_viewer::graph_viewer(std::shared_ptr<widget_factory const> factory, std::s
     , _context(ImNodes::EditorContextCreate())
     , _node_cache(
           std::make_unique<impl::widget_cache<clk::node const, impl::node_viewer>>([&](node const* node, int id) {
-              return impl::create_node_viewer(node, id, _port_cache.get(), _draw_node_titles);
+              return impl::create_node_viewer(
+                  node, id, _port_cache.get(), *_evaluation_view, _level_of_detail->draws_node_titles());
           }))
     , _port_cache(
           std::make_unique<impl::widget_cache<clk::port const, impl::port_viewer>>([&](port const* port, int id) {
-              return impl::create_port_viewer(port, id, *get_widget_factory(), _draw_port_widgets);
+              return impl::create_port_viewer(
+                  port, id, *get_widget_factory(), *_evaluation_view, _level_of_detail->draws_port_widgets());
           }))
     , _selection_manager(std::make_unique<impl::selection_manager<true>>(_node_cache.get(), _port_cache.get()))
     , _layout_solver(std::make_unique<impl::layout_solver>())
+    , _level_of_detail(std::make_unique<impl::level_of_detail>(_draw_node_titles, _draw_port_widgets))
+    , _evaluation_view(std::make_unique<impl::evaluation_view>())
 {
     auto const& f = *get_widget_factory();
     settings().add(f.create(_draw_node_titles, "Draw node titles"));
@@ -51,6 +59,7 @@ graph_viewer::graph_viewer(std::shared_ptr<widget_factory const> factory, std::s
         },
         "Center view"));
 
+    _level_of_detail->register_settings(settings().get_subtree("Level of detail"), f);
     {
         auto& layout_solver_settings = settings().get_subtree("Force based layout solver");
         layout_solver_settings.add(f.create(_enable_layout_solver, "Enabled"));
@@ -86,10 +95,13 @@ void graph_viewer::center_view() const
 
 void graph_viewer::draw_contents(clk::graph const& graph) const
 {
+    // the viewer does not start a worker, it only follows the one of an editor of the same graph
+    _evaluation_view->begin_frame(impl::find_evaluation_service(graph));
     ImNodes::EditorContextSet(_context);
     ImNodes::PushStyleVar(ImNodesStyleVar_NodeCornerRounding, 0.0f);
     ImNodes::PushStyleVar(ImNodesStyleVar_PinOffset, ImNodes::GetStyle().PinHoverRadius * 0.5f);
 
+    remove_stale_widgets(graph);
     draw_graph(graph);
     _selection_manager->update();
 
@@ -101,6 +113,16 @@ void graph_viewer::draw_contents(clk::graph const& graph) const
         ImNodes::EditorContextResetPanning(to_imgui(to_glm(ImGui::GetItemRectSize()) / 2.0f));
     }
     ImNodes::EditorContextSet(nullptr);
+    _evaluation_view->end_frame();
+}
+
+void graph_viewer::remove_stale_widgets(clk::graph const& graph) const
+{
+    if(_widget_caches_timestamp == graph.timestamp())
+        return;
+
+    impl::remove_stale_widgets(graph, *_node_cache, *_port_cache);
+    _widget_caches_timestamp = graph.timestamp();
 }
 
 void graph_viewer::draw_graph(clk::graph const& graph) const
@@ -122,6 +144,7 @@ void graph_viewer::draw_graph(clk::graph const& graph) const
         ImGui::SetWindowHitTestHole(current_window, current_window->Pos, current_window->Size);
     }
 
+    _level_of_detail->update(graph.nodes().size());
     for(auto const& node : graph.nodes())
     {
         _node_cache->widget_for(node.get()).draw();
@@ -136,7 +159,7 @@ void graph_viewer::draw_graph(clk::graph const& graph) const
         for(auto& connection : _connections)
         {
             imgui_guard link_style_guard;
-            if(connection.first->is_faulty() || connection.second->is_faulty())
+            if(_evaluation_view->is_faulty(*connection.first) || _evaluation_view->is_faulty(*connection.second))
             {
                 const float t = std::chrono::duration_cast<std::chrono::duration<float, std::ratio<1, 1>>>(
                     std::chrono::steady_clock::now().time_since_epoch())
@@ -171,6 +194,8 @@ void graph_viewer::run_layout_solver(clk::graph const& graph) const
 {
     _layout_solver->update_cache(graph, *_node_cache, *_port_cache);
     _layout_solver->step();
+    if(!_layout_solver->is_settled())
+        request_redraw();
 }
 
 } // namespace clk::gui
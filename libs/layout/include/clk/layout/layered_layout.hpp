@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace clk
+{
+class graph;
+} // namespace clk
+
+namespace clk::layout
+{
+struct layered_layout_settings
+{
+    // horizontal space between the widest node of a layer and the next layer
+    float layer_spacing = 80.0f;
+    // vertical space between neighbouring nodes of a layer
+    float node_spacing = 20.0f;
+    // every sweep reorders the layers once from left to right and once from right to left
+    std::size_t ordering_sweeps = 8;
+    std::size_t positioning_sweeps = 8;
+};
+
+// Arranges the nodes of a graph in layers from left to right, following the direction of their connections:
+//
+//     1. connections that close a cycle are reversed, so the graph can be layered
+//     2. every node is put one layer behind the last node it depends on, nodes with dependants are moved as close to
+//        them as possible
+//     3. the nodes of every layer are reordered by the average position of their neighbours to reduce crossings, long
+//        connections pass every layer in between as a virtual node
+//     4. the nodes are moved towards their neighbours vertically without overlapping the other nodes of their layer
+class layered_layout final
+{
+public:
+    // the sizes are in the same order as the nodes of the graph
+    layered_layout(clk::graph const& graph, std::vector<glm::vec2> const& node_sizes,
+        layered_layout_settings const& settings = {});
+    layered_layout(layered_layout const&) = default;
+    layered_layout(layered_layout&&) noexcept = default;
+    auto operator=(layered_layout const&) -> layered_layout& = default;
+    auto operator=(layered_layout&&) noexcept -> layered_layout& = default;
+    ~layered_layout() = default;
+
+    // the top left corners of the nodes, in the same order as the nodes of the graph
+    auto positions() const -> std::vector<glm::vec2> const&;
+    auto layers() const -> std::vector<std::size_t> const&;
+    auto layer_count() const -> std::size_t;
+    // the number of connections crossing each other, including the connections that were reversed
+    auto crossing_count() const -> std::size_t;
+
+private:
+    std::vector<glm::vec2> _positions;
+    std::vector<std::size_t> _layers;
+    std::size_t _layer_count = 0;
+    std::size_t _crossing_count = 0;
+};
+
+} // namespace clk::layout
@@ -0,0 +1,451 @@
+#include "clk/layout/layered_layout.hpp"
+#include "clk/base/graph.hpp"
+#include "clk/base/input.hpp"
+#include "clk/base/node.hpp"
+#include "clk/base/output.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace clk::layout
+{
+namespace
+{
+using edge = std::pair<std::size_t, std::size_t>;
+
+// the neighbours of every vertex of a directed graph, stored as compressed rows
+class adjacency final
+{
+public:
+    struct range
+    {
+        std::size_t const* first;
+        std::size_t const* last;
+
+        auto begin() const -> std::size_t const*
+        {
+            return first;
+        }
+        auto end() const -> std::size_t const*
+        {
+            return last;
+        }
+        auto empty() const -> bool
+        {
+            return first == last;
+        }
+        auto size() const -> std::size_t
+        {
+            return static_cast<std::size_t>(last - first);
+        }
+    };
+
+    // with reversed, the neighbours of a vertex are the vertices with edges leading to it
+    adjacency(std::size_t vertex_count, std::vector<edge> const& edges, bool reversed)
+        : _offsets(vertex_count + 1, 0), _neighbours(edges.size())
+    {
+        for(auto [from, to] : edges)
+            _offsets[(reversed ? to : from) + 1]++;
+        std::partial_sum(_offsets.begin(), _offsets.end(), _offsets.begin());
+
+        std::vector<std::size_t> next(_offsets.begin(), _offsets.end() - 1);
+        for(auto [from, to] : edges)
+        {
+            if(reversed)
+                _neighbours[next[to]++] = from;
+            else
+                _neighbours[next[from]++] = to;
+        }
+    }
+
+    auto neighbours(std::size_t vertex) const -> range
+    {
+        return {_neighbours.data() + _offsets[vertex], _neighbours.data() + _offsets[vertex + 1]};
+    }
+
+private:
+    std::vector<std::size_t> _offsets;
+    std::vector<std::size_t> _neighbours;
+};
+
+void remove_duplicates(std::vector<edge>& edges)
+{
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+}
+
+auto collect_edges(clk::graph const& graph) -> std::vector<edge>
+{
+    auto const& nodes = graph.nodes();
+    std::unordered_map<clk::output const*, std::size_t> output_owners;
+    for(std::size_t i = 0; i < nodes.size(); i++)
+        for(auto const* output : nodes[i]->outputs())
+            output_owners[output] = i;
+
+    std::vector<edge> edges;
+    for(std::size_t i = 0; i < nodes.size(); i++)
+    {
+        for(auto const* input : nodes[i]->inputs())
+        {
+            auto* connection = input->connected_output();
+            if(connection == nullptr)
+                continue;
+            // outputs of nodes outside of the graph are ignored, as are nodes connected to themselves
+            if(auto it = output_owners.find(connection); it != output_owners.end() && it->second != i)
+                edges.emplace_back(it->second, i);
+        }
+    }
+    remove_duplicates(edges);
+    return edges;
+}
+
+// reverses the edges leading back to a vertex that is still being visited by a depth first search
+void remove_cycles(std::size_t vertex_count, std::vector<edge>& edges)
+{
+    adjacency const successors(vertex_count, edges, false);
+    enum class state
+    {
+        unvisited,
+        visiting,
+        visited
+    };
+    std::vector<state> states(vertex_count, state::unvisited);
+    std::vector<std::pair<std::size_t, std::size_t const*>> stack;
+    std::vector<edge> back_edges;
+
+    for(std::size_t root = 0; root < vertex_count; root++)
+    {
+        if(states[root] != state::unvisited)
+            continue;
+
+        states[root] = state::visiting;
+        stack.emplace_back(root, successors.neighbours(root).begin());
+        while(!stack.empty())
+        {
+            auto& [vertex, next] = stack.back();
+            if(next == successors.neighbours(vertex).end())
+            {
+                states[vertex] = state::visited;
+                stack.pop_back();
+                continue;
+            }
+
+            std::size_t const successor = *next++;
+            if(states[successor] == state::visiting)
+            {
+                back_edges.emplace_back(vertex, successor);
+            }
+            else if(states[successor] == state::unvisited)
+            {
+                states[successor] = state::visiting;
+                stack.emplace_back(successor, successors.neighbours(successor).begin());
+            }
+        }
+    }
+
+    if(back_edges.empty())
+        return;
+
+    for(auto const& back_edge : back_edges)
+    {
+        auto it = std::lower_bound(edges.begin(), edges.end(), back_edge);
+        std::swap(it->first, it->second);
+    }
+    remove_duplicates(edges);
+}
+
+// every vertex is put one layer behind its last predecessor, then vertices with successors are moved right in front of
+// their first successor, so sources end up next to the vertices using them instead of all in the first layer
+auto assign_layers(std::size_t vertex_count, std::vector<edge> const& edges) -> std::vector<std::size_t>
+{
+    adjacency const successors(vertex_count, edges, false);
+    std::vector<std::size_t> remaining_predecessors(vertex_count, 0);
+    for(auto [from, to] : edges)
+        remaining_predecessors[to]++;
+
+    std::vector<std::size_t> order;
+    order.reserve(vertex_count);
+    for(std::size_t vertex = 0; vertex < vertex_count; vertex++)
+        if(remaining_predecessors[vertex] == 0)
+            order.push_back(vertex);
+    for(std::size_t i = 0; i < order.size(); i++)
+        for(std::size_t successor : successors.neighbours(order[i]))
+            if(--remaining_predecessors[successor] == 0)
+                order.push_back(successor);
+
+    std::vector<std::size_t> layers(vertex_count, 0);
+    for(std::size_t vertex : order)
+        for(std::size_t successor : successors.neighbours(vertex))
+            layers[successor] = std::max(layers[successor], layers[vertex] + 1);
+
+    for(auto it = order.rbegin(); it != order.rend(); ++it)
+    {
+        auto const vertex_successors = successors.neighbours(*it);
+        if(vertex_successors.empty())
+            continue;
+        std::size_t first_successor_layer = std::numeric_limits<std::size_t>::max();
+        for(std::size_t successor : vertex_successors)
+            first_successor_layer = std::min(first_successor_layer, layers[successor]);
+        layers[*it] = first_successor_layer - 1;
+    }
+    return layers;
+}
+
+// counts the pairs of edges between two neighbouring layers whose order differs in both layers
+auto count_crossings(std::vector<std::size_t> const& upper_layer, std::size_t lower_layer_size,
+    adjacency const& successors, std::vector<std::size_t> const& positions) -> std::size_t
+{
+    std::vector<std::size_t> tree(lower_layer_size + 1, 0);
+    std::vector<std::size_t> lower_positions;
+    std::size_t inserted = 0;
+    std::size_t crossings = 0;
+    for(std::size_t vertex : upper_layer)
+    {
+        lower_positions.clear();
+        for(std::size_t successor : successors.neighbours(vertex))
+            lower_positions.push_back(positions[successor]);
+        std::sort(lower_positions.begin(), lower_positions.end());
+
+        for(std::size_t position : lower_positions)
+        {
+            std::size_t not_greater = 0;
+            for(std::size_t i = position + 1; i > 0; i -= i & (~i + 1))
+                not_greater += tree[i];
+            crossings += inserted - not_greater;
+
+            for(std::size_t i = position + 1; i <= lower_layer_size; i += i & (~i + 1))
+                tree[i]++;
+            inserted++;
+        }
+    }
+    return crossings;
+}
+
+auto count_crossings(std::vector<std::vector<std::size_t>> const& layers, adjacency const& successors,
+    std::vector<std::size_t> const& positions) -> std::size_t
+{
+    std::size_t crossings = 0;
+    for(std::size_t layer = 0; layer + 1 < layers.size(); layer++)
+        crossings += count_crossings(layers[layer], layers[layer + 1].size(), successors, positions);
+    return crossings;
+}
+
+// sorts a layer by the average position of the neighbours of its vertices in the neighbouring layer, vertices without
+// neighbours keep their position
+void order_by_barycenter(std::vector<std::size_t>& layer, adjacency const& neighbours,
+    std::vector<std::size_t>& positions, std::vector<double>& keys)
+{
+    for(std::size_t vertex : layer)
+    {
+        auto const vertex_neighbours = neighbours.neighbours(vertex);
+        if(vertex_neighbours.empty())
+        {
+            keys[vertex] = static_cast<double>(positions[vertex]);
+            continue;
+        }
+
+        double sum = 0.0;
+        for(std::size_t neighbour : vertex_neighbours)
+            sum += static_cast<double>(positions[neighbour]);
+        keys[vertex] = sum / static_cast<double>(vertex_neighbours.size());
+    }
+
+    std::stable_sort(layer.begin(), layer.end(), [&](std::size_t lhs, std::size_t rhs) {
+        return keys[lhs] < keys[rhs];
+    });
+    for(std::size_t i = 0; i < layer.size(); i++)
+        positions[layer[i]] = i;
+}
+
+// moves the vertices of a layer as close to their desired centres as possible while keeping their order and spacing,
+// which is an isotonic regression of the desired centres minus the space taken by the vertices in front of them
+void place_layer(std::vector<std::size_t> const& layer, std::vector<float> const& heights, float spacing,
+    std::vector<float> const& desired_centres, std::vector<float>& centres)
+{
+    struct block
+    {
+        double sum = 0.0;
+        std::size_t count = 0;
+
+        auto mean() const -> double
+        {
+            return sum / static_cast<double>(count);
+        }
+    };
+
+    std::vector<float> offsets(layer.size(), 0.0f);
+    for(std::size_t i = 1; i < layer.size(); i++)
+        offsets[i] = offsets[i - 1] + (heights[layer[i - 1]] + heights[layer[i]]) / 2.0f + spacing;
+
+    std::vector<block> blocks;
+    for(std::size_t i = 0; i < layer.size(); i++)
+    {
+        blocks.push_back({static_cast<double>(desired_centres[layer[i]] - offsets[i]), 1});
+        while(blocks.size() > 1 && blocks[blocks.size() - 2].mean() > blocks.back().mean())
+        {
+            auto merged = blocks.back();
+            blocks.pop_back();
+            blocks.back().sum += merged.sum;
+            blocks.back().count += merged.count;
+        }
+    }
+
+    std::size_t i = 0;
+    for(auto const& b : blocks)
+    {
+        auto const mean = static_cast<float>(b.mean());
+        for(std::size_t j = 0; j < b.count; j++, i++)
+            centres[layer[i]] = mean + offsets[i];
+    }
+}
+
+} // namespace
+
+layered_layout::layered_layout(
+    clk::graph const& graph, std::vector<glm::vec2> const& node_sizes, layered_layout_settings const& settings)
+{
+    std::size_t const node_count = graph.nodes().size();
+    if(node_sizes.size() != node_count)
+        throw std::runtime_error("The number of node sizes does not match the number of nodes");
+
+    _positions.assign(node_count, glm::vec2{0.0f, 0.0f});
+    if(node_count == 0)
+        return;
+
+    auto edges = collect_edges(graph);
+    remove_cycles(node_count, edges);
+    _layers = assign_layers(node_count, edges);
+    _layer_count = *std::max_element(_layers.begin(), _layers.end()) + 1;
+
+    // connections spanning several layers are split by virtual vertices without a size, one in every layer they pass
+    std::vector<std::size_t> vertex_layers = _layers;
+    std::vector<glm::vec2> vertex_sizes = node_sizes;
+    std::vector<edge> vertex_edges;
+    vertex_edges.reserve(edges.size());
+    for(auto [from, to] : edges)
+    {
+        std::size_t previous = from;
+        for(std::size_t layer = _layers[from] + 1; layer < _layers[to]; layer++)
+        {
+            std::size_t const virtual_vertex = vertex_layers.size();
+            vertex_layers.push_back(layer);
+            vertex_sizes.emplace_back(0.0f, 0.0f);
+            vertex_edges.emplace_back(previous, virtual_vertex);
+            previous = virtual_vertex;
+        }
+        vertex_edges.emplace_back(previous, to);
+    }
+
+    std::size_t const vertex_count = vertex_layers.size();
+    adjacency const predecessors(vertex_count, vertex_edges, true);
+    adjacency const successors(vertex_count, vertex_edges, false);
+
+    std::vector<std::vector<std::size_t>> layers(_layer_count);
+    std::vector<std::size_t> positions(vertex_count, 0);
+    for(std::size_t vertex = 0; vertex < vertex_count; vertex++)
+    {
+        positions[vertex] = layers[vertex_layers[vertex]].size();
+        layers[vertex_layers[vertex]].push_back(vertex);
+    }
+
+    std::vector<double> keys(vertex_count, 0.0);
+    auto best_layers = layers;
+    _crossing_count = count_crossings(layers, successors, positions);
+    for(std::size_t sweep = 0; sweep < settings.ordering_sweeps && _crossing_count != 0; sweep++)
+    {
+        for(std::size_t layer = 1; layer < layers.size(); layer++)
+            order_by_barycenter(layers[layer], predecessors, positions, keys);
+        for(std::size_t layer = layers.size() - 1; layer-- > 0;)
+            order_by_barycenter(layers[layer], successors, positions, keys);
+
+        if(auto crossings = count_crossings(layers, successors, positions); crossings < _crossing_count)
+        {
+            _crossing_count = crossings;
+            best_layers = layers;
+        }
+    }
+    layers = std::move(best_layers);
+
+    std::vector<float> heights(vertex_count);
+    for(std::size_t vertex = 0; vertex < vertex_count; vertex++)
+        heights[vertex] = vertex_sizes[vertex].y;
+
+    std::vector<float> centres(vertex_count, 0.0f);
+    for(auto const& layer : layers)
+    {
+        float top = 0.0f;
+        for(std::size_t vertex : layer)
+        {
+            centres[vertex] = top + heights[vertex] / 2.0f;
+            top += heights[vertex] + settings.node_spacing;
+        }
+    }
+
+    std::vector<float> desired_centres(vertex_count, 0.0f);
+    auto place = [&](std::vector<std::size_t> const& layer) {
+        for(std::size_t vertex : layer)
+        {
+            float sum = 0.0f;
+            std::size_t count = 0;
+            for(auto const& neighbours : {predecessors.neighbours(vertex), successors.neighbours(vertex)})
+            {
+                for(std::size_t neighbour : neighbours)
+                    sum += centres[neighbour];
+                count += neighbours.size();
+            }
+            desired_centres[vertex] = count == 0 ? centres[vertex] : sum / static_cast<float>(count);
+        }
+        place_layer(layer, heights, settings.node_spacing, desired_centres, centres);
+    };
+    for(std::size_t sweep = 0; sweep < settings.positioning_sweeps; sweep++)
+    {
+        for(auto const& layer : layers)
+            place(layer);
+        for(auto it = layers.rbegin(); it != layers.rend(); ++it)
+            place(*it);
+    }
+
+    std::vector<float> layer_lefts(_layer_count, 0.0f);
+    float left = 0.0f;
+    for(std::size_t layer = 0; layer < _layer_count; layer++)
+    {
+        layer_lefts[layer] = left;
+        float width = 0.0f;
+        for(std::size_t vertex : layers[layer])
+            width = std::max(width, vertex_sizes[vertex].x);
+        left += width + settings.layer_spacing;
+    }
+
+    float top = std::numeric_limits<float>::max();
+    for(std::size_t vertex = 0; vertex < vertex_count; vertex++)
+        top = std::min(top, centres[vertex] - heights[vertex] / 2.0f);
+
+    for(std::size_t node = 0; node < node_count; node++)
+        _positions[node] = {layer_lefts[_layers[node]], centres[node] - heights[node] / 2.0f - top};
+}
+
+auto layered_layout::positions() const -> std::vector<glm::vec2> const&
+{
+    return _positions;
+}
+
+auto layered_layout::layers() const -> std::vector<std::size_t> const&
+{
+    return _layers;
+}
+
+auto layered_layout::layer_count() const -> std::size_t
+{
+    return _layer_count;
+}
+
+auto layered_layout::crossing_count() const -> std::size_t
+{
+    return _crossing_count;
+}
+
+} // namespace clk::layout
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "clk/util/color_rgb.hpp"
+#include "clk/util/data_type_name.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace clk
+{
+// A collection of colors stored as three separate planes of red, green and blue values. Every plane starts on a 64
+// byte boundary and is padded to a multiple of 16 floats, so whole vectors can be loaded past the last color.
+class color_buffer
+{
+public:
+    static constexpr std::size_t alignment = 64;
+    static constexpr std::size_t padding = alignment / sizeof(float);
+
+    color_buffer() = default;
+    explicit color_buffer(std::size_t size);
+    explicit color_buffer(std::size_t size, color_rgb const& color);
+    color_buffer(color_buffer const& that);
+    color_buffer(color_buffer&&) noexcept = default;
+    auto operator=(color_buffer const& that) -> color_buffer&;
+    auto operator=(color_buffer&&) noexcept -> color_buffer& = default;
+    ~color_buffer() = default;
+    auto operator==(color_buffer const& that) const -> bool;
+    auto operator!=(color_buffer const& that) const -> bool;
+
+    auto size() const -> std::size_t;
+    auto empty() const -> bool;
+    // keeps the colors that still fit, added colors are black
+    void resize(std::size_t size);
+    void fill(color_rgb const& color);
+
+    auto red() -> float*;
+    auto red() const -> float const*;
+    auto green() -> float*;
+    auto green() const -> float const*;
+    auto blue() -> float*;
+    auto blue() const -> float const*;
+    auto plane(std::size_t channel) -> float*;
+    auto plane(std::size_t channel) const -> float const*;
+
+    auto at(std::size_t index) const -> color_rgb;
+    void set(std::size_t index, color_rgb const& color);
+
+private:
+    struct aligned_deleter
+    {
+        void operator()(float* data) const;
+    };
+
+    std::unique_ptr<float[], aligned_deleter> _data;
+    std::size_t _size = 0;
+    std::size_t _plane_stride = 0;
+};
+
+template <>
+inline auto data_type_name<color_buffer>::get() -> std::string
+{
+    return "Color Buffer";
+}
+
+} // namespace clk
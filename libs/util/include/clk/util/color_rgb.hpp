@@ -4,6 +4,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <glm/glm.hpp>
 #include <string>
 
@@ -143,3 +144,12 @@ inline auto data_type_name<color_rgb>::get() -> std::string
 }
 
 } // namespace clk
+
+namespace std
+{
+template <>
+struct hash<clk::color_rgb>
+{
+    auto operator()(clk::color_rgb const& color) const noexcept -> std::size_t;
+};
+} // namespace std
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif(defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
+
+namespace clk
+{
+// Reads the time stamp counter of the CPU where available, which is much cheaper than reading a system clock. The
+// ticks are converted to time using a rate that is measured against the steady clock.
+class cycle_clock final
+{
+public:
+    cycle_clock() = delete;
+    cycle_clock(cycle_clock const&) = delete;
+    cycle_clock(cycle_clock&&) = delete;
+    auto operator=(cycle_clock const&) -> cycle_clock& = delete;
+    auto operator=(cycle_clock&&) -> cycle_clock& = delete;
+    ~cycle_clock() = delete;
+
+    static auto now() noexcept -> std::uint64_t
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        return __rdtsc();
+#elif(defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    // the first call may block for a few milliseconds, while the rate of the counter is measured
+    static auto nanoseconds_per_tick() -> double;
+    static auto to_nanoseconds(std::uint64_t ticks) -> std::chrono::nanoseconds;
+};
+
+} // namespace clk
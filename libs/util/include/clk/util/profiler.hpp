@@ -1,7 +1,10 @@
 #pragma once
 
+#include <array>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <utility>
 #include <vector>
 
@@ -9,6 +12,8 @@ namespace clk
 {
 using namespace std::chrono_literals;
 
+// Keeps the latest samples in a window of a fixed size. The statistics are updated incrementally with every sample,
+// percentiles are approximated with a histogram of logarithmically growing buckets, accurate to about 3%.
 class profiler
 {
 public:
@@ -25,22 +30,46 @@ public:
     void set_sample_count(std::size_t count);
     void record_sample_start();
     void record_sample_end();
+    void record_sample(std::chrono::nanoseconds sample);
 
     auto latest_sample_time() const -> std::chrono::steady_clock::time_point const&;
     auto average_sample() const -> std::chrono::nanoseconds;
     auto longest_sample() const -> std::chrono::nanoseconds;
     auto shortest_sample() const -> std::chrono::nanoseconds;
+    // the fraction is between 0 and 1, e.g. 0.99 for the 99th percentile
+    auto percentile_sample(double fraction) const -> std::chrono::nanoseconds;
     auto samples() const -> std::pair<std::size_t, std::vector<std::chrono::nanoseconds> const&>;
 
 private:
+    struct windowed_sample
+    {
+        std::uint64_t sequence_number;
+        std::chrono::nanoseconds duration;
+    };
+
+    // values below 16ns get a bucket each, larger ones share 16 buckets per power of two
+    static constexpr std::size_t linear_bucket_count = 16;
+    static constexpr std::size_t histogram_size = linear_bucket_count * 61;
+
     bool _active = true;
     std::chrono::steady_clock::time_point _subsample_start_time = std::chrono::steady_clock::now();
     std::chrono::steady_clock::time_point _latest_sample_time = std::chrono::steady_clock::now();
     std::size_t _current_sample_index = 0;
     std::vector<std::chrono::nanoseconds> _samples;
+    std::uint64_t _recorded_sample_count = 0;
+    std::chrono::nanoseconds _sample_sum = 0ns;
+    std::deque<windowed_sample> _shortest_candidates;
+    std::deque<windowed_sample> _longest_candidates;
+    std::array<std::uint32_t, histogram_size> _histogram = {};
     std::chrono::nanoseconds _average_sample = 0ns;
     std::chrono::nanoseconds _longest_sample = 0ns;
     std::chrono::nanoseconds _shortest_sample = 0ns;
+
+    auto window_size() const -> std::size_t;
+    void reset_statistics();
+    void store_sample(std::chrono::nanoseconds sample);
+    static auto bucket_of(std::chrono::nanoseconds sample) -> std::size_t;
+    static auto bucket_range(std::size_t bucket) -> std::pair<std::chrono::nanoseconds, std::chrono::nanoseconds>;
 };
 
 } // namespace clk
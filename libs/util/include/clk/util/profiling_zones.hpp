@@ -0,0 +1,91 @@
+#pragma once
+
+#include "clk/util/cycle_clock.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#define CLK_PROFILE_SCOPE_CONCATENATE_IMPLEMENTATION(a, b) a##b
+#define CLK_PROFILE_SCOPE_CONCATENATE(a, b) CLK_PROFILE_SCOPE_CONCATENATE_IMPLEMENTATION(a, b)
+// profiles the rest of the enclosing scope, the name has to be a string literal
+#define CLK_PROFILE_SCOPE(name)                                                                                        \
+    clk::profiling_zone const CLK_PROFILE_SCOPE_CONCATENATE(clk_profiling_zone_, __LINE__)(name)
+
+namespace clk
+{
+// the aggregated timings of all the zones with the same name, entered from the same chain of zones
+struct call_tree_node
+{
+    std::string_view name;
+    std::size_t call_count = 0;
+    std::chrono::nanoseconds total_time = std::chrono::nanoseconds(0);
+    std::vector<call_tree_node> children;
+
+    auto self_time() const -> std::chrono::nanoseconds;
+    auto find_child(std::string_view child_name) const -> call_tree_node const*;
+};
+
+// Every thread records the zones it completes into its own ring buffer, without locking or reading a system clock.
+// The buffers are drained into a call tree, merged over all threads, whenever it is queried. Zones completed while
+// the buffer of their thread is full are dropped.
+class profiling_zones final
+{
+public:
+    // the buffer each thread records its zones into, only defined by the implementation
+    struct thread_buffer;
+
+    profiling_zones() = delete;
+    profiling_zones(profiling_zones const&) = delete;
+    profiling_zones(profiling_zones&&) = delete;
+    auto operator=(profiling_zones const&) -> profiling_zones& = delete;
+    auto operator=(profiling_zones&&) -> profiling_zones& = delete;
+    ~profiling_zones() = delete;
+
+    static auto is_active() noexcept -> bool;
+    static void set_active(bool active) noexcept;
+
+    static auto call_tree() -> clk::call_tree_node;
+    static auto dropped_zone_count() -> std::size_t;
+    static void reset();
+
+private:
+    friend class profiling_zone;
+
+    static auto enter() -> thread_buffer*;
+    static void leave(thread_buffer& buffer, char const* name, std::uint64_t start_ticks) noexcept;
+};
+
+class profiling_zone final
+{
+public:
+    template <std::size_t size>
+    explicit profiling_zone(char const (&name)[size]) : _name(name)
+    {
+        if(profiling_zones::is_active())
+        {
+            _buffer = profiling_zones::enter();
+            _start_ticks = clk::cycle_clock::now();
+        }
+    }
+
+    profiling_zone(profiling_zone const&) = delete;
+    profiling_zone(profiling_zone&&) = delete;
+    auto operator=(profiling_zone const&) -> profiling_zone& = delete;
+    auto operator=(profiling_zone&&) -> profiling_zone& = delete;
+
+    ~profiling_zone()
+    {
+        if(_buffer != nullptr)
+            profiling_zones::leave(*_buffer, _name, _start_ticks);
+    }
+
+private:
+    char const* _name = nullptr;
+    profiling_zones::thread_buffer* _buffer = nullptr;
+    std::uint64_t _start_ticks = 0;
+};
+
+} // namespace clk
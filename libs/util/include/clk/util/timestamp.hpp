@@ -1,9 +1,11 @@
 #pragma once
 
-#include <chrono>
+#include <cstdint>
 
 namespace clk
 {
+// A logical version, every update draws the next value of a global counter, so updates are strictly ordered even
+// when they happen in quick succession. A reset timestamp is older than any updated one.
 class timestamp
 {
 public:
@@ -17,15 +19,16 @@ public:
     void update();
     void reset();
     auto is_reset() const -> bool;
+    auto operator==(timestamp const& other) const -> bool;
+    auto operator!=(timestamp const& other) const -> bool;
     auto operator>(timestamp const& other) const -> bool;
     auto operator<(timestamp const& other) const -> bool;
     auto is_newer_than(timestamp const& other) const -> bool;
     auto is_older_than(timestamp const& other) const -> bool;
-    auto time_point() const -> std::chrono::steady_clock::time_point;
+    auto version() const -> std::uint64_t;
 
 private:
-    using chrono = std::chrono::steady_clock;
-    chrono::time_point _timepoint = chrono::time_point::min();
+    std::uint64_t _version = 0;
 };
 
 } // namespace clk
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+namespace clk
+{
+// Records nested begin/end events into a buffer per thread, which can be written out in the Chrome trace event format
+// (readable by chrome://tracing and Perfetto). Recording never locks, except for the first event of every thread, but
+// the events can only be cleared or written out while no thread records new ones. The buffers of exited threads are
+// released once their events are cleared.
+class tracer final
+{
+public:
+    class scope;
+
+    tracer() = delete;
+    tracer(tracer const&) = delete;
+    tracer(tracer&&) = delete;
+    auto operator=(tracer const&) -> tracer& = delete;
+    auto operator=(tracer&&) -> tracer& = delete;
+    ~tracer() = delete;
+
+    static auto is_active() noexcept -> bool;
+    static void set_active(bool active) noexcept;
+
+    static void begin(std::string_view category, std::string_view name);
+    static void end();
+
+    static auto event_count() -> std::size_t;
+    static void clear();
+    static void write_chrome_trace(std::ostream& stream);
+};
+
+// begins an event when constructed and ends it when destroyed, if the tracer was active when it was constructed
+class tracer::scope final
+{
+public:
+    scope(std::string_view category, std::string_view name) : _recording(tracer::is_active())
+    {
+        if(_recording)
+            tracer::begin(category, name);
+    }
+
+    // the name is only queried while the tracer is active
+    template <typename NameFunction, typename = std::enable_if_t<std::is_invocable_r_v<std::string_view, NameFunction>>>
+    scope(std::string_view category, NameFunction&& name_function) : _recording(tracer::is_active())
+    {
+        if(_recording)
+            tracer::begin(category, name_function());
+    }
+
+    scope(scope const&) = delete;
+    scope(scope&&) = delete;
+    auto operator=(scope const&) -> scope& = delete;
+    auto operator=(scope&&) -> scope& = delete;
+
+    ~scope()
+    {
+        if(_recording)
+            tracer::end();
+    }
+
+private:
+    bool _recording = false;
+};
+
+} // namespace clk
@@ -0,0 +1,158 @@
+#include "clk/util/color_buffer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+#include <utility>
+
+namespace clk
+{
+
+color_buffer::color_buffer(std::size_t size)
+{
+    resize(size);
+}
+
+color_buffer::color_buffer(std::size_t size, color_rgb const& color)
+{
+    resize(size);
+    fill(color);
+}
+
+color_buffer::color_buffer(color_buffer const& that)
+{
+    *this = that;
+}
+
+auto color_buffer::operator=(color_buffer const& that) -> color_buffer&
+{
+    if(this == &that)
+        return *this;
+
+    resize(that._size);
+    std::copy(that._data.get(), that._data.get() + 3 * _plane_stride, _data.get());
+    return *this;
+}
+
+auto color_buffer::operator==(color_buffer const& that) const -> bool
+{
+    if(_size != that._size)
+        return false;
+
+    for(std::size_t channel = 0; channel < 3; channel++)
+        if(!std::equal(plane(channel), plane(channel) + _size, that.plane(channel)))
+            return false;
+
+    return true;
+}
+
+auto color_buffer::operator!=(color_buffer const& that) const -> bool
+{
+    return !(*this == that);
+}
+
+auto color_buffer::size() const -> std::size_t
+{
+    return _size;
+}
+
+auto color_buffer::empty() const -> bool
+{
+    return _size == 0;
+}
+
+void color_buffer::resize(std::size_t size)
+{
+    std::size_t const plane_stride = (size + padding - 1) / padding * padding;
+    std::size_t const kept_size = std::min(size, _size);
+    if(plane_stride != _plane_stride)
+    {
+        std::unique_ptr<float[], aligned_deleter> data;
+        if(plane_stride != 0)
+        {
+            data.reset(static_cast<float*>(
+                ::operator new[](3 * plane_stride * sizeof(float), std::align_val_t{alignment})));
+            std::fill(data.get(), data.get() + 3 * plane_stride, 0.0f);
+            for(std::size_t channel = 0; channel < 3; channel++)
+                std::copy(plane(channel), plane(channel) + kept_size, data.get() + channel * plane_stride);
+        }
+        _data = std::move(data);
+        _plane_stride = plane_stride;
+    }
+    else
+    {
+        // the padding past the last color stays zero
+        for(std::size_t channel = 0; channel < 3; channel++)
+            std::fill(plane(channel) + kept_size, plane(channel) + std::max(size, _size), 0.0f);
+    }
+    _size = size;
+}
+
+void color_buffer::fill(color_rgb const& color)
+{
+    for(std::size_t channel = 0; channel < 3; channel++)
+        std::fill(plane(channel), plane(channel) + _size, color[channel]);
+}
+
+auto color_buffer::red() -> float*
+{
+    return plane(0);
+}
+
+auto color_buffer::red() const -> float const*
+{
+    return plane(0);
+}
+
+auto color_buffer::green() -> float*
+{
+    return plane(1);
+}
+
+auto color_buffer::green() const -> float const*
+{
+    return plane(1);
+}
+
+auto color_buffer::blue() -> float*
+{
+    return plane(2);
+}
+
+auto color_buffer::blue() const -> float const*
+{
+    return plane(2);
+}
+
+auto color_buffer::plane(std::size_t channel) -> float*
+{
+    assert(channel < 3);
+    return _data.get() + channel * _plane_stride;
+}
+
+auto color_buffer::plane(std::size_t channel) const -> float const*
+{
+    assert(channel < 3);
+    return _data.get() + channel * _plane_stride;
+}
+
+auto color_buffer::at(std::size_t index) const -> color_rgb
+{
+    assert(index < _size);
+    return color_rgb(red()[index], green()[index], blue()[index]);
+}
+
+void color_buffer::set(std::size_t index, color_rgb const& color)
+{
+    assert(index < _size);
+    red()[index] = color.r();
+    green()[index] = color.g();
+    blue()[index] = color.b();
+}
+
+void color_buffer::aligned_deleter::operator()(float* data) const
+{
+    ::operator delete[](data, std::align_val_t{alignment});
+}
+
+} // namespace clk
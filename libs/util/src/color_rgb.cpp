@@ -193,3 +193,11 @@ auto operator/(color_rgb const& lhs, color_rgb const& rhs) -> color_rgb
 }
 
 } // namespace clk
+
+auto std::hash<clk::color_rgb>::operator()(clk::color_rgb const& color) const noexcept -> std::size_t
+{
+    std::size_t seed = 0;
+    for(std::size_t i = 0; i < 3; i++)
+        seed ^= std::hash<float>{}(color[i]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+}
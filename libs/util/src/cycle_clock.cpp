@@ -0,0 +1,44 @@
+#include "clk/util/cycle_clock.hpp"
+
+#include <cmath>
+
+namespace clk
+{
+namespace
+{
+struct reference_point
+{
+    std::uint64_t ticks = cycle_clock::now();
+    std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+};
+
+// taken during static initialization, so that by the time the rate is needed enough time has usually passed
+reference_point const program_start;
+
+auto measure_nanoseconds_per_tick() -> double
+{
+    using namespace std::chrono_literals;
+
+    reference_point current;
+    while(current.time - program_start.time < 10ms)
+        current = reference_point();
+
+    auto const elapsed_ticks = static_cast<double>(current.ticks - program_start.ticks);
+    auto const elapsed_nanoseconds = std::chrono::duration<double, std::nano>(current.time - program_start.time).count();
+    return elapsed_ticks > 0.0 ? elapsed_nanoseconds / elapsed_ticks : 1.0;
+}
+} // namespace
+
+auto cycle_clock::nanoseconds_per_tick() -> double
+{
+    static double const rate = measure_nanoseconds_per_tick();
+    return rate;
+}
+
+auto cycle_clock::to_nanoseconds(std::uint64_t ticks) -> std::chrono::nanoseconds
+{
+    return std::chrono::nanoseconds(
+        static_cast<std::chrono::nanoseconds::rep>(std::llround(static_cast<double>(ticks) * nanoseconds_per_tick())));
+}
+
+} // namespace clk
@@ -1,8 +1,7 @@
 #include "clk/util/profiler.hpp"
 
 #include <algorithm>
-#include <numeric>
-#include <ratio>
+#include <cmath>
 
 namespace clk
 {
@@ -25,8 +24,20 @@ void profiler::set_active(bool active)
 
 void profiler::set_sample_count(std::size_t count)
 {
-    _current_sample_index %= count;
-    _samples.resize(count, _average_sample);
+    count = std::max<std::size_t>(count, 1);
+
+    // the latest samples that still fit are recorded again, in the order they were originally recorded
+    std::size_t const kept_sample_count = std::min(window_size(), count);
+    std::vector<std::chrono::nanoseconds> kept_samples;
+    kept_samples.reserve(kept_sample_count);
+    for(std::size_t i = kept_sample_count; i > 0; i--)
+        kept_samples.push_back(_samples[(_current_sample_index + _samples.size() - i) % _samples.size()]);
+
+    _samples.assign(count, _average_sample);
+    _current_sample_index = 0;
+    reset_statistics();
+    for(auto sample : kept_samples)
+        store_sample(sample);
 }
 
 auto profiler::latest_sample_time() const -> std::chrono::steady_clock::time_point const&
@@ -46,17 +57,15 @@ void profiler::record_sample_end()
     if(!_active)
         return;
     _latest_sample_time = std::chrono::steady_clock::now();
+    store_sample(_latest_sample_time - _subsample_start_time);
+}
 
-    _samples[_current_sample_index] = _latest_sample_time - _subsample_start_time;
-
-    _current_sample_index = (_current_sample_index + 1) % _samples.size();
-
-    _average_sample = std::accumulate(_samples.begin(), _samples.end(), 0ns) / _samples.size();
-    {
-        auto [min_iterator, max_iterator] = std::minmax_element(_samples.begin(), _samples.end());
-        _shortest_sample = *min_iterator;
-        _longest_sample = *max_iterator;
-    }
+void profiler::record_sample(std::chrono::nanoseconds sample)
+{
+    if(!_active)
+        return;
+    _latest_sample_time = std::chrono::steady_clock::now();
+    store_sample(sample);
 }
 
 auto profiler::average_sample() const -> std::chrono::nanoseconds
@@ -74,9 +83,110 @@ auto profiler::shortest_sample() const -> std::chrono::nanoseconds
     return _shortest_sample;
 }
 
+auto profiler::percentile_sample(double fraction) const -> std::chrono::nanoseconds
+{
+    std::size_t const sample_count = window_size();
+    if(sample_count == 0)
+        return 0ns;
+
+    auto const rank = std::clamp<std::size_t>(
+        static_cast<std::size_t>(std::ceil(std::clamp(fraction, 0.0, 1.0) * static_cast<double>(sample_count))), 1,
+        sample_count);
+
+    std::size_t cumulative_count = 0;
+    for(std::size_t bucket = 0; bucket < histogram_size; bucket++)
+    {
+        cumulative_count += _histogram[bucket];
+        if(cumulative_count >= rank)
+        {
+            auto [lower_bound, upper_bound] = bucket_range(bucket);
+            return std::clamp(lower_bound + (upper_bound - lower_bound) / 2, _shortest_sample, _longest_sample);
+        }
+    }
+    return _longest_sample;
+}
+
 auto profiler::samples() const -> std::pair<std::size_t, std::vector<std::chrono::nanoseconds> const&>
 {
     return {_current_sample_index, _samples};
 }
 
+auto profiler::window_size() const -> std::size_t
+{
+    return static_cast<std::size_t>(std::min<std::uint64_t>(_recorded_sample_count, _samples.size()));
+}
+
+void profiler::reset_statistics()
+{
+    _recorded_sample_count = 0;
+    _sample_sum = 0ns;
+    _shortest_candidates.clear();
+    _longest_candidates.clear();
+    _histogram.fill(0);
+    _average_sample = 0ns;
+    _longest_sample = 0ns;
+    _shortest_sample = 0ns;
+}
+
+void profiler::store_sample(std::chrono::nanoseconds sample)
+{
+    sample = std::max(sample, 0ns);
+
+    if(_recorded_sample_count >= _samples.size())
+    {
+        auto const evicted_sample = _samples[_current_sample_index];
+        _sample_sum -= evicted_sample;
+        _histogram[bucket_of(evicted_sample)]--;
+    }
+
+    _samples[_current_sample_index] = sample;
+    _current_sample_index = (_current_sample_index + 1) % _samples.size();
+    _sample_sum += sample;
+    _histogram[bucket_of(sample)]++;
+
+    // the candidates are kept sorted, a sample can only become the shortest (or longest) one once all the samples
+    // before it that are shorter (or longer) have left the window, so the others are dropped right away
+    std::uint64_t const sequence_number = _recorded_sample_count++;
+    while(!_shortest_candidates.empty() && _shortest_candidates.back().duration >= sample)
+        _shortest_candidates.pop_back();
+    _shortest_candidates.push_back({sequence_number, sample});
+    while(!_longest_candidates.empty() && _longest_candidates.back().duration <= sample)
+        _longest_candidates.pop_back();
+    _longest_candidates.push_back({sequence_number, sample});
+
+    std::uint64_t const oldest_sequence_number = _recorded_sample_count - window_size();
+    if(_shortest_candidates.front().sequence_number < oldest_sequence_number)
+        _shortest_candidates.pop_front();
+    if(_longest_candidates.front().sequence_number < oldest_sequence_number)
+        _longest_candidates.pop_front();
+
+    _average_sample = _sample_sum / window_size();
+    _shortest_sample = _shortest_candidates.front().duration;
+    _longest_sample = _longest_candidates.front().duration;
+}
+
+auto profiler::bucket_of(std::chrono::nanoseconds sample) -> std::size_t
+{
+    auto const value = static_cast<std::uint64_t>(sample.count());
+    if(value < linear_bucket_count)
+        return static_cast<std::size_t>(value);
+
+    std::size_t exponent = 4;
+    while((value >> (exponent + 1)) != 0)
+        exponent++;
+    return (exponent - 3) * linear_bucket_count + static_cast<std::size_t>((value >> (exponent - 4)) & 15);
+}
+
+auto profiler::bucket_range(std::size_t bucket) -> std::pair<std::chrono::nanoseconds, std::chrono::nanoseconds>
+{
+    if(bucket < linear_bucket_count)
+        return {std::chrono::nanoseconds(bucket), std::chrono::nanoseconds(bucket + 1)};
+
+    std::size_t const exponent = bucket / linear_bucket_count + 3;
+    std::size_t const sub_bucket = bucket % linear_bucket_count;
+    auto const width = std::uint64_t(1) << (exponent - 4);
+    auto const lower_bound = (linear_bucket_count + sub_bucket) * width;
+    return {std::chrono::nanoseconds(lower_bound), std::chrono::nanoseconds(lower_bound + width)};
+}
+
 } // namespace clk
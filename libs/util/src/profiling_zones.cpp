@@ -0,0 +1,197 @@
+#include "clk/util/profiling_zones.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace clk
+{
+namespace
+{
+struct zone_record
+{
+    char const* name;
+    std::uint64_t start_ticks;
+    std::uint64_t end_ticks;
+    std::uint32_t depth;
+};
+} // namespace
+
+// a single producer single consumer ring, the producer being the thread it belongs to
+struct profiling_zones::thread_buffer
+{
+    static constexpr std::size_t capacity = 1 << 14;
+
+    std::array<zone_record, capacity> records;
+    std::atomic<std::uint64_t> head = 0;
+    std::atomic<std::uint64_t> tail = 0;
+    std::atomic<std::size_t> dropped_zone_count = 0;
+
+    // only used by the producer
+    std::uint32_t depth = 0;
+
+    // only used by the consumer, the subtrees of completed zones waiting for their parent zone to complete
+    std::vector<std::vector<clk::call_tree_node>> pending_subtrees;
+};
+
+namespace
+{
+using thread_buffer = profiling_zones::thread_buffer;
+
+struct registry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<thread_buffer>> buffers;
+    clk::call_tree_node root;
+};
+
+auto get_registry() -> registry&
+{
+    static registry instance;
+    return instance;
+}
+
+std::atomic<bool> zones_active = false;
+thread_local thread_buffer* current_thread_buffer = nullptr;
+
+auto get_thread_buffer() -> thread_buffer&
+{
+    if(current_thread_buffer == nullptr)
+    {
+        auto& registry = get_registry();
+        std::scoped_lock lock(registry.mutex);
+        current_thread_buffer = registry.buffers.emplace_back(std::make_unique<thread_buffer>()).get();
+    }
+    return *current_thread_buffer;
+}
+
+void merge_into(std::vector<clk::call_tree_node>& nodes, clk::call_tree_node&& node)
+{
+    auto it = std::find_if(nodes.begin(), nodes.end(), [&](auto const& existing_node) {
+        return existing_node.name == node.name;
+    });
+    if(it == nodes.end())
+    {
+        nodes.push_back(std::move(node));
+        return;
+    }
+
+    it->call_count += node.call_count;
+    it->total_time += node.total_time;
+    for(auto& child : node.children)
+        merge_into(it->children, std::move(child));
+}
+
+// completed zones arrive children first, so every zone adopts the pending subtrees one level deeper than itself
+void drain(thread_buffer& buffer, clk::call_tree_node& root)
+{
+    std::uint64_t const tail = buffer.tail.load(std::memory_order_relaxed);
+    std::uint64_t const head = buffer.head.load(std::memory_order_acquire);
+    for(std::uint64_t i = tail; i != head; i++)
+    {
+        auto const& record = buffer.records[i % thread_buffer::capacity];
+        if(buffer.pending_subtrees.size() < record.depth + 2)
+            buffer.pending_subtrees.resize(record.depth + 2);
+
+        clk::call_tree_node node;
+        node.name = record.name;
+        node.call_count = 1;
+        node.total_time = clk::cycle_clock::to_nanoseconds(record.end_ticks - record.start_ticks);
+        for(auto& child : buffer.pending_subtrees[record.depth + 1])
+            merge_into(node.children, std::move(child));
+        buffer.pending_subtrees[record.depth + 1].clear();
+
+        if(record.depth == 0)
+            merge_into(root.children, std::move(node));
+        else
+            merge_into(buffer.pending_subtrees[record.depth], std::move(node));
+    }
+    buffer.tail.store(head, std::memory_order_release);
+}
+
+} // namespace
+
+auto call_tree_node::self_time() const -> std::chrono::nanoseconds
+{
+    auto time = total_time;
+    for(auto const& child : children)
+        time -= child.total_time;
+    return std::max(time, std::chrono::nanoseconds(0));
+}
+
+auto call_tree_node::find_child(std::string_view child_name) const -> call_tree_node const*
+{
+    for(auto const& child : children)
+        if(child.name == child_name)
+            return &child;
+    return nullptr;
+}
+
+auto profiling_zones::is_active() noexcept -> bool
+{
+    return zones_active.load(std::memory_order_relaxed);
+}
+
+void profiling_zones::set_active(bool active) noexcept
+{
+    zones_active.store(active, std::memory_order_relaxed);
+}
+
+auto profiling_zones::call_tree() -> clk::call_tree_node
+{
+    auto& registry = get_registry();
+    std::scoped_lock lock(registry.mutex);
+    for(auto& buffer : registry.buffers)
+        drain(*buffer, registry.root);
+    return registry.root;
+}
+
+auto profiling_zones::dropped_zone_count() -> std::size_t
+{
+    auto& registry = get_registry();
+    std::scoped_lock lock(registry.mutex);
+    std::size_t count = 0;
+    for(auto const& buffer : registry.buffers)
+        count += buffer->dropped_zone_count.load(std::memory_order_relaxed);
+    return count;
+}
+
+void profiling_zones::reset()
+{
+    auto& registry = get_registry();
+    std::scoped_lock lock(registry.mutex);
+    for(auto& buffer : registry.buffers)
+    {
+        buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_release);
+        buffer->pending_subtrees.clear();
+        buffer->dropped_zone_count.store(0, std::memory_order_relaxed);
+    }
+    registry.root = {};
+}
+
+auto profiling_zones::enter() -> thread_buffer*
+{
+    auto& buffer = get_thread_buffer();
+    buffer.depth++;
+    return &buffer;
+}
+
+void profiling_zones::leave(thread_buffer& buffer, char const* name, std::uint64_t start_ticks) noexcept
+{
+    std::uint64_t const end_ticks = clk::cycle_clock::now();
+    std::uint32_t const depth = --buffer.depth;
+
+    std::uint64_t const head = buffer.head.load(std::memory_order_relaxed);
+    if(head - buffer.tail.load(std::memory_order_acquire) == thread_buffer::capacity)
+    {
+        buffer.dropped_zone_count.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer.records[head % thread_buffer::capacity] = {name, start_ticks, end_ticks, depth};
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+} // namespace clk
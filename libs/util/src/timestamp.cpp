@@ -1,31 +1,44 @@
 #include "clk/util/timestamp.hpp"
 
+#include <atomic>
+
 namespace clk
 {
 
 void timestamp::update()
 {
-    _timepoint = chrono::now();
+    static std::atomic<std::uint64_t> last_version = 0;
+    _version = last_version.fetch_add(1, std::memory_order_relaxed) + 1;
 }
 
 void timestamp::reset()
 {
-    _timepoint = chrono::time_point::min();
+    _version = 0;
 }
 
 auto timestamp::is_reset() const -> bool
 {
-    return _timepoint == chrono::time_point::min();
+    return _version == 0;
+}
+
+auto timestamp::operator==(timestamp const& other) const -> bool
+{
+    return this->_version == other._version;
+}
+
+auto timestamp::operator!=(timestamp const& other) const -> bool
+{
+    return this->_version != other._version;
 }
 
 auto timestamp::operator>(timestamp const& other) const -> bool
 {
-    return this->_timepoint > other._timepoint;
+    return this->_version > other._version;
 }
 
 auto timestamp::operator<(timestamp const& other) const -> bool
 {
-    return this->_timepoint < other._timepoint;
+    return this->_version < other._version;
 }
 
 auto timestamp::is_newer_than(timestamp const& other) const -> bool
@@ -38,9 +51,9 @@ auto timestamp::is_older_than(timestamp const& other) const -> bool
     return *this < other;
 }
 
-auto timestamp::time_point() const -> std::chrono::steady_clock::time_point
+auto timestamp::version() const -> std::uint64_t
 {
-    return _timepoint;
+    return _version;
 }
 
 } // namespace clk
@@ -0,0 +1,219 @@
+#include "clk/util/tracer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace clk
+{
+namespace
+{
+struct event
+{
+    std::chrono::steady_clock::duration time;
+    std::uint32_t category;
+    std::uint32_t name;
+    std::uint32_t depth;
+    char phase;
+};
+
+// only ever written by the thread it belongs to
+struct thread_buffer
+{
+    std::size_t thread_index = 0;
+    // set by the registry once the thread exited, its events are kept until they are cleared
+    bool exited = false;
+    std::vector<event> events;
+    // the names never move, so the keys of the indices can view them
+    std::deque<std::string> names;
+    std::unordered_map<std::string_view, std::uint32_t> name_indices;
+    std::vector<event> open_events;
+
+    auto intern(std::string_view name) -> std::uint32_t
+    {
+        if(auto it = name_indices.find(name); it != name_indices.end())
+            return it->second;
+        auto const index = static_cast<std::uint32_t>(names.size());
+        name_indices.emplace(names.emplace_back(name), index);
+        return index;
+    }
+};
+
+struct registry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<thread_buffer>> buffers;
+    std::size_t next_thread_index = 1;
+    std::chrono::steady_clock::time_point const epoch = std::chrono::steady_clock::now();
+};
+
+auto get_registry() -> registry&
+{
+    static registry instance;
+    return instance;
+}
+
+void release_thread_buffer(thread_buffer* buffer);
+
+// releases the buffer of the thread when it exits, threads of executors come and go with them
+class thread_buffer_owner final
+{
+public:
+    thread_buffer_owner() = default;
+    thread_buffer_owner(thread_buffer_owner const&) = delete;
+    thread_buffer_owner(thread_buffer_owner&&) = delete;
+    auto operator=(thread_buffer_owner const&) -> thread_buffer_owner& = delete;
+    auto operator=(thread_buffer_owner&&) -> thread_buffer_owner& = delete;
+
+    ~thread_buffer_owner()
+    {
+        if(buffer != nullptr)
+            release_thread_buffer(buffer);
+    }
+
+    thread_buffer* buffer = nullptr;
+};
+
+std::atomic<bool> tracing_active = false;
+thread_local thread_buffer_owner current_thread_buffer;
+
+auto get_thread_buffer() -> thread_buffer&
+{
+    if(current_thread_buffer.buffer == nullptr)
+    {
+        auto& registry = get_registry();
+        std::scoped_lock lock(registry.mutex);
+        auto& buffer = registry.buffers.emplace_back(std::make_unique<thread_buffer>());
+        buffer->thread_index = registry.next_thread_index++;
+        current_thread_buffer.buffer = buffer.get();
+    }
+    return *current_thread_buffer.buffer;
+}
+
+// the events of the thread are written out until they are cleared, a buffer without events is dropped right away
+void release_thread_buffer(thread_buffer* buffer)
+{
+    auto& registry = get_registry();
+    std::scoped_lock lock(registry.mutex);
+    buffer->exited = true;
+    if(buffer->events.empty())
+        registry.buffers.erase(std::find_if(registry.buffers.begin(), registry.buffers.end(), [&](auto const& owned) {
+            return owned.get() == buffer;
+        }));
+}
+
+void write_json_string(std::ostream& stream, std::string_view text)
+{
+    stream << '"';
+    for(char const c : text)
+    {
+        if(c == '"' || c == '\\')
+            stream << '\\' << c;
+        else if(static_cast<unsigned char>(c) < 0x20)
+            stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        else
+            stream << c;
+    }
+    stream << '"';
+}
+
+} // namespace
+
+auto tracer::is_active() noexcept -> bool
+{
+    return tracing_active.load(std::memory_order_relaxed);
+}
+
+void tracer::set_active(bool active) noexcept
+{
+    tracing_active.store(active, std::memory_order_relaxed);
+}
+
+void tracer::begin(std::string_view category, std::string_view name)
+{
+    auto& buffer = get_thread_buffer();
+    event const begin_event = {std::chrono::steady_clock::now() - get_registry().epoch, buffer.intern(category),
+        buffer.intern(name), static_cast<std::uint32_t>(buffer.open_events.size()), 'B'};
+    buffer.events.push_back(begin_event);
+    buffer.open_events.push_back(begin_event);
+}
+
+void tracer::end()
+{
+    auto& buffer = get_thread_buffer();
+    if(buffer.open_events.empty())
+        return;
+
+    event end_event = buffer.open_events.back();
+    buffer.open_events.pop_back();
+    end_event.time = std::chrono::steady_clock::now() - get_registry().epoch;
+    end_event.phase = 'E';
+    buffer.events.push_back(end_event);
+}
+
+auto tracer::event_count() -> std::size_t
+{
+    auto& registry = get_registry();
+    std::scoped_lock lock(registry.mutex);
+    std::size_t count = 0;
+    for(auto const& buffer : registry.buffers)
+        count += buffer->events.size();
+    return count;
+}
+
+void tracer::clear()
+{
+    auto& registry = get_registry();
+    std::scoped_lock lock(registry.mutex);
+    for(auto& buffer : registry.buffers)
+        buffer->events.clear();
+    registry.buffers.erase(std::remove_if(registry.buffers.begin(), registry.buffers.end(),
+                               [](auto const& buffer) {
+                                   return buffer->exited;
+                               }),
+        registry.buffers.end());
+}
+
+void tracer::write_chrome_trace(std::ostream& stream)
+{
+    auto& registry = get_registry();
+    std::scoped_lock lock(registry.mutex);
+
+    auto const flags = stream.flags();
+    auto const precision = stream.precision();
+    auto const fill = stream.fill();
+    stream << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    for(auto const& buffer : registry.buffers)
+    {
+        stream << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+               << buffer->thread_index << ",\"args\":{\"name\":\"Thread " << buffer->thread_index << "\"}}";
+        first = false;
+
+        for(auto const& event : buffer->events)
+        {
+            stream << ",\n{\"name\":";
+            write_json_string(stream, buffer->names[event.name]);
+            stream << ",\"cat\":";
+            write_json_string(stream, buffer->names[event.category]);
+            stream << ",\"ph\":\"" << event.phase << "\",\"ts\":"
+                   << std::chrono::duration<double, std::micro>(event.time).count()
+                   << ",\"pid\":1,\"tid\":" << buffer->thread_index << ",\"args\":{\"depth\":" << event.depth << "}}";
+        }
+    }
+    stream << "\n]}\n";
+    stream.flags(flags);
+    stream.precision(precision);
+    stream.fill(fill);
+}
+
+} // namespace clk
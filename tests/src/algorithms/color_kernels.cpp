@@ -0,0 +1,218 @@
+#include "clk/algorithms/color.hpp"
+#include "clk/algorithms/color_buffer.hpp"
+#include "clk/base/algorithm_node.hpp"
+#include "clk/base/input.hpp"
+#include "clk/base/output.hpp"
+#include "clk/util/color_buffer.hpp"
+#include "clk/util/color_rgb.hpp"
+#include "color_kernels.hpp"
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// the SIMD kernels approximate pow with a relative error in the order of 1e-5
+auto is_close(float value, float expected) -> bool
+{
+    return std::abs(value - expected) <= 1e-4f * std::max(1.0f, std::abs(expected));
+}
+
+auto is_close(clk::color_rgb const& value, clk::color_rgb const& expected) -> bool
+{
+    return is_close(value.r(), expected.r()) && is_close(value.g(), expected.g()) && is_close(value.b(), expected.b());
+}
+
+// sizes that leave a partial vector at the end of the planes, for every vector width
+std::vector<std::size_t> const buffer_sizes = {1, 3, 5, 7, 17, 33, 100};
+
+auto gradient_buffer(std::size_t size, float maximum) -> clk::color_buffer
+{
+    clk::color_buffer buffer(size);
+    for(std::size_t i = 0; i < size; i++)
+    {
+        float const t = static_cast<float>(i) / static_cast<float>(size);
+        buffer.set(i, clk::color_rgb(t * maximum, (1.0f - t) * maximum, 0.5f * maximum));
+    }
+    return buffer;
+}
+
+auto available_kernels() -> std::vector<std::pair<std::string, clk::algorithms::color_kernels const*>>
+{
+    std::vector<std::pair<std::string, clk::algorithms::color_kernels const*>> kernels = {
+        {"scalar", &clk::algorithms::scalar_color_kernels()}};
+    if(auto const* sse41 = clk::algorithms::sse41_color_kernels(); sse41 != nullptr)
+        kernels.emplace_back("SSE4.1", sse41);
+    if(auto const* avx2 = clk::algorithms::avx2_color_kernels(); avx2 != nullptr)
+        kernels.emplace_back("AVX2", avx2);
+    // the kernels of instruction sets the running CPU does not support can not be called
+    auto const best = std::find_if(kernels.begin(), kernels.end(), [](auto const& entry) {
+        return entry.second == &clk::algorithms::best_color_kernels();
+    });
+    kernels.erase(best + 1, kernels.end());
+    return kernels;
+}
+
+// runs a single color algorithm, whose inputs are set to the given values in order, pushing clears the errors of the
+// updates with the default values
+template <typename Algorithm, typename... Values>
+auto run_algorithm(Values const&... values)
+{
+    clk::algorithm_node node(std::make_unique<Algorithm>());
+    std::size_t input_index = 0;
+    (
+        [&]() {
+            auto* input = static_cast<clk::input_of<Values>*>(node.inputs()[input_index++]);
+            *input->default_port() = values;
+        }(),
+        ...);
+    node.push();
+    auto const* result = static_cast<clk::output_of<clk::color_rgb>*>(node.outputs().front());
+    return result->data();
+}
+
+template <typename Algorithm, typename... Values>
+auto run_buffer_algorithm(Values const&... values) -> clk::color_buffer
+{
+    clk::algorithm_node node(std::make_unique<Algorithm>());
+    std::size_t input_index = 0;
+    (
+        [&]() {
+            auto* input = static_cast<clk::input_of<Values>*>(node.inputs()[input_index++]);
+            *input->default_port() = values;
+        }(),
+        ...);
+    node.push();
+    REQUIRE(node.error().empty());
+    return static_cast<clk::output_of<clk::color_buffer>*>(node.outputs().front())->data();
+}
+
+template <typename Algorithm>
+auto matches_algorithm(clk::color_buffer const& input, clk::color_buffer const& output) -> bool
+{
+    if(output.size() != input.size())
+        return false;
+    for(std::size_t i = 0; i < input.size(); i++)
+        if(!is_close(output.at(i), run_algorithm<Algorithm>(input.at(i))))
+            return false;
+    return true;
+}
+} // namespace
+
+TEST_CASE("Every color kernel set matches the single color algorithms", "[algorithms], [color]")
+{
+    for(auto const& [kernel_set, kernels] : available_kernels())
+    {
+        for(std::size_t size : buffer_sizes)
+        {
+            GIVEN("the " + kernel_set + " kernels and buffers of " + std::to_string(size) + " colors")
+            {
+                auto const colors = gradient_buffer(size, 4.0f);
+                auto const other_colors = gradient_buffer(size, 1.0f);
+                clk::color_buffer output(size);
+
+                THEN("grayscale matches the single color algorithm")
+                {
+                    kernels->grayscale(colors, output);
+                    REQUIRE(matches_algorithm<clk::algorithms::grayscale>(colors, output));
+                }
+
+                THEN("mix matches the single color algorithm")
+                {
+                    kernels->mix(30.0f, colors, other_colors, output);
+                    for(std::size_t i = 0; i < size; i++)
+                        REQUIRE(is_close(output.at(i),
+                            run_algorithm<clk::algorithms::mix_colors>(30.0f, colors.at(i), other_colors.at(i))));
+                }
+
+                THEN("applying and removing gamma match the single color algorithms")
+                {
+                    kernels->apply_gamma(other_colors, output);
+                    REQUIRE(matches_algorithm<clk::algorithms::apply_gamma>(other_colors, output));
+                    kernels->remove_gamma(other_colors, output);
+                    REQUIRE(matches_algorithm<clk::algorithms::remove_gamma>(other_colors, output));
+                }
+
+                THEN("the tonemappers match the single color algorithms")
+                {
+                    kernels->tonemap_reinhard(colors, output);
+                    REQUIRE(matches_algorithm<clk::algorithms::tonemap_reinhard>(colors, output));
+                    kernels->tonemap_filmic_aces(colors, output);
+                    REQUIRE(matches_algorithm<clk::algorithms::tonemap_filmic_aces>(colors, output));
+                }
+
+                THEN("the kernels can write to their input buffer")
+                {
+                    auto in_place = colors;
+                    kernels->tonemap_reinhard(in_place, in_place);
+                    REQUIRE(matches_algorithm<clk::algorithms::tonemap_reinhard>(colors, in_place));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Color buffer algorithms match the single color algorithms", "[algorithms], [color]")
+{
+    GIVEN("a buffer of 37 colors")
+    {
+        auto const colors = gradient_buffer(37, 2.0f);
+
+        THEN("every buffer algorithm transforms each color like the single color algorithm")
+        {
+            REQUIRE(matches_algorithm<clk::algorithms::grayscale>(
+                colors, run_buffer_algorithm<clk::algorithms::grayscale_buffer>(colors)));
+            REQUIRE(matches_algorithm<clk::algorithms::apply_gamma>(
+                colors, run_buffer_algorithm<clk::algorithms::apply_gamma_buffer>(colors)));
+            REQUIRE(matches_algorithm<clk::algorithms::remove_gamma>(
+                colors, run_buffer_algorithm<clk::algorithms::remove_gamma_buffer>(colors)));
+            REQUIRE(matches_algorithm<clk::algorithms::tonemap_reinhard>(
+                colors, run_buffer_algorithm<clk::algorithms::tonemap_reinhard_buffer>(colors)));
+            REQUIRE(matches_algorithm<clk::algorithms::tonemap_filmic_aces>(
+                colors, run_buffer_algorithm<clk::algorithms::tonemap_filmic_aces_buffer>(colors)));
+        }
+
+        THEN("mixing buffers mixes each pair of colors")
+        {
+            auto const other_colors = gradient_buffer(37, 1.0f);
+            auto const mixed = run_buffer_algorithm<clk::algorithms::mix_color_buffers>(75.0f, colors, other_colors);
+            REQUIRE(mixed.size() == 37);
+            for(std::size_t i = 0; i < mixed.size(); i++)
+                REQUIRE(is_close(
+                    mixed.at(i), run_algorithm<clk::algorithms::mix_colors>(75.0f, colors.at(i), other_colors.at(i))));
+        }
+
+        THEN("filling and sampling buffers round trips a color")
+        {
+            auto const filled = run_buffer_algorithm<clk::algorithms::fill_color_buffer>(
+                37, clk::color_rgb(0.25f, 0.5f, 0.75f));
+            REQUIRE(filled == clk::color_buffer(37, clk::color_rgb(0.25f, 0.5f, 0.75f)));
+            REQUIRE(run_algorithm<clk::algorithms::sample_color_buffer>(filled, 36) ==
+                    clk::color_rgb(0.25f, 0.5f, 0.75f));
+        }
+    }
+}
+
+TEST_CASE("Filmic ACES tonemapping divides by the whole denominator", "[algorithms], [color]")
+{
+    GIVEN("the filmic ACES tonemapper")
+    {
+        THEN("white maps to (x(2.51x + 0.03)) / (x(2.43x + 0.59) + 0.14)")
+        {
+            auto const white = run_algorithm<clk::algorithms::tonemap_filmic_aces>(clk::color_rgb(1.0f));
+            REQUIRE(is_close(white, clk::color_rgb(2.54f / 3.16f)));
+        }
+
+        THEN("black stays black")
+        {
+            auto const black = run_algorithm<clk::algorithms::tonemap_filmic_aces>(clk::color_rgb(0.0f));
+            REQUIRE(black == clk::color_rgb(0.0f));
+        }
+    }
+}
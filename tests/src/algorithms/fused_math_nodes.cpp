@@ -0,0 +1,148 @@
+#include "clk/algorithms/fusion.hpp"
+#include "clk/algorithms/math.hpp"
+#include "clk/base/algorithm_node.hpp"
+#include "clk/base/graph.hpp"
+#include "clk/base/input.hpp"
+#include "clk/base/output.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace
+{
+template <typename Algorithm>
+auto add_algorithm_node(clk::graph& graph) -> clk::node*
+{
+    graph.add_node(std::make_unique<clk::algorithm_node>(std::make_unique<Algorithm>()));
+    return graph.nodes().back().get();
+}
+
+// the angles are converted with an approximation of pi
+auto is_close(float value, float expected) -> bool
+{
+    return std::abs(value - expected) <= 1e-4f;
+}
+
+auto result_of(clk::node const* node) -> clk::output_of<float>&
+{
+    return *static_cast<clk::output_of<float>*>(node->outputs().front());
+}
+} // namespace
+
+TEST_CASE("Trees of elementwise math nodes are fused into a single node", "[algorithms], [fusion]")
+{
+    GIVEN("a graph computing sin(deg_to_rad(x)) * y + 1, read by an input outside of the graph")
+    {
+        clk::graph graph;
+        clk::output_of<float> x("X");
+        clk::output_of<float> y("Y");
+        clk::input_of<float> reader("Reader");
+        *x = 90.0f;
+        *y = 3.0f;
+
+        auto* to_radians = add_algorithm_node<clk::algorithms::deg_to_rad>(graph);
+        auto* sine = add_algorithm_node<clk::algorithms::sin>(graph);
+        auto* product = add_algorithm_node<clk::algorithms::multiply_floats>(graph);
+        auto* sum = add_algorithm_node<clk::algorithms::add_floats>(graph);
+        to_radians->inputs()[0]->connect_to(x, false);
+        sine->inputs()[0]->connect_to(result_of(to_radians), false);
+        product->inputs()[0]->connect_to(result_of(sine), false);
+        product->inputs()[1]->connect_to(y, false);
+        sum->inputs()[0]->connect_to(result_of(product), false);
+        *static_cast<clk::input_of<float>*>(sum->inputs()[1])->default_port() = 1.0f;
+        reader.connect_to(result_of(sum), false);
+
+        WHEN("the graph is fused")
+        {
+            REQUIRE(clk::algorithms::fuse_elementwise_math(graph) == 1);
+            REQUIRE(graph.nodes().size() == 1);
+            auto* fused = dynamic_cast<clk::algorithms::fused_math_node*>(graph.nodes().front().get());
+            REQUIRE(fused != nullptr);
+
+            THEN("the fused node keeps the connections into and out of the tree")
+            {
+                REQUIRE(fused->operations().size() == 4);
+                REQUIRE(fused->inputs().size() == 3);
+                REQUIRE(fused->input(0).is_connected_to(x));
+                REQUIRE(fused->input(1).is_connected_to(y));
+                REQUIRE_FALSE(fused->input(2).is_connected());
+                REQUIRE(*fused->input(2) == 1.0f);
+                REQUIRE(reader.is_connected_to(fused->result()));
+            }
+
+            THEN("pulling the reader evaluates the whole tree")
+            {
+                reader.pull();
+                REQUIRE(is_close(*reader, 4.0f));
+
+                *x = 0.0f;
+                x.push();
+                reader.pull();
+                REQUIRE(is_close(*reader, 1.0f));
+            }
+
+            THEN("batches evaluate the tree for every element of the columns")
+            {
+                constexpr std::size_t count = 64;
+                x.resize_column(count);
+                for(std::size_t i = 0; i < count; i++)
+                    x.column()[i] = static_cast<float>(i) * 90.0f;
+
+                graph.compile().run_batch(count);
+                REQUIRE(fused->result().column_size() == count);
+                REQUIRE(is_close(fused->result().column()[0], 1.0f));
+                REQUIRE(is_close(fused->result().column()[1], 4.0f));
+                REQUIRE(is_close(fused->result().column()[3], -2.0f));
+            }
+        }
+
+        WHEN("the product is observed and the graph is fused")
+        {
+            graph.observe(result_of(product));
+            REQUIRE(clk::algorithms::fuse_elementwise_math(graph) == 1);
+            THEN("only the nodes before the product are fused")
+            {
+                REQUIRE(graph.nodes().size() == 3);
+                REQUIRE(product->inputs()[0]->connected_output() != nullptr);
+                REQUIRE(reader.is_connected_to(result_of(sum)));
+            }
+        }
+
+        WHEN("the result of the sine is read twice")
+        {
+            sum->inputs()[1]->connect_to(result_of(sine), false);
+            REQUIRE(clk::algorithms::fuse_elementwise_math(graph) == 2);
+            THEN("it is the root of a tree of its own")
+            {
+                REQUIRE(graph.nodes().size() == 2);
+                reader.pull();
+                REQUIRE(is_close(*reader, 4.0f));
+            }
+        }
+    }
+
+    GIVEN("a fused division by zero")
+    {
+        clk::algorithms::fused_math_node node(
+            2, {{clk::algorithms::math_operation::divide, {0, 1}}, {clk::algorithms::math_operation::sin, {2, 0}}});
+        *node.input(0).default_port() = 1.0f;
+        *node.input(1).default_port() = 0.0f;
+
+        WHEN("it is pulled")
+        {
+            node.pull();
+            THEN("the node reports the error of the division")
+            {
+                REQUIRE(node.error() == "Division by zero!");
+            }
+        }
+    }
+
+    THEN("fused nodes only accept operations that read earlier values")
+    {
+        REQUIRE_THROWS(clk::algorithms::fused_math_node(1, {{clk::algorithms::math_operation::add, {0, 1}}}));
+    }
+}
@@ -0,0 +1,217 @@
+#include "clk/base/evaluation_service.hpp"
+#include "clk/base/graph.hpp"
+#include "clk/base/input.hpp"
+#include "clk/base/node.hpp"
+#include "clk/base/output.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+
+namespace
+{
+class increment_node final : public clk::node
+{
+public:
+    clk::input_of<int> in{"In"};
+    clk::output_of<int> out{"Out"};
+
+    increment_node()
+    {
+        register_port(&in);
+        register_port(&out);
+    }
+
+    auto name() const -> std::string_view final
+    {
+        return "Increment";
+    }
+
+private:
+    void update() final
+    {
+        if(*in < 0)
+            throw std::runtime_error("Negative input");
+        *out = *in + 1;
+    }
+};
+
+// blocks its update until it is released, so the test can look at the service while the worker is busy
+class blocking_node final : public clk::node
+{
+public:
+    clk::input_of<int> in{"In"};
+    clk::output_of<int> out{"Out"};
+    std::promise<void> started;
+    std::promise<void> released;
+
+    blocking_node()
+    {
+        register_port(&in);
+        register_port(&out);
+    }
+
+    auto name() const -> std::string_view final
+    {
+        return "Blocking";
+    }
+
+private:
+    void update() final
+    {
+        started.set_value();
+        released.get_future().wait();
+        *out = *in;
+    }
+};
+
+template <typename Node>
+auto add_node(clk::graph& graph) -> Node*
+{
+    auto node = std::make_unique<Node>();
+    auto* node_pointer = node.get();
+    graph.add_node(std::move(node));
+    return node_pointer;
+}
+
+auto published_value(clk::evaluation_service const& service, clk::port const& port) -> int
+{
+    auto const snapshot = service.published_snapshot();
+    auto const* data = static_cast<int const*>(snapshot->data_pointer(port));
+    REQUIRE(data != nullptr);
+    return *data;
+}
+} // namespace
+
+TEST_CASE("Evaluation services evaluate graphs on a worker thread", "[base], [evaluation_services]")
+{
+    GIVEN("a graph with a chain of nodes A -> B")
+    {
+        clk::graph graph;
+        auto* A = add_node<increment_node>(graph);
+        auto* B = add_node<increment_node>(graph);
+        B->in.connect_to(A->out, false);
+        A->in.default_port().data() = 1;
+
+        clk::evaluation_service service(graph);
+
+        WHEN("B is pulled through the service")
+        {
+            service.queue_pull(*B);
+            service.wait();
+
+            THEN("the values are computed and published")
+            {
+                auto const lock = service.lock();
+                REQUIRE(*B->out == 3);
+                REQUIRE(published_value(service, A->out) == 2);
+                REQUIRE(published_value(service, B->out) == 3);
+            }
+
+            THEN("inputs read the published data of the output they are connected to")
+            {
+                REQUIRE(published_value(service, B->in) == 2);
+                REQUIRE(published_value(service, A->in) == 1);
+                REQUIRE_FALSE(service.is_busy());
+            }
+        }
+
+        WHEN("an update fails")
+        {
+            {
+                auto const lock = service.lock();
+                A->in.default_port().data() = -1;
+            }
+            service.queue_push(A->in.default_port());
+            service.wait();
+
+            THEN("the error and the faulty ports are published")
+            {
+                auto const snapshot = service.published_snapshot();
+                REQUIRE(snapshot->error(*A) == "Negative input");
+                REQUIRE(snapshot->error(*B).empty());
+                REQUIRE(snapshot->is_faulty(A->out));
+                REQUIRE(snapshot->is_faulty(B->in));
+                REQUIRE_FALSE(snapshot->is_faulty(A->in));
+            }
+        }
+    }
+}
+
+TEST_CASE("Evaluation services publish snapshots that can be read while the worker is busy",
+    "[base], [evaluation_services]")
+{
+    GIVEN("a graph with a node that blocks its update until it is released")
+    {
+        clk::graph graph;
+        auto* A = add_node<blocking_node>(graph);
+        auto* B = add_node<increment_node>(graph);
+        B->in.connect_to(A->out, false);
+        A->in.default_port().data() = 5;
+
+        clk::evaluation_service service(graph);
+        auto started = A->started.get_future();
+
+        WHEN("the node is pushed and its update started")
+        {
+            service.queue_push(*A);
+            started.wait();
+
+            THEN("the graph is locked and the previous values are published")
+            {
+                REQUIRE_FALSE(service.try_lock().owns_lock());
+                REQUIRE(service.is_busy());
+                REQUIRE(service.is_evaluating(*A));
+                REQUIRE_FALSE(service.is_evaluating(*B));
+                REQUIRE(published_value(service, A->out) == 0);
+                REQUIRE(published_value(service, A->in) == 5);
+            }
+
+            AND_WHEN("the same requests are queued several times")
+            {
+                service.queue_pull(*B);
+                service.queue_pull(*B);
+                service.queue_push(*A);
+
+                THEN("equal requests are merged")
+                {
+                    REQUIRE(service.queued_request_count() == 2);
+                }
+
+                AND_WHEN("the requests of a node are cancelled")
+                {
+                    service.cancel(*B);
+
+                    THEN("only the requests of the other nodes are left")
+                    {
+                        REQUIRE(service.queued_request_count() == 1);
+                    }
+                }
+            }
+
+            AND_WHEN("the update is released")
+            {
+                A->released.set_value();
+                service.wait();
+
+                THEN("the new values are published")
+                {
+                    REQUIRE(published_value(service, A->out) == 5);
+                    REQUIRE(published_value(service, B->out) == 6);
+                    REQUIRE(service.try_lock().owns_lock());
+                }
+            }
+
+            // the worker has to finish before the nodes are destroyed
+            if(!service.try_lock().owns_lock())
+            {
+                service.cancel(*A);
+                service.cancel(*B);
+                A->released.set_value();
+                service.wait();
+            }
+        }
+    }
+}
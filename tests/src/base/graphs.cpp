@@ -0,0 +1,834 @@
+#include "clk/base/algorithm.hpp"
+#include "clk/base/algorithm_node.hpp"
+#include "clk/base/constant_node.hpp"
+#include "clk/base/execution_plan.hpp"
+#include "clk/base/executor.hpp"
+#include "clk/base/graph.hpp"
+#include "clk/base/input.hpp"
+#include "clk/base/node.hpp"
+#include "clk/base/output.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+class increment_node final : public clk::node
+{
+public:
+    clk::input_of<int> in{"In"};
+    clk::output_of<int> out{"Out"};
+    int update_count = 0;
+
+    increment_node()
+    {
+        register_port(&in);
+        register_port(&out);
+    }
+
+    auto name() const -> std::string_view final
+    {
+        return "Increment";
+    }
+
+private:
+    void update() final
+    {
+        update_count++;
+        *out = *in + 1;
+    }
+};
+
+// thresholds its input, so most changes of the input leave the output as it is
+class threshold_node final : public clk::node
+{
+public:
+    clk::input_of<int> in{"In"};
+    clk::output_of<int> out{"Out"};
+    int update_count = 0;
+
+    threshold_node()
+    {
+        register_port(&in);
+        register_port(&out);
+        out.set_early_cutoff(true);
+    }
+
+    auto name() const -> std::string_view final
+    {
+        return "Threshold";
+    }
+
+private:
+    void update() final
+    {
+        update_count++;
+        *out = *in > 0 ? 1 : 0;
+    }
+};
+
+// shares its result, so the copies of the output's data can be counted
+class share_node final : public clk::node
+{
+public:
+    clk::input_of<int> in{"In"};
+    clk::output_of<std::shared_ptr<int>> out{"Out"};
+
+    share_node()
+    {
+        register_port(&in);
+        register_port(&out);
+        out.set_early_cutoff(true);
+    }
+
+    auto name() const -> std::string_view final
+    {
+        return "Share";
+    }
+
+private:
+    void update() final
+    {
+        if(*in < 0)
+            throw std::runtime_error("Negative input");
+        *out = std::make_shared<int>(*in);
+    }
+};
+
+class multiply_by_two final : public clk::algorithm_builder<multiply_by_two>
+{
+public:
+    static constexpr std::string_view name = "Multiply By Two";
+
+    clk::input_of<int> in{"In"};
+    clk::output_of<int> out{"Out"};
+
+    multiply_by_two()
+    {
+        register_port(in);
+        register_port(out);
+    }
+
+private:
+    void update() override
+    {
+        *out = *in * 2;
+    }
+};
+
+auto add_increment_node(clk::graph& graph) -> increment_node*
+{
+    auto node = std::make_unique<increment_node>();
+    auto* node_pointer = node.get();
+    graph.add_node(std::move(node));
+    return node_pointer;
+}
+} // namespace
+
+TEST_CASE("Execution plans order nodes topologically", "[base], [graphs]")
+{
+    GIVEN("a graph with a chain of nodes A -> B -> C, added to the graph in reverse order")
+    {
+        clk::graph graph;
+        auto* C = add_increment_node(graph);
+        auto* B = add_increment_node(graph);
+        auto* A = add_increment_node(graph);
+        B->in.connect_to(A->out, false);
+        C->in.connect_to(B->out, false);
+
+        WHEN("the graph is compiled")
+        {
+            auto const& plan = graph.compile();
+            THEN("the plan contains the nodes in dependency order")
+            {
+                REQUIRE(plan.nodes() == std::vector<clk::node*>{A, B, C});
+                REQUIRE(plan.dependencies(0).empty());
+                REQUIRE(plan.dependencies(1) == std::vector<std::size_t>{0});
+                REQUIRE(plan.dependents(1) == std::vector<std::size_t>{2});
+            }
+            AND_WHEN("the plan is run")
+            {
+                plan.run();
+                THEN("values propagate through the whole chain in a single pass")
+                {
+                    REQUIRE(*C->out == 3);
+                }
+            }
+        }
+    }
+
+    GIVEN("a graph with two nodes connected to each other in a cycle")
+    {
+        clk::graph graph;
+        auto* A = add_increment_node(graph);
+        auto* B = add_increment_node(graph);
+        A->in.connect_to(B->out, false);
+        B->in.connect_to(A->out, false);
+
+        THEN("compiling and running the graph terminates, with every node present in the plan once")
+        {
+            auto const& plan = graph.compile();
+            REQUIRE(plan.nodes().size() == 2);
+            REQUIRE_NOTHROW(plan.run());
+        }
+    }
+}
+
+TEST_CASE("Execution plans only update dirty nodes", "[base], [graphs]")
+{
+    GIVEN("a graph with a chain of nodes A -> B, and an unconnected node C")
+    {
+        clk::graph graph;
+        auto* A = add_increment_node(graph);
+        auto* B = add_increment_node(graph);
+        auto* C = add_increment_node(graph);
+        B->in.connect_to(A->out, false);
+
+        auto const& plan = graph.compile();
+        plan.run();
+        REQUIRE(A->update_count == 1);
+        REQUIRE(B->update_count == 1);
+        REQUIRE(C->update_count == 1);
+
+        WHEN("the plan is run again without any changes")
+        {
+            plan.run();
+            THEN("no node is updated")
+            {
+                REQUIRE(A->update_count == 1);
+                REQUIRE(B->update_count == 1);
+                REQUIRE(C->update_count == 1);
+            }
+        }
+
+        WHEN("A's input is modified and the plan is run again")
+        {
+            *A->in.default_port() = 10;
+            plan.run();
+            THEN("only A and B are updated, C is not even visited")
+            {
+                REQUIRE(A->update_count == 2);
+                REQUIRE(B->update_count == 2);
+                REQUIRE(C->update_count == 1);
+                REQUIRE(C->skipped_update_count() == 0);
+                REQUIRE(*B->out == 12);
+            }
+        }
+
+        WHEN("A's output is written from the outside and the plan is run again")
+        {
+            *A->out = 5;
+            plan.run();
+            THEN("only B is updated, with the written value")
+            {
+                REQUIRE(A->update_count == 1);
+                REQUIRE(B->update_count == 2);
+                REQUIRE(C->update_count == 1);
+                REQUIRE(C->skipped_update_count() == 0);
+                REQUIRE(*B->out == 6);
+            }
+        }
+
+        WHEN("A's input is read and the plan is run again")
+        {
+            REQUIRE(*A->in == 0);
+            plan.run();
+            THEN("no node is visited")
+            {
+                REQUIRE(A->skipped_update_count() == 0);
+                REQUIRE(B->skipped_update_count() == 0);
+                REQUIRE(C->skipped_update_count() == 0);
+            }
+        }
+    }
+
+    GIVEN("a constant node whose output is read by A, in a graph that was run once")
+    {
+        clk::graph graph;
+        auto constant = std::make_unique<clk::constant_node>();
+        auto value = std::make_unique<clk::output_of<int>>("Value");
+        auto* value_pointer = value.get();
+        constant->add_output(std::move(value));
+        graph.add_node(std::move(constant));
+        auto* A = add_increment_node(graph);
+        A->in.connect_to(*value_pointer, false);
+        graph.compile().run();
+        REQUIRE(A->update_count == 1);
+
+        WHEN("the constant is modified and the plan is run again")
+        {
+            **value_pointer = 5;
+            graph.compile().run();
+            THEN("A is updated with the new value")
+            {
+                REQUIRE(A->update_count == 2);
+                REQUIRE(*A->out == 6);
+            }
+        }
+    }
+}
+
+TEST_CASE("Outputs with early cutoff stop the propagation of updates that do not change them", "[base], [graphs]")
+{
+    GIVEN("a graph with a chain of nodes A -> T -> B, where T thresholds its input with early cutoff")
+    {
+        clk::graph graph;
+        auto* A = add_increment_node(graph);
+        auto node = std::make_unique<threshold_node>();
+        auto* T = node.get();
+        graph.add_node(std::move(node));
+        auto* B = add_increment_node(graph);
+        T->in.connect_to(A->out, false);
+        B->in.connect_to(T->out, false);
+        *A->in.default_port() = 1;
+
+        auto const& plan = graph.compile();
+        plan.run();
+        REQUIRE(*B->out == 2);
+
+        WHEN("A's input is modified without changing the result of T")
+        {
+            *A->in.default_port() = 5;
+            plan.run();
+            THEN("A and T are updated, but B is not")
+            {
+                REQUIRE(A->update_count == 2);
+                REQUIRE(T->update_count == 2);
+                REQUIRE(B->update_count == 1);
+            }
+
+            AND_WHEN("the plan is run again")
+            {
+                plan.run();
+                THEN("T is not updated again although its output is older than its input")
+                {
+                    REQUIRE(T->update_count == 2);
+                }
+            }
+        }
+
+        WHEN("A's input is modified and pushed without changing the result of T")
+        {
+            A->in.default_port().data() = 7;
+            A->in.default_port().push();
+            THEN("B skips its update")
+            {
+                REQUIRE(T->update_count == 2);
+                REQUIRE(B->update_count == 1);
+            }
+        }
+
+        WHEN("the result of T changes")
+        {
+            *A->in.default_port() = -5;
+            plan.run();
+            THEN("B is updated")
+            {
+                REQUIRE(B->update_count == 2);
+                REQUIRE(*B->out == 1);
+            }
+        }
+    }
+}
+
+TEST_CASE("Outputs with early cutoff only keep a copy of their data during updates", "[base], [graphs]")
+{
+    GIVEN("a node sharing its result through an output with early cutoff, in a graph that was run once")
+    {
+        clk::graph graph;
+        auto node = std::make_unique<share_node>();
+        auto* S = node.get();
+        graph.add_node(std::move(node));
+        *S->in.default_port() = 1;
+        graph.compile().run();
+        REQUIRE((*S->out).use_count() == 1);
+
+        WHEN("the update of the node throws")
+        {
+            *S->in.default_port() = -1;
+            graph.compile().run();
+            THEN("the output does not keep the copy taken before the update")
+            {
+                REQUIRE_FALSE(S->error().empty());
+                REQUIRE((*S->out).use_count() == 1);
+            }
+        }
+    }
+}
+
+TEST_CASE("Compiled execution plans are cached until the graph changes", "[base], [graphs]")
+{
+    GIVEN("a compiled graph with nodes A and B")
+    {
+        clk::graph graph;
+        auto* A = add_increment_node(graph);
+        auto* B = add_increment_node(graph);
+        auto const* plan = &graph.compile();
+        REQUIRE(plan->nodes() == std::vector<clk::node*>{A, B});
+
+        THEN("compiling the unchanged graph returns an up to date plan")
+        {
+            REQUIRE_FALSE(plan->is_outdated(graph));
+            REQUIRE(&graph.compile() == plan);
+        }
+
+        WHEN("B is connected to A's input")
+        {
+            A->in.connect_to(B->out, false);
+            THEN("the plan is outdated, and compiling again yields the new order")
+            {
+                REQUIRE(plan->is_outdated(graph));
+                REQUIRE(graph.compile().nodes() == std::vector<clk::node*>{B, A});
+            }
+        }
+    }
+}
+
+TEST_CASE("Graphs watch the ports that nodes register after they were added", "[base], [graphs]")
+{
+    GIVEN("a compiled graph with node A and a constant node without outputs")
+    {
+        clk::graph graph;
+        auto* A = add_increment_node(graph);
+        auto constant = std::make_unique<clk::constant_node>();
+        auto* constant_pointer = constant.get();
+        graph.add_node(std::move(constant));
+        auto const* plan = &graph.compile();
+
+        WHEN("an output is added to the constant node")
+        {
+            auto output = std::make_unique<clk::output_of<int>>("Value");
+            auto* output_pointer = output.get();
+            constant_pointer->add_output(std::move(output));
+            THEN("the plan is outdated")
+            {
+                REQUIRE(plan->is_outdated(graph));
+            }
+
+            AND_WHEN("the new output is connected to A's input after compiling again")
+            {
+                plan = &graph.compile();
+                A->in.connect_to(*output_pointer, false);
+                THEN("the graph is modified")
+                {
+                    REQUIRE(plan->is_outdated(graph));
+                }
+            }
+
+            AND_WHEN("the output is observed and removed again after compiling again")
+            {
+                graph.observe(*output_pointer);
+                plan = &graph.compile();
+                constant_pointer->remove_output(output_pointer);
+                THEN("the plan is outdated, and the graph forgot the output")
+                {
+                    REQUIRE(plan->is_outdated(graph));
+                    REQUIRE(graph.compile().nodes().size() == 2);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Executors run execution plans in parallel", "[base], [graphs]")
+{
+    GIVEN("a graph with many independent chains of nodes, all fed by the same root node")
+    {
+        clk::graph graph;
+        auto* root = add_increment_node(graph);
+        std::vector<std::vector<increment_node*>> chains(16);
+        for(auto& chain : chains)
+        {
+            for(int i = 0; i < 8; i++)
+            {
+                auto* node = add_increment_node(graph);
+                node->in.connect_to(chain.empty() ? root->out : chain.back()->out, false);
+                chain.push_back(node);
+            }
+        }
+
+        WHEN("the compiled plan is run by an executor with multiple threads")
+        {
+            clk::executor executor(4);
+            REQUIRE(executor.thread_count() == 4);
+            executor.run(graph.compile());
+            THEN("every node is updated exactly once, with the same results as a sequential run")
+            {
+                REQUIRE(root->update_count == 1);
+                for(auto const& chain : chains)
+                {
+                    for(std::size_t i = 0; i < chain.size(); i++)
+                    {
+                        REQUIRE(chain[i]->update_count == 1);
+                        REQUIRE(*chain[i]->out == static_cast<int>(i) + 2);
+                    }
+                }
+            }
+            AND_WHEN("the root's input is modified and the plan is run again")
+            {
+                *root->in.default_port() = 10;
+                executor.run(graph.compile());
+                THEN("the new value propagates through every chain")
+                {
+                    REQUIRE(root->update_count == 2);
+                    for(auto const& chain : chains)
+                    {
+                        REQUIRE(chain.back()->update_count == 2);
+                        REQUIRE(*chain.back()->out == 19);
+                    }
+                }
+            }
+        }
+
+        WHEN("the compiled plan is run by an executor with a single thread")
+        {
+            clk::executor executor(1);
+            executor.run(graph.compile());
+            THEN("the plan is run in order on the calling thread")
+            {
+                for(auto const& chain : chains)
+                    REQUIRE(*chain.back()->out == 9);
+            }
+        }
+    }
+
+    GIVEN("a graph with two nodes connected to each other in a cycle")
+    {
+        clk::graph graph;
+        auto* A = add_increment_node(graph);
+        auto* B = add_increment_node(graph);
+        A->in.connect_to(B->out, false);
+        B->in.connect_to(A->out, false);
+
+        THEN("running the plan on multiple threads terminates")
+        {
+            clk::executor executor(4);
+            REQUIRE_NOTHROW(executor.run(graph.compile()));
+        }
+    }
+}
+
+TEST_CASE("Pushing and pulling visits every node once per evaluation", "[base], [graphs]")
+{
+    GIVEN("a chain of nodes A -> B -> C, where C also feeds back into A")
+    {
+        clk::graph graph;
+        auto* A = add_increment_node(graph);
+        auto* B = add_increment_node(graph);
+        auto* C = add_increment_node(graph);
+        B->in.connect_to(A->out, false);
+        C->in.connect_to(B->out, false);
+
+        WHEN("A is pushed")
+        {
+            A->push();
+            THEN("every node is updated exactly once")
+            {
+                REQUIRE(A->update_count == 1);
+                REQUIRE(B->update_count == 1);
+                REQUIRE(C->update_count == 1);
+                REQUIRE(*C->out == 3);
+            }
+        }
+
+        WHEN("C is pulled")
+        {
+            C->pull();
+            THEN("every node is updated exactly once")
+            {
+                REQUIRE(A->update_count == 1);
+                REQUIRE(B->update_count == 1);
+                REQUIRE(C->update_count == 1);
+                REQUIRE(*C->out == 3);
+            }
+        }
+
+        AND_GIVEN("C's output connected back into A's input")
+        {
+            A->in.connect_to(C->out, false);
+
+            WHEN("A is pushed, twice")
+            {
+                A->push();
+                A->push();
+                THEN("the push terminates, and every node is updated once per push")
+                {
+                    REQUIRE(A->update_count == 2);
+                    REQUIRE(B->update_count == 2);
+                    REQUIRE(C->update_count == 2);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Demand driven graphs only evaluate the nodes that observed outputs depend on", "[base], [graphs]")
+{
+    GIVEN("a demand driven graph with nodes A -> B -> C and A -> D, where only C's output is observed")
+    {
+        clk::graph graph;
+        auto* A = add_increment_node(graph);
+        auto* B = add_increment_node(graph);
+        auto* C = add_increment_node(graph);
+        auto* D = add_increment_node(graph);
+        B->in.connect_to(A->out, false);
+        C->in.connect_to(B->out, false);
+        D->in.connect_to(A->out, false);
+        graph.set_demand_driven(true);
+        graph.observe(C->out);
+
+        THEN("C and its ancestors are demanded, D is not")
+        {
+            REQUIRE(graph.is_observed(C->out));
+            REQUIRE(A->is_demanded());
+            REQUIRE(B->is_demanded());
+            REQUIRE(C->is_demanded());
+            REQUIRE_FALSE(D->is_demanded());
+        }
+
+        WHEN("A is pushed")
+        {
+            A->push();
+            THEN("only the nodes C depends on are updated, D is marked as outdated")
+            {
+                REQUIRE(C->update_count == 1);
+                REQUIRE(*C->out == 3);
+                REQUIRE(D->update_count == 0);
+                REQUIRE(D->is_outdated());
+            }
+
+            AND_WHEN("D's output is observed and D is pulled")
+            {
+                graph.observe(D->out);
+                REQUIRE(D->is_demanded());
+                D->pull();
+                THEN("D is brought up to date without updating A again")
+                {
+                    REQUIRE(A->update_count == 1);
+                    REQUIRE(D->update_count == 1);
+                    REQUIRE(*D->out == 2);
+                    REQUIRE_FALSE(D->is_outdated());
+                }
+            }
+        }
+
+        WHEN("the plan is run")
+        {
+            graph.compile().run();
+            THEN("D is skipped")
+            {
+                REQUIRE(C->update_count == 1);
+                REQUIRE(D->update_count == 0);
+            }
+
+            AND_WHEN("D's output is observed and the plan is run again")
+            {
+                graph.observe(D->out);
+                graph.compile().run();
+                THEN("D is brought up to date")
+                {
+                    REQUIRE(D->update_count == 1);
+                    REQUIRE(*D->out == 2);
+                }
+            }
+        }
+
+        WHEN("C's output is observed twice and unobserved once")
+        {
+            graph.observe(C->out);
+            graph.unobserve(C->out);
+            THEN("it is still observed")
+            {
+                REQUIRE(graph.is_observed(C->out));
+                REQUIRE(A->is_demanded());
+            }
+            AND_WHEN("it is unobserved again")
+            {
+                graph.unobserve(C->out);
+                THEN("no node is demanded")
+                {
+                    REQUIRE_FALSE(graph.is_observed(C->out));
+                    REQUIRE_FALSE(A->is_demanded());
+                    REQUIRE_FALSE(C->is_demanded());
+                }
+            }
+        }
+
+        WHEN("D is connected to C's output")
+        {
+            D->in.connect_to(C->out, false);
+            THEN("the demand follows the new connection")
+            {
+                REQUIRE_FALSE(D->is_demanded());
+                graph.observe(D->out);
+                REQUIRE(D->is_demanded());
+            }
+        }
+
+        WHEN("the graph stops being demand driven")
+        {
+            graph.set_demand_driven(false);
+            A->push();
+            THEN("every node is demanded and updated again")
+            {
+                REQUIRE(D->is_demanded());
+                REQUIRE(D->update_count == 1);
+            }
+        }
+
+        WHEN("C is removed")
+        {
+            auto const* observed_output = &C->out;
+            graph.remove_node(C);
+            THEN("its output is not observed anymore")
+            {
+                REQUIRE_FALSE(graph.is_observed(*observed_output));
+                REQUIRE_FALSE(A->is_demanded());
+            }
+        }
+    }
+}
+
+TEST_CASE("Execution plans can evaluate whole columns of data in a single pass", "[base], [graphs]")
+{
+    GIVEN("a constant node with a column of values, feeding a chain of an increment node and an algorithm node")
+    {
+        constexpr std::size_t count = 1000;
+
+        clk::graph graph;
+        auto source_node = std::make_unique<clk::constant_node>();
+        auto source_output = std::make_unique<clk::output_of<int>>("Source");
+        auto* source = source_output.get();
+        source_node->add_output(std::move(source_output));
+        graph.add_node(std::move(source_node));
+
+        source->resize_column(count);
+        for(std::size_t i = 0; i < count; i++)
+            source->column()[i] = static_cast<int>(i);
+
+        auto* A = add_increment_node(graph);
+        auto algorithm = std::make_unique<multiply_by_two>();
+        auto* B = algorithm.get();
+        graph.add_node(std::make_unique<clk::algorithm_node>(std::move(algorithm)));
+        A->in.connect_to(*source, false);
+        B->in.connect_to(A->out, false);
+
+        WHEN("the plan is run in batch mode")
+        {
+            graph.compile().run_batch(count);
+            THEN("nodes without a batch implementation run once and broadcast their single value")
+            {
+                REQUIRE(A->out.column_size() == 0);
+                REQUIRE(B->in.column().is_broadcast());
+            }
+            THEN("algorithms fill a column with one element per input element")
+            {
+                REQUIRE(B->out.column_size() == count);
+            }
+        }
+
+        WHEN("the algorithm is connected to the column directly, and the plan is run in batch mode")
+        {
+            B->in.connect_to(*source, false);
+            graph.compile().run_batch(count);
+            THEN("every element of the column is processed")
+            {
+                REQUIRE(B->out.column_size() == count);
+                for(std::size_t i = 0; i < count; i++)
+                    REQUIRE(B->out.column()[i] == static_cast<int>(i) * 2);
+            }
+            AND_WHEN("the same batch is run by an executor with multiple threads")
+            {
+                clk::executor executor(4);
+                executor.run_batch(graph.compile(), count);
+                THEN("the results are the same")
+                {
+                    for(std::size_t i = 0; i < count; i++)
+                        REQUIRE(B->out.column()[i] == static_cast<int>(i) * 2);
+                }
+            }
+        }
+
+        WHEN("the batch is longer than the column")
+        {
+            B->in.connect_to(*source, false);
+            graph.compile().run_batch(count + 1);
+            THEN("the algorithm node reports an error")
+            {
+                REQUIRE_FALSE(graph.nodes().back()->error().empty());
+            }
+        }
+    }
+}
+
+TEST_CASE("Graphs can report how often and how long their nodes were updated", "[base], [graphs]")
+{
+    GIVEN("a profiled graph with a chain of nodes A -> B, and a node C added after profiling was activated")
+    {
+        clk::graph graph;
+        auto* A = add_increment_node(graph);
+        auto* B = add_increment_node(graph);
+        graph.set_profiling(true);
+        auto* C = add_increment_node(graph);
+        B->in.connect_to(A->out, false);
+
+        auto statistics_of = [&](clk::node const* node) {
+            for(auto const& entry : graph.statistics())
+                if(entry.node == node)
+                    return entry;
+            return clk::node_statistics{};
+        };
+
+        THEN("every node is profiled")
+        {
+            REQUIRE(A->is_profiling());
+            REQUIRE(C->is_profiling());
+            REQUIRE(C->profiler() != nullptr);
+        }
+
+        WHEN("the plan is run twice, with only A changing in between")
+        {
+            graph.compile().run();
+            A->in.default_port().data() = 5;
+            graph.compile().run();
+
+            THEN("the updates of A and B are counted, C is not visited by the second run")
+            {
+                REQUIRE(statistics_of(A).update_count == 2);
+                REQUIRE(statistics_of(B).update_count == 2);
+                REQUIRE(statistics_of(C).update_count == 1);
+                REQUIRE(statistics_of(C).skipped_update_count == 0);
+            }
+            AND_WHEN("B is pulled without any changes")
+            {
+                B->pull();
+                THEN("the skipped update of A is counted")
+                {
+                    REQUIRE(statistics_of(A).update_count == 2);
+                    REQUIRE(statistics_of(A).skipped_update_count == 1);
+                }
+            }
+            THEN("the statistics are sorted by the average duration of an update")
+            {
+                auto statistics = graph.statistics();
+                REQUIRE(statistics.size() == 3);
+                for(std::size_t i = 1; i < statistics.size(); i++)
+                    REQUIRE(statistics[i - 1].average_update >= statistics[i].average_update);
+            }
+        }
+
+        WHEN("profiling is deactivated")
+        {
+            graph.set_profiling(false);
+            THEN("the nodes keep their profilers, but stop recording")
+            {
+                REQUIRE_FALSE(A->is_profiling());
+                REQUIRE(A->profiler() != nullptr);
+                REQUIRE_FALSE(A->profiler()->is_active());
+            }
+        }
+    }
+}
@@ -0,0 +1,176 @@
+#include "clk/base/algorithm.hpp"
+#include "clk/base/algorithm_node.hpp"
+#include "clk/base/input.hpp"
+#include "clk/base/memo_cache.hpp"
+#include "clk/base/output.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+namespace
+{
+class square final : public clk::algorithm_builder<square>
+{
+public:
+    static constexpr std::string_view name = "Square";
+    static constexpr bool pure = true;
+
+    clk::input_of<int> in{"In"};
+    clk::output_of<int> out{"Out"};
+    int update_count = 0;
+
+    square()
+    {
+        register_port(in);
+        register_port(out);
+    }
+
+private:
+    void update() override
+    {
+        update_count++;
+        *out = *in * *in;
+    }
+};
+
+class half final : public clk::algorithm_builder<half>
+{
+public:
+    static constexpr std::string_view name = "Half";
+    static constexpr bool pure = true;
+
+    clk::input_of<float> in{"In"};
+    clk::output_of<float> out{"Out"};
+
+    half()
+    {
+        register_port(in);
+        register_port(out);
+    }
+
+private:
+    void update() override
+    {
+        *out = *in / 2.0f;
+    }
+};
+
+class counter final : public clk::algorithm_builder<counter>
+{
+public:
+    static constexpr std::string_view name = "Counter";
+
+    clk::input_of<int> in{"In"};
+    clk::output_of<int> out{"Out"};
+
+    counter()
+    {
+        register_port(in);
+        register_port(out);
+    }
+
+private:
+    void update() override
+    {
+        *out = *out + 1;
+    }
+};
+} // namespace
+
+TEST_CASE("Algorithm nodes reuse the results of pure algorithms for inputs they have seen before",
+    "[base], [memo_caches]")
+{
+    GIVEN("an algorithm node with a pure algorithm")
+    {
+        auto algorithm = std::make_unique<square>();
+        auto* S = algorithm.get();
+        clk::algorithm_node node(std::move(algorithm));
+        auto* memo_cache = node.memo_cache();
+        REQUIRE(memo_cache != nullptr);
+
+        auto evaluate = [&](int value) {
+            S->in.default_port().data() = value;
+            node.pull();
+            return *std::as_const(S->out);
+        };
+
+        WHEN("the input revisits values it had before")
+        {
+            memo_cache->reset_counters();
+            REQUIRE(evaluate(2) == 4);
+            REQUIRE(evaluate(3) == 9);
+            REQUIRE(evaluate(2) == 4);
+            REQUIRE(evaluate(0) == 0);
+
+            THEN("the algorithm is only updated for new values")
+            {
+                REQUIRE(S->update_count == 3);
+                REQUIRE(memo_cache->hit_count() == 2);
+                REQUIRE(memo_cache->miss_count() == 2);
+                REQUIRE(memo_cache->size() == 3);
+            }
+        }
+
+        WHEN("a single value is cached")
+        {
+            memo_cache->clear();
+            evaluate(2);
+
+            THEN("the memory usage includes the entry holding the values")
+            {
+                REQUIRE(memo_cache->size() == 1);
+                REQUIRE(memo_cache->memory_usage() > 2 * sizeof(int));
+            }
+        }
+
+        WHEN("the memory budget only fits a single entry")
+        {
+            evaluate(2);
+            memo_cache->set_memory_budget(memo_cache->memory_usage() / memo_cache->size());
+
+            THEN("the least recently used entries are dropped")
+            {
+                REQUIRE(memo_cache->size() == 1);
+                REQUIRE(evaluate(2) == 4);
+                REQUIRE(S->update_count == 2);
+                REQUIRE(evaluate(0) == 0);
+                REQUIRE(S->update_count == 3);
+            }
+        }
+    }
+
+    GIVEN("an algorithm node with a pure algorithm of floats")
+    {
+        auto algorithm = std::make_unique<half>();
+        auto* H = algorithm.get();
+        clk::algorithm_node node(std::move(algorithm));
+        auto* memo_cache = node.memo_cache();
+        memo_cache->clear();
+
+        WHEN("the input is NaN")
+        {
+            H->in.default_port().data() = std::numeric_limits<float>::quiet_NaN();
+            node.pull();
+
+            THEN("the result is not cached, it could never be found again")
+            {
+                REQUIRE(std::isnan(*std::as_const(H->out)));
+                REQUIRE(memo_cache->size() == 0);
+            }
+        }
+    }
+
+    GIVEN("an algorithm node with an algorithm that is not pure")
+    {
+        clk::algorithm_node node(std::make_unique<counter>());
+
+        THEN("it has no memo cache")
+        {
+            REQUIRE(node.memo_cache() == nullptr);
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#include "clk/base/graph.hpp"
+#include "clk/base/input.hpp"
+#include "clk/base/output.hpp"
+#include "clk/base/static_graph.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+namespace
+{
+struct add
+{
+    static constexpr std::string_view name = "Add";
+
+    auto operator()(int a, int b) const -> int
+    {
+        return a + b;
+    }
+};
+
+struct scale
+{
+    static constexpr std::string_view name = "Scale";
+    int factor = 2;
+
+    auto operator()(int const& value) const -> int
+    {
+        return value * factor;
+    }
+};
+
+struct to_float
+{
+    static constexpr std::string_view name = "To Float";
+
+    auto operator()(int value) const -> float
+    {
+        return static_cast<float>(value) / 2.0f;
+    }
+};
+
+// the sum is declared before the nodes it depends on
+using pipeline = clk::static_graph<clk::static_node<add, 3, 4>, // 0: 2 * a + (a + b)
+    clk::static_input<int>, // 1: a
+    clk::static_input<int>, // 2: b
+    clk::static_node<scale, 1>, // 3: 2 * a
+    clk::static_node<add, 1, 2>, // 4: a + b
+    clk::static_node<to_float, 0>>; // 5: the sum halved
+
+static_assert(pipeline::node_count == 6);
+static_assert(pipeline::is_input<1> && !pipeline::is_input<0>);
+static_assert(pipeline::evaluation_order[0] == 1 && pipeline::evaluation_order[1] == 2);
+static_assert(pipeline::evaluation_order[4] == 0 && pipeline::evaluation_order[5] == 5);
+} // namespace
+
+TEST_CASE("Static graphs evaluate pipelines that are wired at compile time", "[base], [static graphs]")
+{
+    GIVEN("a static pipeline with two inputs")
+    {
+        pipeline graph;
+        graph.set<1>(3);
+        graph.set<2>(4);
+
+        WHEN("it is evaluated")
+        {
+            graph.evaluate();
+            THEN("every node is evaluated after its sources")
+            {
+                REQUIRE(graph.get<3>() == 6);
+                REQUIRE(graph.get<4>() == 7);
+                REQUIRE(graph.get<0>() == 13);
+                REQUIRE(graph.get<5>() == 6.5f);
+            }
+        }
+
+        WHEN("an algorithm is changed and the pipeline is evaluated again")
+        {
+            graph.algorithm<3>().factor = 10;
+            graph.evaluate();
+            THEN("the results use the changed algorithm")
+            {
+                REQUIRE(graph.get<0>() == 37);
+            }
+        }
+    }
+}
+
+TEST_CASE("Static graph nodes expose static graphs to dynamic graphs", "[base], [static graphs]")
+{
+    GIVEN("a static graph node inside of a graph, with its inputs connected to constant outputs")
+    {
+        clk::graph graph;
+        auto node = std::make_unique<clk::static_graph_node<pipeline, 0, 5>>("Pipeline");
+        auto* pipeline_node = node.get();
+        graph.add_node(std::move(node));
+
+        clk::output_of<int> a("A");
+        clk::output_of<int> b("B");
+        *a = 1;
+        *b = 2;
+
+        THEN("it has an input for every static input and an output for every exported node")
+        {
+            REQUIRE(pipeline_node->name() == "Pipeline");
+            REQUIRE(pipeline_node->inputs().size() == 2);
+            REQUIRE(pipeline_node->outputs().size() == 2);
+            REQUIRE(pipeline_node->inputs()[0]->name() == "Input 1");
+            REQUIRE(pipeline_node->outputs()[1]->name() == "Output 2");
+        }
+
+        WHEN("the inputs are connected and the node is pulled")
+        {
+            pipeline_node->inputs()[0]->connect_to(a, false);
+            pipeline_node->inputs()[1]->connect_to(b, false);
+            pipeline_node->pull();
+            THEN("the outputs hold the results of the static graph")
+            {
+                auto const* sum = static_cast<clk::output_of<int> const*>(pipeline_node->outputs()[0]);
+                auto const* halved = static_cast<clk::output_of<float> const*>(pipeline_node->outputs()[1]);
+                REQUIRE(**sum == 5);
+                REQUIRE(**halved == 2.5f);
+                REQUIRE(pipeline_node->graph().get<3>() == 2);
+            }
+        }
+    }
+}
@@ -0,0 +1,181 @@
+#include "clk/base/graph.hpp"
+#include "clk/base/input.hpp"
+#include "clk/base/node.hpp"
+#include "clk/base/output.hpp"
+#include "clk/layout/layered_layout.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+class sum_node final : public clk::node
+{
+public:
+    clk::input_of<int> first{"First"};
+    clk::input_of<int> second{"Second"};
+    clk::output_of<int> out{"Out"};
+
+    sum_node()
+    {
+        register_port(&first);
+        register_port(&second);
+        register_port(&out);
+    }
+
+    // the other nodes of the graph might already be destroyed, so they must not be notified
+    ~sum_node() override
+    {
+        first.disconnect(false);
+        second.disconnect(false);
+    }
+
+    auto name() const -> std::string_view final
+    {
+        return "Sum";
+    }
+
+private:
+    void update() final
+    {
+        *out = *first + *second;
+    }
+};
+
+auto add_nodes(clk::graph& graph, std::size_t count) -> std::vector<sum_node*>
+{
+    std::vector<sum_node*> nodes;
+    for(std::size_t i = 0; i < count; i++)
+    {
+        auto node = std::make_unique<sum_node>();
+        nodes.push_back(node.get());
+        graph.add_node(std::move(node));
+    }
+    return nodes;
+}
+
+auto overlap(glm::vec2 position1, glm::vec2 position2, glm::vec2 size) -> bool
+{
+    return position1.x < position2.x + size.x && position2.x < position1.x + size.x &&
+           position1.y < position2.y + size.y && position2.y < position1.y + size.y;
+}
+
+} // namespace
+
+SCENARIO("Layered layouts place the nodes of a graph in layers along their connections", "[layout]")
+{
+    GIVEN("An empty graph")
+    {
+        clk::graph graph;
+        clk::layout::layered_layout const layout(graph, {});
+
+        THEN("There are no positions and no layers")
+        {
+            REQUIRE(layout.positions().empty());
+            REQUIRE(layout.layer_count() == 0);
+        }
+    }
+
+    GIVEN("A graph with a size for every node but one")
+    {
+        clk::graph graph;
+        add_nodes(graph, 2);
+
+        THEN("The layout can not be computed")
+        {
+            REQUIRE_THROWS_AS(clk::layout::layered_layout(graph, {glm::vec2{10.0f, 10.0f}}), std::runtime_error);
+        }
+    }
+
+    GIVEN("A chain of nodes")
+    {
+        clk::graph graph;
+        auto nodes = add_nodes(graph, 4);
+        for(std::size_t i = 1; i < nodes.size(); i++)
+            nodes[i]->first.connect_to(nodes[i - 1]->out, false);
+
+        glm::vec2 const size = {100.0f, 50.0f};
+        clk::layout::layered_layout const layout(graph, std::vector<glm::vec2>(nodes.size(), size));
+
+        THEN("Every node is in its own layer, following the connections from left to right")
+        {
+            REQUIRE(layout.layer_count() == 4);
+            for(std::size_t i = 0; i < nodes.size(); i++)
+                REQUIRE(layout.layers()[i] == i);
+            for(std::size_t i = 1; i < nodes.size(); i++)
+                REQUIRE(layout.positions()[i].x >= layout.positions()[i - 1].x + size.x);
+        }
+
+        THEN("The nodes are aligned")
+        {
+            for(std::size_t i = 1; i < nodes.size(); i++)
+                REQUIRE(layout.positions()[i].y == layout.positions()[0].y);
+        }
+    }
+
+    GIVEN("A source used by a node at the end of a long chain")
+    {
+        clk::graph graph;
+        auto nodes = add_nodes(graph, 5);
+        for(std::size_t i = 1; i < 4; i++)
+            nodes[i]->first.connect_to(nodes[i - 1]->out, false);
+        nodes[3]->second.connect_to(nodes[4]->out, false);
+
+        clk::layout::layered_layout const layout(graph, std::vector<glm::vec2>(nodes.size(), glm::vec2{10.0f, 10.0f}));
+
+        THEN("The source is placed right in front of the node using it")
+        {
+            REQUIRE(layout.layers()[4] == 2);
+        }
+    }
+
+    GIVEN("Two chains connected crosswise")
+    {
+        clk::graph graph;
+        auto nodes = add_nodes(graph, 6);
+        nodes[2]->first.connect_to(nodes[1]->out, false);
+        nodes[3]->first.connect_to(nodes[0]->out, false);
+        nodes[4]->first.connect_to(nodes[2]->out, false);
+        nodes[5]->first.connect_to(nodes[3]->out, false);
+        nodes[4]->second.connect_to(nodes[0]->out, false);
+
+        glm::vec2 const size = {80.0f, 40.0f};
+        clk::layout::layered_layout const layout(graph, std::vector<glm::vec2>(nodes.size(), size));
+
+        THEN("The nodes are reordered so the connections do not cross")
+        {
+            REQUIRE(layout.crossing_count() == 0);
+        }
+
+        THEN("No nodes overlap")
+        {
+            for(std::size_t i = 0; i < nodes.size(); i++)
+                for(std::size_t j = i + 1; j < nodes.size(); j++)
+                    REQUIRE(!overlap(layout.positions()[i], layout.positions()[j], size));
+        }
+    }
+
+    GIVEN("A cycle")
+    {
+        clk::graph graph;
+        auto nodes = add_nodes(graph, 3);
+        nodes[1]->first.connect_to(nodes[0]->out, false);
+        nodes[2]->first.connect_to(nodes[1]->out, false);
+        nodes[0]->first.connect_to(nodes[2]->out, false);
+
+        clk::layout::layered_layout const layout(graph, std::vector<glm::vec2>(nodes.size(), glm::vec2{10.0f, 10.0f}));
+
+        THEN("One connection is reversed and the nodes are still spread over layers")
+        {
+            REQUIRE(layout.layer_count() == 3);
+            REQUIRE(layout.layers()[0] != layout.layers()[1]);
+            REQUIRE(layout.layers()[1] != layout.layers()[2]);
+            REQUIRE(layout.layers()[0] != layout.layers()[2]);
+        }
+    }
+}
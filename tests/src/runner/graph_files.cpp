@@ -0,0 +1,115 @@
+#include "graph_file.hpp"
+
+#include "clk/algorithms/math.hpp"
+#include "clk/base/algorithm.hpp"
+#include "clk/base/constant_node.hpp"
+#include "clk/base/output.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+void register_algorithms()
+{
+    if(clk::algorithm::factories().count(clk::algorithms::add_floats::name) == 0)
+        clk::algorithm::register_factory<clk::algorithms::add_floats>();
+}
+
+// the message of the error loading the text throws, empty if it loads
+auto load_error(std::string const& text) -> std::string
+{
+    std::istringstream stream(text);
+    try
+    {
+        clk::runner::graph_file file(stream);
+    }
+    catch(std::runtime_error const& e)
+    {
+        return e.what();
+    }
+    return {};
+}
+} // namespace
+
+TEST_CASE("Graph files describe graphs line by line", "[runner]")
+{
+    register_algorithms();
+
+    GIVEN("a graph file adding a constant and a set value, with comments and quoted tokens")
+    {
+        std::istringstream stream(R"(# adds two numbers
+constant x float 2.5
+node sum "Add Floats"  # the sum
+connect x Value sum "Number A"
+set sum "Number B" 1.5
+
+print sum Result
+)");
+        clk::runner::graph_file file(stream);
+
+        THEN("every node is created under its id, and the printed output is observed")
+        {
+            REQUIRE(file.graph().nodes().size() == 2);
+            REQUIRE(file.node_ids().size() == 2);
+            REQUIRE(dynamic_cast<clk::constant_node*>(file.node_ids().at("x")) != nullptr);
+            REQUIRE(file.node_ids().at("sum")->name() == clk::algorithms::add_floats::name);
+            REQUIRE(file.printed_outputs().size() == 1);
+            REQUIRE(file.printed_outputs().front().first == "sum.Result");
+            REQUIRE(file.graph().is_observed(*file.printed_outputs().front().second));
+        }
+
+        WHEN("the graph is evaluated")
+        {
+            file.graph().compile().run();
+            THEN("the printed output holds the sum")
+            {
+                REQUIRE(clk::runner::to_string(*file.printed_outputs().front().second) == "4");
+            }
+        }
+    }
+}
+
+TEST_CASE("Graph files report the line of the first error", "[runner]")
+{
+    register_algorithms();
+
+    THEN("unknown algorithms are reported")
+    {
+        REQUIRE(load_error("node a \"Not An Algorithm\"") == "Line 1: Unknown algorithm \"Not An Algorithm\"");
+    }
+
+    THEN("ids can only be defined once")
+    {
+        REQUIRE(load_error("constant a int 1\nconstant a int 2") == "Line 2: Node \"a\" is already defined");
+        REQUIRE(load_error("constant a int 1\nnode a \"Add Floats\"") == "Line 2: Node \"a\" is already defined");
+    }
+
+    THEN("ports that the nodes do not have are reported")
+    {
+        std::string const nodes = "constant x float 1\nnode sum \"Add Floats\"\n";
+        REQUIRE(load_error(nodes + "set sum Number 2") == "Line 3: Node \"sum\" has no input \"Number\"");
+        REQUIRE(load_error(nodes + "connect x Result sum \"Number A\"") ==
+                "Line 3: Node \"x\" has no output \"Result\"");
+        REQUIRE(load_error(nodes + "connect x Value sum Number") == "Line 3: Node \"sum\" has no input \"Number\"");
+        REQUIRE(load_error(nodes + "print sum Value") == "Line 3: Node \"sum\" has no output \"Value\"");
+    }
+
+    THEN("unknown nodes, statements, types and invalid values are reported")
+    {
+        REQUIRE(load_error("print a Value") == "Line 1: Unknown node \"a\"");
+        REQUIRE(load_error("remove a") == "Line 1: Unknown statement \"remove\"");
+        REQUIRE(load_error("constant a double 1") == "Line 1: Unknown data type \"double\"");
+        REQUIRE(load_error("constant a int one") == "Line 1: Invalid value \"one\"");
+        REQUIRE(load_error("constant a int") == "Line 1: \"constant\" expects 3 arguments");
+        REQUIRE(load_error("node a \"Add Floats") == "Line 1: Unterminated quotes");
+    }
+
+    THEN("outputs can only be connected to inputs of the same type")
+    {
+        REQUIRE(load_error("constant x int 1\nnode sum \"Add Floats\"\nconnect x Value sum \"Number A\"") ==
+                "Line 3: Output \"Value\" cannot be connected to input \"Number A\"");
+    }
+}
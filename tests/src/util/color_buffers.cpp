@@ -0,0 +1,83 @@
+#include "clk/util/color_buffer.hpp"
+#include "clk/util/color_rgb.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+
+TEST_CASE("Color buffers store colors in aligned planes", "[util]")
+{
+    GIVEN("a color buffer of 100 colors, filled with a single color")
+    {
+        clk::color_buffer buffer(100, clk::color_rgb(0.1f, 0.2f, 0.3f));
+
+        THEN("every plane is aligned, and holds the corresponding component of every color")
+        {
+            REQUIRE(buffer.size() == 100);
+            for(std::size_t channel = 0; channel < 3; channel++)
+                REQUIRE(reinterpret_cast<std::uintptr_t>(buffer.plane(channel)) % clk::color_buffer::alignment == 0);
+            REQUIRE(buffer.at(0) == clk::color_rgb(0.1f, 0.2f, 0.3f));
+            REQUIRE(buffer.at(99) == clk::color_rgb(0.1f, 0.2f, 0.3f));
+            REQUIRE(buffer.green()[42] == 0.2f);
+        }
+
+        WHEN("a single color is changed")
+        {
+            buffer.set(42, clk::color_rgb(1.0f, 0.0f, 1.0f));
+            THEN("only that color is different")
+            {
+                REQUIRE(buffer.at(42) == clk::color_rgb(1.0f, 0.0f, 1.0f));
+                REQUIRE(buffer.at(41) == clk::color_rgb(0.1f, 0.2f, 0.3f));
+            }
+        }
+
+        WHEN("the buffer is copied")
+        {
+            clk::color_buffer copy = buffer;
+            THEN("the copy is equal, but does not share its planes with the original")
+            {
+                REQUIRE(copy == buffer);
+                REQUIRE(copy.red() != buffer.red());
+                copy.set(0, clk::color_rgb(0.0f));
+                REQUIRE(copy != buffer);
+            }
+        }
+
+        WHEN("the buffer is resized")
+        {
+            buffer.resize(3);
+            THEN("it holds the new number of colors")
+            {
+                REQUIRE(buffer.size() == 3);
+                REQUIRE(buffer != clk::color_buffer(100, clk::color_rgb(0.1f, 0.2f, 0.3f)));
+            }
+            THEN("it keeps the colors that still fit")
+            {
+                REQUIRE(buffer.at(2) == clk::color_rgb(0.1f, 0.2f, 0.3f));
+            }
+            AND_WHEN("it grows again within the same padded planes")
+            {
+                buffer.resize(15);
+                THEN("the added colors are black")
+                {
+                    REQUIRE(buffer.at(2) == clk::color_rgb(0.1f, 0.2f, 0.3f));
+                    REQUIRE(buffer.at(3) == clk::color_rgb(0.0f));
+                    REQUIRE(buffer.at(14) == clk::color_rgb(0.0f));
+                }
+            }
+        }
+
+        WHEN("the buffer grows past its padded planes")
+        {
+            buffer.set(99, clk::color_rgb(1.0f, 0.0f, 1.0f));
+            buffer.resize(113);
+            THEN("it keeps its colors, and the added colors are black")
+            {
+                REQUIRE(buffer.size() == 113);
+                REQUIRE(buffer.at(0) == clk::color_rgb(0.1f, 0.2f, 0.3f));
+                REQUIRE(buffer.at(99) == clk::color_rgb(1.0f, 0.0f, 1.0f));
+                REQUIRE(buffer.at(100) == clk::color_rgb(0.0f));
+                REQUIRE(buffer.at(112) == clk::color_rgb(0.0f));
+            }
+        }
+    }
+}
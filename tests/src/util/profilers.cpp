@@ -0,0 +1,86 @@
+#include "clk/util/profiler.hpp"
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Profilers keep statistics about the latest samples", "[util]")
+{
+    GIVEN("a profiler with a window of 100 samples")
+    {
+        clk::profiler profiler;
+        profiler.set_sample_count(100);
+
+        WHEN("fewer samples than the window size are recorded")
+        {
+            profiler.record_sample(30ns);
+            profiler.record_sample(10ns);
+            profiler.record_sample(20ns);
+            THEN("the statistics only take the recorded samples into account")
+            {
+                REQUIRE(profiler.average_sample() == 20ns);
+                REQUIRE(profiler.shortest_sample() == 10ns);
+                REQUIRE(profiler.longest_sample() == 30ns);
+                REQUIRE(profiler.percentile_sample(0.5) == 20ns);
+            }
+        }
+
+        WHEN("many random samples are recorded")
+        {
+            std::mt19937 generator(42);
+            std::lognormal_distribution<double> distribution(10.0, 2.0);
+            std::vector<std::chrono::nanoseconds> recorded;
+            for(std::size_t i = 0; i < 1'000; i++)
+            {
+                recorded.emplace_back(static_cast<std::chrono::nanoseconds::rep>(distribution(generator)));
+                profiler.record_sample(recorded.back());
+            }
+            std::vector<std::chrono::nanoseconds> window(recorded.end() - 100, recorded.end());
+
+            THEN("the statistics match the ones computed over the last 100 samples")
+            {
+                REQUIRE(profiler.average_sample() == std::accumulate(window.begin(), window.end(), 0ns) / 100);
+                REQUIRE(profiler.shortest_sample() == *std::min_element(window.begin(), window.end()));
+                REQUIRE(profiler.longest_sample() == *std::max_element(window.begin(), window.end()));
+            }
+            THEN("the percentiles are approximated within a few percent")
+            {
+                std::sort(window.begin(), window.end());
+                for(double fraction : {0.5, 0.95, 0.99})
+                {
+                    auto const expected = static_cast<double>(window[static_cast<std::size_t>(fraction * 100) - 1].count());
+                    auto const approximated = static_cast<double>(profiler.percentile_sample(fraction).count());
+                    REQUIRE(std::abs(approximated - expected) <= expected * 0.04);
+                }
+            }
+            AND_WHEN("the window is shrunk to 10 samples")
+            {
+                profiler.set_sample_count(10);
+                THEN("the statistics are computed over the latest 10 samples")
+                {
+                    REQUIRE(profiler.samples().second.size() == 10);
+                    REQUIRE(profiler.longest_sample() == *std::max_element(recorded.end() - 10, recorded.end()));
+                    REQUIRE(profiler.shortest_sample() == *std::min_element(recorded.end() - 10, recorded.end()));
+                }
+            }
+        }
+
+        WHEN("the profiler is not active")
+        {
+            profiler.set_active(false);
+            profiler.record_sample(10ns);
+            THEN("no samples are recorded")
+            {
+                REQUIRE(profiler.average_sample() == 0ns);
+                REQUIRE(profiler.longest_sample() == 0ns);
+            }
+        }
+    }
+}
@@ -0,0 +1,109 @@
+#include "clk/util/profiling_zones.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+namespace
+{
+void leaf()
+{
+    CLK_PROFILE_SCOPE("Leaf");
+}
+
+void branch()
+{
+    CLK_PROFILE_SCOPE("Branch");
+    leaf();
+    leaf();
+}
+} // namespace
+
+TEST_CASE("Profiling zones are aggregated into a call tree", "[util]")
+{
+    clk::profiling_zones::reset();
+
+    GIVEN("inactive profiling zones")
+    {
+        clk::profiling_zones::set_active(false);
+        WHEN("zones are entered")
+        {
+            branch();
+            THEN("nothing is recorded")
+            {
+                REQUIRE(clk::profiling_zones::call_tree().children.empty());
+            }
+        }
+    }
+
+    GIVEN("active profiling zones")
+    {
+        clk::profiling_zones::set_active(true);
+        WHEN("a zone calling another zone twice is entered three times")
+        {
+            for(int i = 0; i < 3; i++)
+                branch();
+            auto const tree = clk::profiling_zones::call_tree();
+
+            THEN("the outer zone is called three times, and the inner one six times from within it")
+            {
+                auto const* branch_node = tree.find_child("Branch");
+                REQUIRE(tree.children.size() == 1);
+                REQUIRE(branch_node != nullptr);
+                REQUIRE(branch_node->call_count == 3);
+                auto const* leaf_node = branch_node->find_child("Leaf");
+                REQUIRE(leaf_node != nullptr);
+                REQUIRE(leaf_node->call_count == 6);
+                REQUIRE(leaf_node->children.empty());
+            }
+            THEN("the time spent in the inner zone is part of the time spent in the outer one")
+            {
+                auto const* branch_node = tree.find_child("Branch");
+                REQUIRE(branch_node->total_time >= branch_node->find_child("Leaf")->total_time);
+                REQUIRE(branch_node->self_time() <= branch_node->total_time);
+            }
+            AND_WHEN("the zones are reset")
+            {
+                clk::profiling_zones::reset();
+                THEN("the call tree is empty")
+                {
+                    REQUIRE(clk::profiling_zones::call_tree().children.empty());
+                }
+            }
+        }
+
+        WHEN("the same zones are entered on several threads")
+        {
+            std::thread first(branch);
+            std::thread second(branch);
+            first.join();
+            second.join();
+            branch();
+
+            THEN("their calls are merged")
+            {
+                auto const tree = clk::profiling_zones::call_tree();
+                REQUIRE(tree.find_child("Branch")->call_count == 3);
+                REQUIRE(tree.find_child("Branch")->find_child("Leaf")->call_count == 6);
+            }
+        }
+
+        WHEN("more zones are completed than a thread can buffer before the call tree is queried again")
+        {
+            std::size_t const zone_count = 100'000;
+            for(std::size_t i = 0; i < zone_count; i++)
+                leaf();
+
+            THEN("every zone is either recorded or counted as dropped")
+            {
+                auto const tree = clk::profiling_zones::call_tree();
+                REQUIRE(clk::profiling_zones::dropped_zone_count() > 0);
+                REQUIRE(tree.find_child("Leaf")->call_count + clk::profiling_zones::dropped_zone_count() == zone_count);
+            }
+        }
+    }
+
+    clk::profiling_zones::set_active(false);
+    clk::profiling_zones::reset();
+}
@@ -0,0 +1,36 @@
+#include "clk/util/timestamp.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Timestamps are strictly ordered by their updates", "[util]")
+{
+    GIVEN("two reset timestamps A and B")
+    {
+        clk::timestamp A;
+        clk::timestamp B;
+        REQUIRE(A.is_reset());
+        REQUIRE(A == B);
+
+        WHEN("A is updated, immediately followed by B")
+        {
+            A.update();
+            B.update();
+            THEN("B is newer than A, even though no time has passed in between")
+            {
+                REQUIRE_FALSE(A.is_reset());
+                REQUIRE(B.is_newer_than(A));
+                REQUIRE(A.is_older_than(B));
+                REQUIRE(A != B);
+            }
+            AND_WHEN("A is reset")
+            {
+                A.reset();
+                THEN("A is older than B")
+                {
+                    REQUIRE(A.is_reset());
+                    REQUIRE(A < B);
+                }
+            }
+        }
+    }
+}
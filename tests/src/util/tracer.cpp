@@ -0,0 +1,144 @@
+#include "clk/util/tracer.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <iomanip>
+#include <ios>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace
+{
+auto count_occurrences(std::string const& text, std::string_view pattern) -> std::size_t
+{
+    std::size_t count = 0;
+    for(auto position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + 1))
+        count++;
+    return count;
+}
+
+auto chrome_trace() -> std::string
+{
+    std::ostringstream stream;
+    clk::tracer::write_chrome_trace(stream);
+    return stream.str();
+}
+} // namespace
+
+TEST_CASE("The tracer only records events while it is active", "[util]")
+{
+    clk::tracer::clear();
+
+    GIVEN("an inactive tracer")
+    {
+        clk::tracer::set_active(false);
+        WHEN("a scope is traced")
+        {
+            bool name_queried = false;
+            {
+                clk::tracer::scope const scope("test", [&]() -> std::string_view {
+                    name_queried = true;
+                    return "Outer";
+                });
+            }
+            THEN("nothing is recorded, and the name is not even queried")
+            {
+                REQUIRE(clk::tracer::event_count() == 0);
+                REQUIRE_FALSE(name_queried);
+            }
+        }
+    }
+
+    GIVEN("an active tracer")
+    {
+        clk::tracer::set_active(true);
+        WHEN("two nested scopes are traced")
+        {
+            {
+                clk::tracer::scope const outer("test", "Outer");
+                clk::tracer::scope const inner("test", "Inner \"quoted\"");
+            }
+            clk::tracer::set_active(false);
+            auto const trace = chrome_trace();
+
+            THEN("both scopes begin and end")
+            {
+                REQUIRE(clk::tracer::event_count() == 4);
+                REQUIRE(count_occurrences(trace, "\"ph\":\"B\"") == 2);
+                REQUIRE(count_occurrences(trace, "\"ph\":\"E\"") == 2);
+            }
+            THEN("the inner scope is nested in the outer one, and its name is escaped")
+            {
+                auto const outer_begin = trace.find("\"name\":\"Outer\"");
+                auto const inner_begin = trace.find("\"name\":\"Inner \\\"quoted\\\"\"");
+                REQUIRE(outer_begin != std::string::npos);
+                REQUIRE(inner_begin != std::string::npos);
+                REQUIRE(outer_begin < inner_begin);
+                REQUIRE(count_occurrences(trace, "\"depth\":1") == 2);
+            }
+            AND_WHEN("the tracer is cleared")
+            {
+                clk::tracer::clear();
+                THEN("the events are gone")
+                {
+                    REQUIRE(clk::tracer::event_count() == 0);
+                }
+            }
+        }
+
+        WHEN("scopes are traced on two different threads")
+        {
+            {
+                clk::tracer::scope const scope("test", "Main thread");
+            }
+            std::thread([]() {
+                clk::tracer::scope const scope("test", "Other thread");
+            }).join();
+            clk::tracer::set_active(false);
+            auto const trace = chrome_trace();
+
+            THEN("the events of every thread are written with a different thread id")
+            {
+                auto const main_event = trace.find("\"name\":\"Main thread\"");
+                auto const other_event = trace.find("\"name\":\"Other thread\"");
+                REQUIRE(main_event != std::string::npos);
+                REQUIRE(other_event != std::string::npos);
+                auto const thread_id_of = [&](std::size_t event) {
+                    auto const start = trace.find("\"tid\":", event);
+                    return trace.substr(start, trace.find(',', start) - start);
+                };
+                REQUIRE(thread_id_of(main_event) != thread_id_of(other_event));
+            }
+            AND_WHEN("the tracer is cleared")
+            {
+                clk::tracer::clear();
+                THEN("the buffer of the exited thread is released")
+                {
+                    REQUIRE(count_occurrences(chrome_trace(), "\"thread_name\"") == 1);
+                }
+            }
+        }
+
+        WHEN("a trace is written to a stream with its own formatting")
+        {
+            {
+                clk::tracer::scope const scope("test", "Control \x01 character");
+            }
+            clk::tracer::set_active(false);
+            std::ostringstream stream;
+            stream << std::setfill('*') << std::setprecision(2);
+            clk::tracer::write_chrome_trace(stream);
+
+            THEN("the formatting of the stream is restored")
+            {
+                REQUIRE(stream.fill() == '*');
+                REQUIRE(stream.precision() == 2);
+                REQUIRE((stream.flags() & std::ios_base::floatfield) == std::ios_base::fmtflags{});
+            }
+        }
+    }
+
+    clk::tracer::set_active(false);
+    clk::tracer::clear();
+}